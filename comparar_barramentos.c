@@ -0,0 +1,228 @@
+/* Firmware de comparação: I2C de hardware x I2C feito no PIO (lib/i2c_mestre.pio).
+ *
+ * Vazão: as leituras do GY-33 (1 byte escrito, 8 lidos) e do BH1750 (2 lidos)
+ * pelos dois controladores nos mesmos pinos do I2C0 (GPIO 0/1), a 100 e a
+ * 400 kHz. Para cada caso imprime o menor e o tempo médio da transação, os
+ * bytes por segundo nos fios (endereços incluídos) e quanto da CPU sobrou
+ * para o laço enquanto a transação corria (o PIO pede uma interrupção por
+ * byte; o bloco de hardware, uma a cada meia FIFO).
+ *
+ * Concorrência: com o BH1750 ligado ao GPIO 2/3 (SENSOR_LUZ_NO_PIO de main.c)
+ * e o GY-33 no I2C0, compara as duas leituras uma depois da outra com as duas
+ * enfileiradas antes de aguardar qualquer uma, como faz ler_sensores(). Se o
+ * BH1750 estiver no I2C0 junto do GY-33, mede o mesmo par no barramento
+ * compartilhado, onde a fila as serializa. */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "i2c_barramento.h"
+#include "gy33.h"
+#include "bh1750_light_sensor.h"
+
+// Os mesmos pinos de main.c
+#define I2C0_SDA_PIN 0
+#define I2C0_SCL_PIN 1
+#define PIO_I2C_BLOCO pio1
+#define PIO_I2C_SDA_PIN 2
+#define BH1750_ENDERECO 0x23
+#define REPETICOES 50
+
+typedef enum { LEITURA_COR, LEITURA_LUX } tipo_leitura_t;
+
+typedef struct {
+    uint32_t menor_us, soma_us;
+    uint32_t falhas;
+    float cpu_livre;             // Fração do laço de espera que sobrou durante as transações
+} medicao_t;
+
+static i2c_barramento_t barramento_hw;      // I2C0 nos GPIO 0/1
+static i2c_barramento_t barramento_pio_01;  // PIO nos mesmos GPIO 0/1
+static i2c_barramento_t barramento_pio_23;  // PIO nos GPIO 2/3
+static bool tem_pio_23;
+static float voltas_por_us;                 // Laço de espera sem nenhuma transação
+
+static gy33_leitura_t leitura_cor;
+static bh1750_leitura_t leitura_lux;
+
+// --- Medição ---
+
+// Aguarda contando as voltas do laço: a fração que falta foi gasta nas interrupções
+static void aguardar_contando(const i2c_transacao_t *t, uint32_t limite_us, uint32_t *voltas) {
+    uint32_t inicio = time_us_32();
+    while (t->status == I2C_TRANSACAO_PENDENTE && time_us_32() - inicio < limite_us) {
+        (*voltas)++;
+    }
+}
+
+// Voltas do mesmo laço por microssegundo com uma transação que nunca termina
+static void calibrar_espera(void) {
+    i2c_transacao_t parada = { .status = I2C_TRANSACAO_PENDENTE };
+    uint32_t voltas = 0;
+    aguardar_contando(&parada, 10000, &voltas);
+    voltas_por_us = voltas / 10000.0f;
+}
+
+// Uma leitura do sensor pelo driver, em duas etapas para contar a CPU livre no meio
+static bool ler(i2c_barramento_t *bar, tipo_leitura_t tipo, uint32_t *voltas) {
+    if (tipo == LEITURA_COR) {
+        gy33_iniciar_leitura_cor(bar, &leitura_cor);
+        aguardar_contando(&leitura_cor.transacao, UINT32_MAX, voltas);
+        uint16_t r, g, b, c;
+        return gy33_concluir_leitura_cor(&leitura_cor, &r, &g, &b, &c);
+    }
+    bh1750_begin_read_result(bar, &leitura_lux);
+    aguardar_contando(&leitura_lux.transacao, UINT32_MAX, voltas);
+    bh1750_end_read_result(&leitura_lux);
+    return leitura_lux.transacao.status == I2C_TRANSACAO_OK;
+}
+
+static medicao_t medir(i2c_barramento_t *bar, tipo_leitura_t tipo, uint32_t baudrate) {
+    medicao_t m = { .menor_us = UINT32_MAX };
+    uint64_t voltas_total = 0;
+    i2c_barramento_limitar_baudrate(bar, baudrate);
+    for (int i = 0; i < REPETICOES; i++) {
+        uint32_t voltas = 0;
+        uint32_t inicio = time_us_32();
+        bool ok = ler(bar, tipo, &voltas);
+        uint32_t duracao = time_us_32() - inicio;
+        if (!ok) {
+            m.falhas++;
+            continue;
+        }
+        if (duracao < m.menor_us) m.menor_us = duracao;
+        m.soma_us += duracao;
+        voltas_total += voltas;
+    }
+    uint32_t validas = REPETICOES - m.falhas;
+    if (validas > 0 && m.soma_us > 0) m.cpu_livre = voltas_total / (voltas_por_us * m.soma_us);
+    i2c_barramento_limitar_baudrate(bar, 0);
+    return m;
+}
+
+// Endereço, registrador e dados que passam nos fios em cada leitura
+static uint32_t bytes_por_leitura(tipo_leitura_t tipo) {
+    return tipo == LEITURA_COR ? 1 + 1 + 1 + 8 : 1 + 2;
+}
+
+static void imprimir(const char *nome, tipo_leitura_t tipo, uint32_t khz, medicao_t m) {
+    uint32_t validas = REPETICOES - m.falhas;
+    if (validas == 0) {
+        printf("%-22s %4lu kHz  sem resposta\n", nome, (unsigned long)khz);
+        return;
+    }
+    uint32_t media = m.soma_us / validas;
+    printf("%-22s %4lu kHz  %6lu us (media %6lu)  %6lu B/s  CPU livre %3.0f%%  %lu falhas\n",
+           nome, (unsigned long)khz, (unsigned long)m.menor_us, (unsigned long)media,
+           (unsigned long)(bytes_por_leitura(tipo) * 1000000ull / media), 100.0f * m.cpu_livre,
+           (unsigned long)m.falhas);
+}
+
+// Confere se há um dispositivo no endereço (leitura de 1 byte)
+static bool responde(i2c_barramento_t *bar, uint8_t endereco) {
+    uint8_t byte;
+    return i2c_barramento_transferir(bar, endereco, 100 * 1000, NULL, 0, &byte, 1) == I2C_TRANSACAO_OK;
+}
+
+// --- Vazão ---
+
+static void comparar_vazao(void) {
+    static const uint32_t velocidades_khz[] = { 100, 400 };
+    printf("--- Vazao: I2C0 x PIO nos GPIO %d/%d (menor de %d) ---\n", I2C0_SDA_PIN, I2C0_SCL_PIN, REPETICOES);
+    for (int tipo = LEITURA_COR; tipo <= LEITURA_LUX; tipo++) {
+        const char *sensor = tipo == LEITURA_COR ? "GY-33" : "BH1750";
+        for (int v = 0; v < 2; v++) {
+            uint32_t khz = velocidades_khz[v];
+            char nome[24];
+
+            // Os pinos passam de um controlador para o outro pela recuperação do barramento
+            i2c_barramento_recuperar(&barramento_hw);
+            snprintf(nome, sizeof(nome), "%s I2C0", sensor);
+            imprimir(nome, tipo, khz, medir(&barramento_hw, tipo, khz * 1000));
+
+            i2c_barramento_recuperar(&barramento_pio_01);
+            snprintf(nome, sizeof(nome), "%s PIO", sensor);
+            imprimir(nome, tipo, khz, medir(&barramento_pio_01, tipo, khz * 1000));
+        }
+    }
+    i2c_barramento_recuperar(&barramento_hw);
+}
+
+// --- Concorrência ---
+
+// GY-33 e BH1750 em sequência ou enfileirados juntos; menor tempo do par em us
+static uint32_t medir_par(i2c_barramento_t *bar_luz, bool juntos, uint32_t *falhas) {
+    uint32_t menor = UINT32_MAX;
+    uint16_t r, g, b, c;
+    for (int i = 0; i < REPETICOES; i++) {
+        uint32_t inicio = time_us_32();
+        bool ok;
+        if (juntos) {
+            bh1750_begin_read_result(bar_luz, &leitura_lux);
+            gy33_iniciar_leitura_cor(&barramento_hw, &leitura_cor);
+            bh1750_end_read_result(&leitura_lux);
+            ok = leitura_lux.transacao.status == I2C_TRANSACAO_OK;
+            ok = gy33_concluir_leitura_cor(&leitura_cor, &r, &g, &b, &c) && ok;
+        } else {
+            bh1750_begin_read_result(bar_luz, &leitura_lux);
+            bh1750_end_read_result(&leitura_lux);
+            ok = leitura_lux.transacao.status == I2C_TRANSACAO_OK;
+            ok = gy33_read_color(&barramento_hw, &r, &g, &b, &c) && ok;
+        }
+        uint32_t duracao = time_us_32() - inicio;
+        if (!ok) {
+            (*falhas)++;
+        } else if (duracao < menor) {
+            menor = duracao;
+        }
+    }
+    return menor;
+}
+
+static void comparar_concorrencia(void) {
+    i2c_barramento_t *bar_luz;
+    const char *onde;
+    if (tem_pio_23 && responde(&barramento_pio_23, BH1750_ENDERECO)) {
+        bar_luz = &barramento_pio_23;
+        onde = "BH1750 no PIO (GPIO 2/3), GY-33 no I2C0";
+    } else if (responde(&barramento_hw, BH1750_ENDERECO)) {
+        bar_luz = &barramento_hw;
+        onde = "BH1750 e GY-33 no I2C0 compartilhado";
+    } else {
+        printf("--- Concorrencia: BH1750 nao respondeu no I2C0 nem no GPIO 2/3 ---\n");
+        return;
+    }
+
+    uint32_t falhas = 0;
+    uint32_t sequencial = medir_par(bar_luz, false, &falhas);
+    uint32_t juntos = medir_par(bar_luz, true, &falhas);
+    printf("--- Concorrencia: %s (menor de %d, 400 kHz) ---\n", onde, REPETICOES);
+    printf("Um depois do outro  %6lu us\n", (unsigned long)sequencial);
+    printf("Enfileirados juntos %6lu us  (%.2fx)  %lu falhas\n", (unsigned long)juntos,
+           juntos ? (float)sequencial / juntos : 0.0f, (unsigned long)falhas);
+}
+
+int main() {
+    stdio_init_all();
+    sleep_ms(2000);
+    calibrar_espera();
+
+    i2c_barramento_init(&barramento_hw, i2c0, I2C0_SDA_PIN, I2C0_SCL_PIN, 100 * 1000);
+    if (!i2c_barramento_init_pio(&barramento_pio_01, PIO_I2C_BLOCO, I2C0_SDA_PIN, 100 * 1000)) {
+        printf("PIO sem SM livre ou sem espaco para o programa\n");
+        return 1;
+    }
+    tem_pio_23 = i2c_barramento_init_pio(&barramento_pio_23, PIO_I2C_BLOCO, PIO_I2C_SDA_PIN, 100 * 1000);
+
+    // Sensores ligados e com uma integração completa antes das leituras
+    i2c_barramento_recuperar(&barramento_hw);
+    gy33_init(&barramento_hw);
+    bh1750_start_measurement(&barramento_hw);
+    if (tem_pio_23) bh1750_start_measurement(&barramento_pio_23);
+    sleep_ms(700 + BH1750_TEMPO_MEDICAO_MS);
+
+    for (;;) {
+        comparar_vazao();
+        comparar_concorrencia();
+        sleep_ms(5000);
+    }
+}
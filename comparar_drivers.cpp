@@ -0,0 +1,186 @@
+/* Firmware de comparação: drivers em C (lib/) x modelos C++17 (lib/Drivers_Cpp).
+ *
+ * Roda as mesmas operações pelos dois caminhos, confere que os resultados
+ * (quadro do display, quadro da matriz, leituras) são iguais e imprime na
+ * serial o menor número de ciclos de cada operação (SysTick no clk_sys).
+ * As operações que passam pelo I2C são dominadas pelo barramento; as de
+ * desenho mostram só o custo de CPU.
+ *
+ * O tamanho de código sai do ELF:
+ *   arm-none-eabi-nm -C -S --size-sort build/comparar_drivers.elf | grep -E "ssd1306_|gy33_|bh1750_|carga_"
+ * Cada carga_*_c chama as funções do driver em C (listadas à parte); nas
+ * carga_*_cpp os modelos ficam embutidos, então o tamanho delas já é o total. */
+
+#include <cstdio>
+#include <cstring>
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+#include "i2c_barramento.h"
+#include "ssd1306.h"
+#include "gy33.h"
+#include "bh1750_light_sensor.h"
+#include "matriz_led.h"
+#include "ssd1306.hpp"
+#include "gy33.hpp"
+#include "bh1750.hpp"
+#include "matriz_ws2812.hpp"
+
+// Os mesmos pinos e endereços de main.c
+#define I2C0_SDA_PIN 0
+#define I2C0_SCL_PIN 1
+#define I2C1_SDA_PIN 14
+#define I2C1_SCL_PIN 15
+#define SSD1306_I2C_ADDR 0x3C
+#define REPETICOES 20
+
+i2c_barramento_t barramento_sensores;
+i2c_barramento_t barramento_display;
+
+using Display = drivers::Ssd1306<drivers::DispositivoI2C<barramento_display, SSD1306_I2C_ADDR, 400000>, 128, 64>;
+using SensorCor = drivers::Gy33<drivers::DispositivoI2C<barramento_sensores, GY33_I2C_ADDR, GY33_I2C_BAUDRATE>>;
+using SensorLuz = drivers::Bh1750<drivers::DispositivoI2C<barramento_sensores, drivers::BH1750_ENDERECO,
+                                                          drivers::BH1750_BAUDRATE>>;
+using Matriz = drivers::MatrizWs2812<0, MATRIZ_SM, PINO_WS2812, NUM_LINHAS, NUM_COLUNAS,
+                                     MATRIZ_DE_CABECA_PARA_BAIXO, MATRIZ_SERPENTINA>;
+
+static ssd1306_t display_c;
+static Display display_cpp;
+static uint32_t quadro_c[NUM_PIXELS];
+static Matriz matriz_cpp;
+
+// --- Medição ---
+
+static void systick_init() {
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // Liga, clock do processador, sem interrupção
+}
+
+// Ciclos de uma chamada (contador decrescente de 24 bits: até ~134 ms a 125 MHz)
+template <typename F>
+static uint32_t ciclos(F &&f) {
+    uint32_t inicio = systick_hw->cvr;
+    f();
+    uint32_t fim = systick_hw->cvr;
+    return (inicio - fim) & 0x00FFFFFF;
+}
+
+template <typename F>
+static uint32_t menor_de(F &&f) {
+    uint32_t menor = UINT32_MAX;
+    for (int i = 0; i < REPETICOES; ++i) {
+        uint32_t c = ciclos(f);
+        if (c < menor) menor = c;
+    }
+    return menor;
+}
+
+// `conferencia`: resultado da comparação das saídas (as leituras dos sensores mudam entre integrações)
+static void imprimir(const char *operacao, uint32_t c, uint32_t cpp, const char *conferencia) {
+    printf("%-24s C %8lu  C++ %8lu  (%3lu%%)  %s\n", operacao, (unsigned long)c, (unsigned long)cpp,
+           (unsigned long)(c ? cpp * 100u / c : 0), conferencia);
+}
+
+static const char *conferir(bool iguais) {
+    return iguais ? "iguais" : "DIFERENTES";
+}
+
+// --- Cargas (separadas para o tamanho de cada uma aparecer no nm) ---
+
+__attribute__((noinline)) void carga_tela_c() {
+    ssd1306_fill(&display_c, false);
+    ssd1306_draw_string(&display_c, "--- Luminosidade ---", 0, 5, false);
+    ssd1306_draw_string(&display_c, "Lux: 1234", 10, 25, false);
+    ssd1306_draw_string(&display_c, "Status: OK", 10, 45, false);
+}
+
+__attribute__((noinline)) void carga_tela_cpp() {
+    display_cpp.preencher(false);
+    display_cpp.desenhar_texto("--- Luminosidade ---", 0, 5);
+    display_cpp.desenhar_texto("Lux: 1234", 10, 25);
+    display_cpp.desenhar_texto("Status: OK", 10, 45);
+}
+
+__attribute__((noinline)) void carga_pixels_c() {
+    for (uint32_t i = 0, x = 1; i < 1000; ++i, x = x * 1103515245u + 12345u) {
+        ssd1306_pixel(&display_c, (x >> 16) & 0x7F, (x >> 24) & 0x3F, i & 1);
+    }
+}
+
+__attribute__((noinline)) void carga_pixels_cpp() {
+    for (uint32_t i = 0, x = 1; i < 1000; ++i, x = x * 1103515245u + 12345u) {
+        display_cpp.pixel((x >> 16) & 0x7F, (x >> 24) & 0x3F, i & 1);
+    }
+}
+
+__attribute__((noinline)) void carga_glifos_c() {
+    for (int d = 0; d < 10; ++d) matriz_pintar_glifo(quadro_c, padrao_numeros[d], COR_VERDE + d);
+}
+
+__attribute__((noinline)) void carga_glifos_cpp() {
+    for (int d = 0; d < 10; ++d) matriz_cpp.pintar_glifo(padrao_numeros[d], COR_VERDE + d);
+}
+
+__attribute__((noinline)) void carga_envio_c() { ssd1306_send_data(&display_c); }
+__attribute__((noinline)) void carga_envio_cpp() { display_cpp.enviar(); }
+
+static uint16_t cor_c[4], cor_cpp[4], lux_c, lux_cpp;
+__attribute__((noinline)) void carga_cor_c() { gy33_read_color(&barramento_sensores, &cor_c[0], &cor_c[1], &cor_c[2], &cor_c[3]); }
+__attribute__((noinline)) void carga_cor_cpp() { SensorCor::ler(cor_cpp[0], cor_cpp[1], cor_cpp[2], cor_cpp[3]); }
+__attribute__((noinline)) void carga_lux_c() { lux_c = bh1750_read_result(&barramento_sensores); }
+__attribute__((noinline)) void carga_lux_cpp() { lux_cpp = SensorLuz::ler_resultado(); }
+
+static bool quadros_iguais() {
+    return memcmp(display_c.ram_buffer + 1, display_cpp.quadro(), Display::tamanho_quadro) == 0;
+}
+
+// O modelo guarda as palavras já deslocadas para a FIFO (GRB << 8)
+static bool matrizes_iguais() {
+    for (int i = 0; i < NUM_PIXELS; ++i) {
+        if (quadro_c[i] << 8u != matriz_cpp.quadro()[i]) return false;
+    }
+    return true;
+}
+
+// --- Programa ---
+
+int main() {
+    stdio_init_all();
+    sleep_ms(2000);
+    systick_init();
+    i2c_barramento_init(&barramento_sensores, i2c0, I2C0_SDA_PIN, I2C0_SCL_PIN, 100 * 1000);
+    i2c_barramento_init(&barramento_display, i2c1, I2C1_SDA_PIN, I2C1_SCL_PIN, 400 * 1000);
+
+    ssd1306_init(&display_c, 128, 64, false, SSD1306_I2C_ADDR, &barramento_display);
+    ssd1306_config(&display_c);
+    display_cpp.init();
+    gy33_init(&barramento_sensores);
+    SensorCor::init();
+    bh1750_power_on(&barramento_sensores);
+    SensorLuz::iniciar_medicao();
+    Matriz::init();
+    sleep_ms(SensorCor::tempo_integracao_us / 1000 + SensorLuz::tempo_medicao_ms);
+
+    for (;;) {
+        printf("--- Drivers em C x modelos C++17 (ciclos, menor de %d) ---\n", REPETICOES);
+        uint32_t c = menor_de(carga_tela_c), cpp = menor_de(carga_tela_cpp);
+        imprimir("Tela de luminosidade", c, cpp, conferir(quadros_iguais()));
+        c = menor_de(carga_pixels_c);
+        cpp = menor_de(carga_pixels_cpp);
+        imprimir("1000 pixels", c, cpp, conferir(quadros_iguais()));
+        c = menor_de(carga_glifos_c);
+        cpp = menor_de(carga_glifos_cpp);
+        imprimir("10 glifos na matriz", c, cpp, conferir(matrizes_iguais()));
+        c = menor_de(carga_envio_c);
+        cpp = menor_de(carga_envio_cpp);
+        imprimir("Quadro inteiro no I2C", c, cpp, "-");
+        c = menor_de(carga_cor_c);
+        cpp = menor_de(carga_cor_cpp);
+        imprimir("Leitura GY-33", c, cpp, memcmp(cor_c, cor_cpp, sizeof(cor_c)) == 0 ? "iguais" : "nova integracao");
+        c = menor_de(carga_lux_c);
+        cpp = menor_de(carga_lux_cpp);
+        imprimir("Leitura BH1750", c, cpp, lux_c == lux_cpp ? "iguais" : "nova integracao");
+        matriz_cpp.enviar();
+        sleep_ms(5000);
+    }
+}
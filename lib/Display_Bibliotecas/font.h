@@ -1,3 +1,5 @@
+// Fonte original (glifos 8x8). Não é incluída pelo firmware: tools/gerar_fonte.py
+// converte estes dados em fonte_atlas.h, que é o que o ssd1306.c usa.
 static uint8_t font[] = {
 
 
@@ -0,0 +1,173 @@
+// -------------------------------------------------------------- //
+// Gerado por tools/gerar_fonte.py a partir de font.h; não edite! //
+// -------------------------------------------------------------- //
+
+#pragma once
+
+#include <stdint.h>
+
+#define FONTE_ALTURA 8
+#define FONTE_ESPACAMENTO 1   // Coluna vazia entre glifos
+#define FONTE_NUM_GLIFOS 99
+#define FONTE_PEQUENA_LARGURA 5
+
+// Colunas de todos os glifos em sequência (bit 0 = linha de cima)
+static const uint8_t fonte_colunas[] = {
+    0x7E, 0x42, 0x42, 0x7E, // ausente
+    0x00, 0x00, 0x00, // espaço
+    0x5E, 0x5E, // !
+    0x03, 0x00, 0x03, // "
+    0x12, 0x3F, 0x12, 0x3F, 0x12, // #
+    0xE6, 0x10, 0xCE, // %
+    0x03, // '
+    0x1C, 0x22, 0x41, // (
+    0x41, 0x22, 0x1C, // )
+    0x2A, 0x1C, 0x2A, // *
+    0x08, 0x1C, 0x08, // +
+    0x80, 0x60, // ,
+    0x08, 0x08, 0x08, 0x08, // -
+    0x80, // .
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, // /
+    0x3E, 0x41, 0x41, 0x49, 0x41, 0x41, 0x3E, // 0
+    0x42, 0x7F, 0x40, // 1
+    0x30, 0x49, 0x49, 0x49, 0x49, 0x46, // 2
+    0x49, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, // 3
+    0x3F, 0x20, 0x20, 0x78, 0x20, 0x20, // 4
+    0x4F, 0x49, 0x49, 0x49, 0x49, 0x30, // 5
+    0x3F, 0x48, 0x48, 0x48, 0x48, 0x48, 0x30, // 6
+    0x01, 0x01, 0x01, 0x61, 0x31, 0x0D, 0x03, // 7
+    0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, // 8
+    0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7F, // 9
+    0x18, 0x18, // :
+    0x80, 0x64, // ;
+    0x08, 0x14, 0x22, // <
+    0x14, 0x14, 0x14, // =
+    0x44, 0x28, 0x10, 0x44, 0x28, 0x10, // >
+    0x02, 0x51, 0x09, 0x06, // ?
+    0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, // A
+    0x7F, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7F, // B
+    0x7E, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, // C
+    0x7F, 0x41, 0x41, 0x41, 0x41, 0x41, 0x7E, // D
+    0x7F, 0x49, 0x49, 0x49, 0x49, 0x49, 0x49, // E
+    0x7F, 0x09, 0x09, 0x09, 0x09, 0x01, 0x01, // F
+    0x7F, 0x41, 0x41, 0x41, 0x51, 0x51, 0x73, // G
+    0x7F, 0x08, 0x08, 0x08, 0x08, 0x08, 0x7F, // H
+    0x7F, // I
+    0x21, 0x41, 0x41, 0x3F, 0x01, 0x01, 0x01, // J
+    0x7F, 0x08, 0x08, 0x14, 0x22, 0x41, // K
+    0x7F, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, // L
+    0x7F, 0x02, 0x04, 0x08, 0x04, 0x02, 0x7F, // M
+    0x7F, 0x02, 0x04, 0x08, 0x10, 0x20, 0x7F, // N
+    0x3E, 0x41, 0x41, 0x41, 0x41, 0x41, 0x3E, // O
+    0x7F, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, // P
+    0x3E, 0x41, 0x41, 0x49, 0x51, 0x61, 0x7E, // Q
+    0x7F, 0x11, 0x11, 0x11, 0x31, 0x51, 0x0E, // R
+    0x46, 0x49, 0x49, 0x49, 0x49, 0x30, // S
+    0x01, 0x01, 0x01, 0x7F, 0x01, 0x01, 0x01, // T
+    0x3F, 0x40, 0x40, 0x40, 0x40, 0x40, 0x3F, // U
+    0x0F, 0x10, 0x20, 0x40, 0x20, 0x10, 0x0F, // V
+    0x7F, 0x20, 0x10, 0x08, 0x10, 0x20, 0x7F, // W
+    0x41, 0x22, 0x14, 0x14, 0x22, 0x41, // X
+    0x01, 0x02, 0x04, 0x78, 0x04, 0x02, 0x01, // Y
+    0x41, 0x61, 0x59, 0x45, 0x43, 0x41, // Z
+    0x40, 0x40, 0x40, 0x40, // _
+    0x20, 0x54, 0x54, 0x54, 0x34, 0x78, // a
+    0x7E, 0x50, 0x48, 0x48, 0x48, 0x30, // b
+    0x38, 0x44, 0x44, 0x44, 0x44, 0x28, // c
+    0x30, 0x48, 0x48, 0x48, 0x50, 0x7E, // d
+    0x38, 0x54, 0x54, 0x54, 0x54, 0x18, // e
+    0x08, 0x7C, 0x0A, 0x0A, // f
+    0x48, 0x94, 0x94, 0x94, 0xB4, 0x78, // g
+    0x7E, 0x10, 0x08, 0x08, 0x08, 0x70, // h
+    0x74, // i
+    0x60, 0x40, 0x74, // j
+    0x7E, 0x08, 0x1C, 0x32, 0x42, // k
+    0x7E, // l
+    0x78, 0x04, 0x78, 0x04, 0x78, // m
+    0x04, 0x78, 0x04, 0x78, // n
+    0x38, 0x44, 0x44, 0x44, 0x38, // o
+    0xFC, 0x24, 0x24, 0x24, 0x18, // p
+    0x18, 0x24, 0x24, 0x24, 0xFC, // q
+    0x78, 0x10, 0x08, 0x08, 0x08, // r
+    0x48, 0x54, 0x54, 0x24, // s
+    0x04, 0x7E, 0x44, // t
+    0x3C, 0x40, 0x40, 0x40, 0x20, 0x7C, // u
+    0x1C, 0x20, 0x40, 0x40, 0x20, 0x1C, // v
+    0x7C, 0x40, 0x30, 0x30, 0x40, 0x7C, // w
+    0x44, 0x28, 0x10, 0x10, 0x28, 0x44, // x
+    0x0C, 0x10, 0x60, 0x60, 0x10, 0x0C, // y
+    0x44, 0x64, 0x54, 0x4C, 0x44, // z
+    0x1C, 0x3E, 0x62, 0x02, 0x02, 0x62, 0x3E, 0x1C, // ohm
+    0x02, 0x05, 0x02, // °
+    0xFC, 0x20, 0x20, 0x1C, // µ
+    0x20, 0x54, 0x55, 0x56, 0x34, 0x78, // à
+    0x20, 0x54, 0x54, 0x56, 0x35, 0x78, // á
+    0x20, 0x54, 0x56, 0x55, 0x36, 0x78, // â
+    0x20, 0x54, 0x56, 0x55, 0x36, 0x79, // ã
+    0x38, 0x44, 0xC4, 0x44, 0x44, 0x28, // ç
+    0x38, 0x54, 0x54, 0x56, 0x55, 0x18, // é
+    0x38, 0x54, 0x56, 0x55, 0x56, 0x18, // ê
+    0x72, 0x01, // í
+    0x38, 0x44, 0x46, 0x45, 0x38, // ó
+    0x38, 0x46, 0x45, 0x46, 0x38, // ô
+    0x38, 0x46, 0x45, 0x46, 0x39, // õ
+    0x3C, 0x40, 0x40, 0x42, 0x21, 0x7C, // ú
+};
+
+// Início de cada glifo em fonte_colunas
+static const uint16_t fonte_offset[FONTE_NUM_GLIFOS] = {
+       0,    4,    7,    9,   12,   17,   20,   21,   24,   27,   30,   33,
+      35,   39,   40,   47,   54,   57,   63,   70,   76,   82,   89,   96,
+     103,  110,  112,  114,  117,  120,  126,  130,  137,  144,  151,  158,
+     165,  172,  179,  186,  187,  194,  200,  207,  214,  221,  228,  235,
+     242,  249,  255,  262,  269,  276,  283,  289,  296,  302,  306,  312,
+     318,  324,  330,  336,  340,  346,  352,  353,  356,  361,  362,  367,
+     371,  376,  381,  386,  391,  395,  398,  404,  410,  416,  422,  428,
+     433,  441,  444,  448,  454,  460,  466,  472,  478,  484,  490,  492,
+     497,  502,  507,
+};
+
+// Largura de cada glifo em colunas
+static const uint8_t fonte_largura[FONTE_NUM_GLIFOS] = {
+     4,  3,  2,  3,  5,  3,  1,  3,  3,  3,  3,  2,  4,  1,  7,  7,
+     3,  6,  7,  6,  6,  7,  7,  7,  7,  2,  2,  3,  3,  6,  4,  7,
+     7,  7,  7,  7,  7,  7,  7,  1,  7,  6,  7,  7,  7,  7,  7,  7,
+     7,  6,  7,  7,  7,  7,  6,  7,  6,  4,  6,  6,  6,  6,  6,  4,
+     6,  6,  1,  3,  5,  1,  5,  4,  5,  5,  5,  5,  4,  3,  6,  6,
+     6,  6,  6,  5,  8,  3,  4,  6,  6,  6,  6,  6,  6,  6,  2,  5,
+     5,  5,  6,
+};
+
+// Código Latin-1 -> glifo (0 = caractere sem desenho)
+static const uint8_t fonte_indice[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      1,   2,   3,   4,   0,   5,   0,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+     15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,  30,
+      0,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,
+     46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,   0,   0,   0,   0,  57,
+      0,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,  72,
+     73,  74,  75,  76,  77,  78,  79,  80,  81,  82,  83,   0,   0,   0,   0,  84,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+     85,   0,   0,   0,   0,  86,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+     87,  88,  89,  90,   0,   0,   0,  91,   0,  92,  93,   0,   0,  94,   0,   0,
+      0,   0,   0,  95,  96,  97,   0,   0,   0,   0,  98,   0,   0,   0,   0,   0,
+};
+
+// Dígitos 5x5 para ssd1306_draw_small_number (colunas, bit 0 = linha de cima)
+static const uint8_t fonte_pequena_colunas[10][FONTE_PEQUENA_LARGURA] = {
+    {0x0E, 0x11, 0x11, 0x11, 0x0E}, // 0
+    {0x00, 0x00, 0x12, 0x1F, 0x10}, // 1
+    {0x00, 0x00, 0x1D, 0x15, 0x17}, // 2
+    {0x00, 0x00, 0x11, 0x15, 0x1F}, // 3
+    {0x00, 0x00, 0x07, 0x04, 0x1F}, // 4
+    {0x00, 0x00, 0x17, 0x15, 0x1D}, // 5
+    {0x00, 0x00, 0x1F, 0x15, 0x1D}, // 6
+    {0x00, 0x00, 0x01, 0x1D, 0x03}, // 7
+    {0x00, 0x00, 0x1F, 0x15, 0x1F}, // 8
+    {0x00, 0x00, 0x17, 0x15, 0x1F}, // 9
+};
@@ -1,16 +1,20 @@
 #include "ssd1306.h"
-#include "font.h"
+#include "fonte_atlas.h"
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
-#include "hardware/i2c.h"
+
+// O controlador aceita fast-mode (400 kHz) independentemente da velocidade padrão do barramento
+#define SSD1306_I2C_BAUDRATE 400000
+#define SSD1306_MAX_COMMANDS 32   // Maior sequência de ssd1306_commands (a inicialização tem 25 bytes)
 
 // Inicializa a estrutura do display SSD1306
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_barramento_t *barramento) {
     ssd->width = width;
     ssd->height = height;
     ssd->pages = height / 8;
     ssd->address = address;
-    ssd->i2c_port = i2c;
+    ssd->barramento = barramento;
     ssd->bufsize = ssd->pages * ssd->width + 1;
     
     // Aloca buffer de dados
@@ -23,52 +27,116 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
     // Inicializa buffers
     ssd->ram_buffer[0] = 0x40; // Prefixo de dados
     ssd->port_buffer[0] = 0x00; // Prefixo de comando (Co=0, D/C=0)
+    for (uint8_t page = 0; page < SSD1306_MAX_PAGES; ++page) {
+        ssd->dirty_first[page] = 0xFF;
+        ssd->dirty_last[page] = 0;
+    }
+}
+
+// Anota que a coluna da página mudou no buffer
+static inline void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t page, uint8_t x) {
+    if (x < ssd->dirty_first[page]) ssd->dirty_first[page] = x;
+    if (x > ssd->dirty_last[page]) ssd->dirty_last[page] = x;
+}
+
+// Retorna o intervalo de colunas alterado na página (se houver) e o zera
+bool ssd1306_take_dirty(ssd1306_t *ssd, uint8_t page, uint8_t *col_start, uint8_t *col_end) {
+    if (page >= ssd->pages || ssd->dirty_first[page] > ssd->dirty_last[page]) return false;
+    *col_start = ssd->dirty_first[page];
+    *col_end = ssd->dirty_last[page];
+    ssd->dirty_first[page] = 0xFF;
+    ssd->dirty_last[page] = 0;
+    return true;
 }
 
-// Configura os parâmetros iniciais do display
+// Marca o buffer inteiro como alterado (ex.: cópia completa para um novo espelho)
+void ssd1306_mark_all_dirty(ssd1306_t *ssd) {
+    for (uint8_t page = 0; page < ssd->pages; ++page) {
+        ssd->dirty_first[page] = 0;
+        ssd->dirty_last[page] = ssd->width - 1;
+    }
+}
+
+// Envia vários comandos numa única transação (Co=0: todos os bytes seguintes são comandos)
+static void ssd1306_commands(ssd1306_t *ssd, const uint8_t *commands, uint8_t count) {
+    uint8_t buffer[1 + SSD1306_MAX_COMMANDS];
+    if (count > SSD1306_MAX_COMMANDS) return;
+    buffer[0] = 0x00;
+    memcpy(&buffer[1], commands, count);
+    i2c_barramento_transferir(ssd->barramento, ssd->address, SSD1306_I2C_BAUDRATE,
+                              buffer, count + 1, NULL, 0);
+}
+
+// Configura os parâmetros iniciais do display numa única transação I2C
 void ssd1306_config(ssd1306_t *ssd) {
-    ssd1306_command(ssd, 0xAE); // Desliga o display
-    ssd1306_command(ssd, 0x20); // Define modo de memória
-    ssd1306_command(ssd, 0x00); // Endereçamento horizontal
-    ssd1306_command(ssd, 0x40); // Linha inicial
-    ssd1306_command(ssd, 0xA1); // Remapeia segmentos
-    ssd1306_command(ssd, 0xA8); // Define razão de multiplexação
-    ssd1306_command(ssd, ssd->height - 1);
-    ssd1306_command(ssd, 0xC8); // Define direção de varredura COM
-    ssd1306_command(ssd, 0xD3); // Define deslocamento do display
-    ssd1306_command(ssd, 0x00);
-    ssd1306_command(ssd, 0xDA); // Configura pinos COM
-    ssd1306_command(ssd, 0x12);
-    ssd1306_command(ssd, 0xD5); // Define divisor de clock
-    ssd1306_command(ssd, 0x80);
-    ssd1306_command(ssd, 0xD9); // Define período de pré-carga
-    ssd1306_command(ssd, 0xF1);
-    ssd1306_command(ssd, 0xDB); // Define nível VCOMH
-    ssd1306_command(ssd, 0x30);
-    ssd1306_command(ssd, 0x81); // Define contraste
-    ssd1306_command(ssd, 0xFF);
-    ssd1306_command(ssd, 0xA4); // Exibe conteúdo do buffer
-    ssd1306_command(ssd, 0xA6); // Modo normal (não invertido)
-    ssd1306_command(ssd, 0x8D); // Habilita charge pump
-    ssd1306_command(ssd, 0x14);
-    ssd1306_command(ssd, 0xAF); // Liga o display
+    const uint8_t init[] = {
+        0xAE,                   // Desliga o display
+        0x20, 0x00,             // Modo de memória: endereçamento horizontal
+        0x40,                   // Linha inicial
+        0xA1,                   // Remapeia segmentos
+        0xA8, ssd->height - 1,  // Razão de multiplexação
+        0xC8,                   // Direção de varredura COM
+        0xD3, 0x00,             // Deslocamento do display
+        0xDA, 0x12,             // Pinos COM
+        0xD5, 0x80,             // Divisor de clock
+        0xD9, 0xF1,             // Período de pré-carga
+        0xDB, 0x30,             // Nível VCOMH
+        0x81, 0xFF,             // Contraste
+        0xA4,                   // Exibe conteúdo do buffer
+        0xA6,                   // Modo normal (não invertido)
+        0x8D, 0x14,             // Habilita charge pump
+        0xAF,                   // Liga o display
+    };
+    ssd1306_commands(ssd, init, sizeof(init));
 }
 
 // Envia um comando para o display via I2C
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
     ssd->port_buffer[1] = command;
-    i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false);
+    i2c_barramento_transferir(ssd->barramento, ssd->address, SSD1306_I2C_BAUDRATE,
+                              ssd->port_buffer, 2, NULL, 0);
 }
 
 // Envia o buffer de dados para o display
 void ssd1306_send_data(ssd1306_t *ssd) {
-    ssd1306_command(ssd, 0x21); // Define endereço de coluna
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->width - 1);
-    ssd1306_command(ssd, 0x22); // Define endereço de página
-    ssd1306_command(ssd, 0);
-    ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false);
+    const uint8_t window[] = {0x21, 0, ssd->width - 1, 0x22, 0, ssd->pages - 1}; // Colunas e páginas
+    ssd1306_commands(ssd, window, sizeof(window));
+    i2c_barramento_transferir(ssd->barramento, ssd->address, SSD1306_I2C_BAUDRATE,
+                              ssd->ram_buffer, ssd->bufsize, NULL, 0);
+}
+
+// Envia só um retângulo do buffer (páginas e colunas inclusivas). Com endereçamento
+// horizontal o ponteiro da GDDRAM volta a col_start a cada página, então cada página
+// é uma transação de dados que continua de onde a anterior parou.
+void ssd1306_send_region(ssd1306_t *ssd, uint8_t page_start, uint8_t page_end, uint8_t col_start, uint8_t col_end) {
+    const uint8_t window[] = {0x21, col_start, col_end, 0x22, page_start, page_end};
+    ssd1306_commands(ssd, window, sizeof(window));
+
+    uint8_t count = col_end - col_start + 1;
+    uint8_t buffer[129];
+    buffer[0] = 0x40; // Prefixo de dados
+    for (uint8_t page = page_start; page <= page_end; ++page) {
+        memcpy(&buffer[1], &ssd->ram_buffer[page * ssd->width + col_start + 1], count);
+        i2c_barramento_transferir(ssd->barramento, ssd->address, SSD1306_I2C_BAUDRATE,
+                                  buffer, count + 1, NULL, 0);
+    }
+}
+
+// Desloca as páginas indicadas uma coluna para a esquerda na GDDRAM (comando
+// "content scroll" 2Dh) e repete o deslocamento no buffer local. A coluna da
+// direita fica vazia no buffer para ser redesenhada e enviada com ssd1306_send_region.
+// O controlador pede um intervalo de 2 quadros (~20 ms) entre dois deslocamentos.
+void ssd1306_scroll_column_left(ssd1306_t *ssd, uint8_t page_start, uint8_t page_end) {
+    const uint8_t scroll[] = {0x2D, 0x00, page_start, 0x01, page_end, 0x00, 0xFF};
+    ssd1306_commands(ssd, scroll, sizeof(scroll));
+
+    for (uint8_t page = page_start; page <= page_end; ++page) {
+        uint8_t *row = &ssd->ram_buffer[page * ssd->width + 1];
+        memmove(row, row + 1, ssd->width - 1);
+        row[ssd->width - 1] = 0x00;
+        ssd1306_mark_dirty(ssd, page, 0);
+        ssd1306_mark_dirty(ssd, page, ssd->width - 1);
+    }
 }
 
 // Desenha um pixel no buffer
@@ -76,11 +144,13 @@ void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
     if (x >= ssd->width || y >= ssd->height) return; // Verifica limites
     uint16_t index = (y / 8) * ssd->width + x + 1;
     uint8_t pixel = y % 8;
+    uint8_t antes = ssd->ram_buffer[index];
     if (value) {
         ssd->ram_buffer[index] |= (1 << pixel);
     } else {
         ssd->ram_buffer[index] &= ~(1 << pixel);
     }
+    if (ssd->ram_buffer[index] != antes) ssd1306_mark_dirty(ssd, y / 8, x);
 }
 
 // Preenche a tela com pixels ligados ou desligados
@@ -92,85 +162,85 @@ void ssd1306_fill(ssd1306_t *ssd, bool value) {
     }
 }
 
-// Desenha números pequenos (5x5 pixels)
+// Copia uma coluna de 8 pixels para a GDDRAM espelhada, alinhada ou não a uma página
+static inline void ssd1306_blit_coluna(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t coluna, uint8_t altura) {
+    uint8_t mascara = (uint8_t)((1u << altura) - 1);
+    uint8_t desloc = y % 8;
+    uint8_t *destino = &ssd->ram_buffer[(y / 8) * ssd->width + x + 1];
+    uint8_t novo = (desloc == 0 && altura == 8) ? coluna
+                 : (*destino & ~(uint8_t)(mascara << desloc)) | (uint8_t)(coluna << desloc);
+    if (*destino != novo) {
+        *destino = novo;
+        ssd1306_mark_dirty(ssd, y / 8, x);
+    }
+    if (desloc + altura > 8 && (y / 8) + 1 < ssd->pages) {
+        destino += ssd->width;
+        novo = (*destino & ~(uint8_t)(mascara >> (8 - desloc))) | (uint8_t)(coluna >> (8 - desloc));
+        if (*destino != novo) {
+            *destino = novo;
+            ssd1306_mark_dirty(ssd, y / 8 + 1, x);
+        }
+    }
+}
+
 // Desenha números pequenos (5x5 pixels)
 void ssd1306_draw_small_number(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
-    if (c < '0' || c > '9') return; // Verifica se é um número válido
-    uint16_t index = 568 + (c - '0') * 5; // Início dos números pequenos em font[568]
-    for (uint8_t i = 0; i < 5; ++i) {
-        uint8_t line = font [
-
-index + i];
-        for (uint8_t j = 0; j < 5; ++j) {
-            if ((line >> (4 - j)) & 0x01) {
-                ssd1306_pixel(ssd, x + j, y + i, true);
-            }
-        }
+    if (c < '0' || c > '9' || y >= ssd->height) return; // Verifica se é um número válido
+    const uint8_t *colunas = fonte_pequena_colunas[c - '0'];
+    for (uint8_t i = 0; i < FONTE_PEQUENA_LARGURA && x + i < ssd->width; ++i) {
+        ssd1306_blit_coluna(ssd, x + i, y, colunas[i], 5);
     }
 }
 
-// Desenha um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y, bool use_small_numbers) {
+// Desenha um caractere Latin-1 copiando as colunas do atlas; retorna a largura ocupada
+uint8_t ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y, bool use_small_numbers) {
     if (use_small_numbers && c >= '0' && c <= '9') {
         ssd1306_draw_small_number(ssd, c, x, y);
-        return;
-    }
-
-    uint16_t index = 0;
-    bool rotate = false;
-
-    // Mapeia caracteres
-    if (c >= '0' && c <= '9') {
-        index = (c - '0' + 1) * 8;
-    } else if (c >= 'A' && c <= 'Z') {
-        index = (c - 'A' + 11) * 8;
-    } else if (c >= 'a' && c <= 'z') {
-        index = (c - 'a' + 37) * 8;
-    } else if (c == ':') {
-        index = 64 * 8;
-        rotate = true;
-    } else if (c == '.') {
-        index = 65 * 8;
-        rotate = true;
-    } else if (c == '>') {
-        index = 66 * 8;
-        rotate = true;
-    } else if (c == '-') {
-        index = 67 * 8;
-        rotate = true;
-    } else if (c == 127) {
-        index = 68 * 8; // Símbolo Ohm
-    } else if (c == '!') {
-        index = 69 * 8;
-        rotate = true;
-    }
-    else if (c == '%') {
-        index = 70 * 8;
-        rotate = true;
-    } 
-    else if (c == '/') {
-        index = 71 * 8;
-        rotate = true;
-    } 
-    else {
-        return; // Caractere não suportado
-    }
-
-    // Renderiza caractere
-    for (uint8_t i = 0; i < 8; ++i) {
-        uint8_t line = font[index + i];
-        for (uint8_t j = 0; j < 8; ++j) {
-            bool pixel_value = rotate ? (line >> j) & 0x01 : (line >> j) & 0x01;
-            ssd1306_pixel(ssd, x + (rotate ? (7 - j) : i), y + (rotate ? i : j), pixel_value);
-        }
+        return FONTE_PEQUENA_LARGURA;
+    }
+    if (y >= ssd->height) return 0;
+
+    // Caracteres sem desenho usam o glifo 0 (retângulo vazado) em vez de sumir
+    uint8_t glifo = fonte_indice[(uint8_t)c];
+    const uint8_t *colunas = &fonte_colunas[fonte_offset[glifo]];
+    uint8_t largura = fonte_largura[glifo];
+
+    // A coluna de espaçamento também é escrita para limpar o fundo
+    for (uint8_t i = 0; i < largura + FONTE_ESPACAMENTO && x + i < ssd->width; ++i) {
+        ssd1306_blit_coluna(ssd, x + i, y, i < largura ? colunas[i] : 0x00, FONTE_ALTURA);
+    }
+    return largura + FONTE_ESPACAMENTO;
+}
+
+// Largura em pixels de um caractere, sem desenhá-lo
+static uint8_t ssd1306_char_width(char c, bool use_small_numbers) {
+    if (use_small_numbers && c >= '0' && c <= '9') return FONTE_PEQUENA_LARGURA;
+    return fonte_largura[fonte_indice[(uint8_t)c]] + FONTE_ESPACAMENTO;
+}
+
+// Decodifica um caractere UTF-8 para Latin-1 e avança o ponteiro
+static char ssd1306_proximo_latin1(const char **str) {
+    const uint8_t *s = (const uint8_t *)*str;
+    if (s[0] < 0x80) {
+        *str += 1;
+        return (char)s[0];
+    }
+    // U+0080..U+00FF: dois bytes com prefixo 0xC2/0xC3
+    if ((s[0] == 0xC2 || s[0] == 0xC3) && (s[1] & 0xC0) == 0x80) {
+        *str += 2;
+        return (char)(((s[0] & 0x03) << 6) | (s[1] & 0x3F));
     }
+    // Fora do Latin-1 (ou byte inválido): pula a sequência e desenha o glifo ausente
+    *str += 1;
+    while ((**str & 0xC0) == 0x80) *str += 1;
+    return 0;
 }
 
-// Desenha uma string
+// Desenha uma string UTF-8
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y, bool use_small_numbers) {
     while (*str) {
-        char c = *str;
-        uint8_t char_width = (use_small_numbers && c >= '0' && c <= '9') ? 5 : 8;
+        char c = ssd1306_proximo_latin1(&str);
+        uint8_t char_width = ssd1306_char_width(c, use_small_numbers);
 
         // Quebra de linha automática
         if (x + char_width > ssd->width) {
@@ -179,9 +249,7 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y,
             if (y + 8 > ssd->height) break;
         }
 
-        ssd1306_draw_char(ssd, c, x, y, use_small_numbers);
-        x += char_width;
-        str++;
+        x += ssd1306_draw_char(ssd, c, x, y, use_small_numbers);
     }
 }
 
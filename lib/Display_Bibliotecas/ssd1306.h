@@ -4,25 +4,43 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include "hardware/i2c.h"
+#include "i2c_barramento.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_MAX_PAGES 8  // 64 linhas
 
 // Estrutura principal do display SSD1306
 typedef struct {
     uint8_t width, height, pages, address;
-    i2c_inst_t *i2c_port;
+    i2c_barramento_t *barramento;
     uint16_t bufsize;
     uint8_t *ram_buffer;
     uint8_t port_buffer[2];
+    // Colunas alteradas no buffer por página desde a última ssd1306_take_dirty
+    // (dirty_first > dirty_last: página sem alterações)
+    uint8_t dirty_first[SSD1306_MAX_PAGES];
+    uint8_t dirty_last[SSD1306_MAX_PAGES];
 } ssd1306_t;
 
 // Inicialização e configuração
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height,
-                  bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+                  bool external_vcc, uint8_t address, i2c_barramento_t *barramento);
 void ssd1306_config(ssd1306_t *ssd);
 
 // Comunicação I2C
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_send_region(ssd1306_t *ssd, uint8_t page_start, uint8_t page_end, uint8_t col_start, uint8_t col_end);
+
+// Rolagem por hardware de uma coluna (atualização incremental sem reenviar o quadro)
+void ssd1306_scroll_column_left(ssd1306_t *ssd, uint8_t page_start, uint8_t page_end);
+
+// Rastreamento das alterações do buffer (só bytes que realmente mudaram)
+bool ssd1306_take_dirty(ssd1306_t *ssd, uint8_t page, uint8_t *col_start, uint8_t *col_end);
+void ssd1306_mark_all_dirty(ssd1306_t *ssd);
 
 // Funções de desenho básicas
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
@@ -33,13 +51,17 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 
-// Funções de texto
+// Funções de texto (fonte proporcional; strings em UTF-8, caracteres em Latin-1)
 void ssd1306_draw_small_number(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y, bool use_small_numbers);
+uint8_t ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y, bool use_small_numbers);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y, bool use_small_numbers);
 
 // Funções de formas geométricas
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height,
                   bool value, bool fill);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* SSD1306_H */
\ No newline at end of file
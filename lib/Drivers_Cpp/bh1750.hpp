@@ -0,0 +1,54 @@
+// bh1750.hpp
+#ifndef BH1750_HPP
+#define BH1750_HPP
+
+/* ---------- BH1750 com modo fixado em tempo de compilação ----------
+ * O mesmo protocolo de bh1750_light_sensor.c. A conversão contagem → lux
+ * (÷ 1,2 ou ÷ 2,4) vira multiplicação e divisão inteiras por constantes,
+ * sem a divisão em double do driver em C. */
+
+#include <cstdint>
+#include "dispositivo_i2c.hpp"
+#include "bh1750_light_sensor.h"  // BH1750_TEMPO_MEDICAO_MS
+
+namespace drivers {
+
+constexpr uint8_t BH1750_ENDERECO = 0x23;       // Os mesmos de bh1750_light_sensor.c
+constexpr uint32_t BH1750_BAUDRATE = 400000;
+
+enum class ModoBh1750 : uint8_t {
+    AltaResolucao = 0x10,    // 1 lx, até 180 ms
+    AltaResolucao2 = 0x11,   // 0,5 lx, até 180 ms
+    BaixaResolucao = 0x13,   // 4 lx, até 24 ms
+};
+
+template <typename Dispositivo, ModoBh1750 Modo = ModoBh1750::AltaResolucao>
+struct Bh1750 {
+    static constexpr uint32_t tempo_medicao_ms =
+        Modo == ModoBh1750::BaixaResolucao ? 30 : BH1750_TEMPO_MEDICAO_MS;
+
+    // lux = contagem / 1,2 (ou / 2,4 no modo 2) = contagem × 5 / 6 (ou / 12)
+    static constexpr uint16_t converter(uint16_t contagem) {
+        return (uint16_t)(Modo == ModoBh1750::AltaResolucao2 ? contagem * 5u / 12u : contagem * 5u / 6u);
+    }
+
+    static bool ligar() { return comando(0x01); }
+    static bool desligar() { return comando(0x00); }
+    static bool iniciar_medicao() { return comando(static_cast<uint8_t>(Modo)); }
+
+    // Resultado da medição iniciada há pelo menos tempo_medicao_ms (0 se o barramento falhar)
+    static uint16_t ler_resultado() {
+        uint8_t buffer[2];
+        if (!Dispositivo::ler(buffer, 2)) return 0;
+        return converter((uint16_t)((buffer[0] << 8) | buffer[1]));
+    }
+
+private:
+    static bool comando(uint8_t byte) {
+        return Dispositivo::escrever(&byte, 1);
+    }
+};
+
+} // namespace drivers
+
+#endif // BH1750_HPP
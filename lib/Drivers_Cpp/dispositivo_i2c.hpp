@@ -0,0 +1,55 @@
+// dispositivo_i2c.hpp
+#ifndef DISPOSITIVO_I2C_HPP
+#define DISPOSITIVO_I2C_HPP
+
+/* ---------- Dispositivo I2C fixado em tempo de compilação ----------
+ * Barramento, endereço e velocidade são parâmetros do modelo, então cada
+ * chamada a i2c_barramento_transferir() recebe constantes em vez de campos
+ * lidos de uma estrutura. O barramento continua sendo o i2c_barramento_t
+ * global (fila, prazo e recuperação de i2c_barramento.c). */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "i2c_barramento.h"
+
+namespace drivers {
+
+template <i2c_barramento_t &Barramento, uint8_t Endereco, uint32_t Baudrate>
+struct DispositivoI2C {
+    static constexpr uint8_t endereco = Endereco;
+    static constexpr uint32_t baudrate = Baudrate;
+
+    static bool escrever(const uint8_t *dados, uint16_t tamanho) {
+        return i2c_barramento_transferir(&Barramento, Endereco, Baudrate, dados, tamanho, nullptr, 0) == I2C_TRANSACAO_OK;
+    }
+
+    template <std::size_t N>
+    static bool escrever(const std::array<uint8_t, N> &dados) {
+        static_assert(N <= UINT16_MAX, "transacao longa demais");
+        return escrever(dados.data(), N);
+    }
+
+    static bool ler(uint8_t *destino, uint16_t tamanho) {
+        return i2c_barramento_transferir(&Barramento, Endereco, Baudrate, nullptr, 0, destino, tamanho) == I2C_TRANSACAO_OK;
+    }
+
+    // Escreve (ex.: o registrador) e lê em seguida, com RESTART
+    static bool escrever_ler(const uint8_t *escrita, uint16_t tam_escrita, uint8_t *leitura, uint16_t tam_leitura) {
+        return i2c_barramento_transferir(&Barramento, Endereco, Baudrate, escrita, tam_escrita,
+                                         leitura, tam_leitura) == I2C_TRANSACAO_OK;
+    }
+};
+
+// Junta um byte de prefixo (ex.: 0x00 de comando do SSD1306) a uma sequência constante
+template <std::size_t N>
+constexpr std::array<uint8_t, N + 1> com_prefixo(uint8_t prefixo, const std::array<uint8_t, N> &bytes) {
+    std::array<uint8_t, N + 1> saida{};
+    saida[0] = prefixo;
+    for (std::size_t i = 0; i < N; ++i) saida[i + 1] = bytes[i];
+    return saida;
+}
+
+} // namespace drivers
+
+#endif // DISPOSITIVO_I2C_HPP
@@ -0,0 +1,68 @@
+// gy33.hpp
+#ifndef GY33_HPP
+#define GY33_HPP
+
+/* ---------- GY-33 (TCS34725) com integração e ganho fixados ----------
+ * O mesmo protocolo de gy33.c, com a sequência de inicialização montada
+ * como tabela constexpr e o tempo de integração e a contagem máxima
+ * calculados na compilação. */
+
+#include <array>
+#include <cstdint>
+#include "dispositivo_i2c.hpp"
+#include "gy33.h"  // Registradores
+
+namespace drivers {
+
+enum class GanhoGy33 : uint8_t { x1 = 0, x4 = 1, x16 = 2, x60 = 3 };
+
+template <typename Dispositivo, uint8_t Atime = 0xF5, GanhoGy33 Ganho = GanhoGy33::x1>
+struct Gy33 {
+    static constexpr uint32_t tempo_integracao_us = (256u - Atime) * 2400u;
+    // Saturação do canal: 1024 contagens por ciclo de 2,4 ms, limitada a 16 bits
+    static constexpr uint16_t contagem_maxima =
+        (256u - Atime) * 1024u > 65535u ? 65535u : (uint16_t)((256u - Atime) * 1024u);
+
+    // Pares registrador/valor, um por transação (ENABLE, ATIME e CONTROL não são consecutivos)
+    static constexpr std::array<std::array<uint8_t, 2>, 3> sequencia_init = {{
+        {{ ENABLE_REG, ENABLE_PON_AEN }},
+        {{ ATIME_REG, Atime }},
+        {{ CONTROL_REG, static_cast<uint8_t>(Ganho) }},
+    }};
+
+    static void init() {
+        for (const auto &registro : sequencia_init) Dispositivo::escrever(registro);
+    }
+
+    static void desligar() {
+        static constexpr std::array<uint8_t, 2> sleep = {{ ENABLE_REG, 0x00 }};
+        Dispositivo::escrever(sleep);
+    }
+
+    // O datasheet pede 2,4 ms entre PON e AEN
+    static void ligar() {
+        static constexpr std::array<uint8_t, 2> pon = {{ ENABLE_REG, 0x01 }};
+        Dispositivo::escrever(pon);
+        sleep_us(2400);
+        Dispositivo::escrever(sequencia_init[0]);
+    }
+
+    // C, R, G e B numa única transação, como gy33_read_color()
+    static bool ler(uint16_t &r, uint16_t &g, uint16_t &b, uint16_t &c) {
+        static constexpr uint8_t reg = CDATA_REG | AUTO_INCREMENTO;
+        uint8_t buffer[8];
+        if (!Dispositivo::escrever_ler(&reg, 1, buffer, 8)) {
+            c = r = g = b = 0;
+            return false;
+        }
+        c = (uint16_t)((buffer[1] << 8) | buffer[0]);
+        r = (uint16_t)((buffer[3] << 8) | buffer[2]);
+        g = (uint16_t)((buffer[5] << 8) | buffer[4]);
+        b = (uint16_t)((buffer[7] << 8) | buffer[6]);
+        return true;
+    }
+};
+
+} // namespace drivers
+
+#endif // GY33_HPP
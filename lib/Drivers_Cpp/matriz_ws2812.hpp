@@ -0,0 +1,79 @@
+// matriz_ws2812.hpp
+#ifndef MATRIZ_WS2812_HPP
+#define MATRIZ_WS2812_HPP
+
+/* ---------- Matriz WS2812 com montagem fixada em tempo de compilação ----------
+ * Bloco PIO, máquina de estados, pino, dimensões, orientação e serpentina
+ * são parâmetros do modelo. O mapa lógico → posição no fio (o
+ * MATRIZ_MAPA_BITS de matriz_led.c) é uma tabela constexpr, e o quadro
+ * fica no próprio objeto já no formato da FIFO do PIO (GRB << 8). */
+
+#include <array>
+#include <cstdint>
+#include "hardware/pio.h"
+#include "generated/ws2812.pio.h"
+
+namespace drivers {
+
+template <uint8_t BlocoPio, uint8_t Sm, uint8_t Pino, uint8_t Linhas = 5, uint8_t Colunas = 5,
+          bool DeCabecaParaBaixo = true, bool Serpentina = true, bool Rgbw = false>
+class MatrizWs2812 {
+    static_assert(BlocoPio <= 1 && Sm <= 3, "pio0/pio1, máquinas 0 a 3");
+    static_assert(Linhas * Colunas <= 32, "glifos de até 32 bits");
+
+public:
+    static constexpr uint8_t num_pixels = Linhas * Colunas;
+    static constexpr uint32_t frequencia_hz = 800000;
+
+    // Posição no fio do pixel lógico (lin, col), como MATRIZ_INDICE_FISICO
+    static constexpr uint8_t indice_fisico(uint8_t lin, uint8_t col) {
+        uint8_t linha_fio = DeCabecaParaBaixo ? Linhas - 1 - lin : lin;
+        uint8_t coluna_fio = (Serpentina && linha_fio % 2 == 0) ? Colunas - 1 - col : col;
+        return linha_fio * Colunas + coluna_fio;
+    }
+
+    // Posição no fio de cada bit de um glifo (bit num_pixels - 1 = canto superior esquerdo)
+    static constexpr std::array<uint8_t, num_pixels> mapa_bits = [] {
+        std::array<uint8_t, num_pixels> mapa{};
+        for (uint8_t bit = 0; bit < num_pixels; ++bit) {
+            mapa[bit] = indice_fisico(Linhas - 1 - bit / Colunas, Colunas - 1 - bit % Colunas);
+        }
+        return mapa;
+    }();
+
+    static PIO pio() { return BlocoPio == 0 ? pio0 : pio1; }
+
+    // Carrega o programa e liga a máquina de estados (não usar junto com o compositor na mesma SM)
+    static void init() {
+        uint offset = pio_add_program(pio(), &ws2812_program);
+        ws2812_program_init(pio(), Sm, offset, Pino, frequencia_hz, Rgbw);
+    }
+
+    void definir(uint8_t lin, uint8_t col, uint32_t grb) { quadro_[indice_fisico(lin, col)] = grb << 8u; }
+
+    void preencher(uint32_t grb) {
+        for (auto &palavra : quadro_) palavra = grb << 8u;
+    }
+
+    // Escreve `grb` em cada pixel aceso do glifo, como matriz_pintar_glifo()
+    void pintar_glifo(uint32_t glifo, uint32_t grb) {
+        while (glifo) {
+            quadro_[mapa_bits[__builtin_ctz(glifo)]] = grb << 8u;
+            glifo &= glifo - 1;
+        }
+    }
+
+    // Envia o quadro pela FIFO (bloqueante: ~30 us por pixel a 800 kHz)
+    void enviar() const {
+        for (uint32_t palavra : quadro_) pio_sm_put_blocking(pio(), Sm, palavra);
+    }
+
+    const std::array<uint32_t, num_pixels> &quadro() const { return quadro_; }
+
+private:
+    std::array<uint32_t, num_pixels> quadro_{};
+};
+
+} // namespace drivers
+
+#endif // MATRIZ_WS2812_HPP
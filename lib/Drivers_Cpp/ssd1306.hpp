@@ -0,0 +1,212 @@
+// ssd1306.hpp
+#ifndef SSD1306_HPP
+#define SSD1306_HPP
+
+/* ---------- SSD1306 com geometria fixada em tempo de compilação ----------
+ * Mesmo formato de buffer de ssd1306.c (prefixo 0x40 seguido das páginas
+ * em endereçamento horizontal) e mesmo rastreamento de colunas alteradas,
+ * mas com o buffer dimensionado pelo modelo dentro do próprio objeto (sem
+ * calloc) e largura, altura e páginas como constantes: o índice de um
+ * pixel vira deslocamentos e os testes de limite somem quando as
+ * coordenadas também são constantes. */
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include "dispositivo_i2c.hpp"
+#include "fonte_atlas.h"
+
+namespace drivers {
+
+// Decodifica um caractere UTF-8 para Latin-1 e avança o ponteiro (0: fora do Latin-1)
+inline char proximo_latin1(const char *&str) {
+    const uint8_t *s = reinterpret_cast<const uint8_t *>(str);
+    if (s[0] < 0x80) {
+        str += 1;
+        return (char)s[0];
+    }
+    if ((s[0] == 0xC2 || s[0] == 0xC3) && (s[1] & 0xC0) == 0x80) {
+        str += 2;
+        return (char)(((s[0] & 0x03) << 6) | (s[1] & 0x3F));
+    }
+    str += 1;
+    while ((*str & 0xC0) == 0x80) str += 1;
+    return 0;
+}
+
+template <typename Dispositivo, uint8_t Largura = 128, uint8_t Altura = 64, bool VccExterno = false>
+class Ssd1306 {
+    static_assert(Largura > 0 && Largura <= 128, "o SSD1306 tem 128 colunas");
+    static_assert(Altura % 8 == 0 && Altura >= 16 && Altura <= 64, "altura em páginas de 8 linhas, até 64");
+
+public:
+    static constexpr uint8_t largura = Largura;
+    static constexpr uint8_t altura = Altura;
+    static constexpr uint8_t paginas = Altura / 8;
+    static constexpr uint16_t tamanho_quadro = paginas * Largura;
+
+    // Mesma sequência de ssd1306_config(), já com o prefixo de comando (Co = 0, D/C = 0)
+    static constexpr auto sequencia_init = com_prefixo(0x00, std::array<uint8_t, 25>{{
+        0xAE,                                         // Desliga o display
+        0x20, 0x00,                                   // Endereçamento horizontal
+        0x40,                                         // Linha inicial
+        0xA1,                                         // Remapeia segmentos
+        0xA8, Altura - 1,                             // Razão de multiplexação
+        0xC8,                                         // Direção de varredura COM
+        0xD3, 0x00,                                   // Deslocamento do display
+        0xDA, (Altura == 32 && Largura == 128) ? 0x02 : 0x12,  // Pinos COM
+        0xD5, 0x80,                                   // Divisor de clock
+        0xD9, VccExterno ? 0x22 : 0xF1,               // Pré-carga
+        0xDB, 0x30,                                   // Nível VCOMH
+        0x81, 0xFF,                                   // Contraste
+        0xA4,                                         // Exibe o conteúdo da GDDRAM
+        0xA6,                                         // Modo normal (não invertido)
+        0x8D, VccExterno ? 0x10 : 0x14,               // Charge pump só sem VCC externo
+        0xAF,                                         // Liga o display
+    }});
+
+    // Janela da tela inteira (colunas e páginas), enviada antes do quadro completo
+    static constexpr auto janela_completa = com_prefixo(0x00, std::array<uint8_t, 6>{{
+        0x21, 0, Largura - 1, 0x22, 0, paginas - 1,
+    }});
+
+    Ssd1306() {
+        buffer_[0] = 0x40; // Prefixo de dados
+        for (uint8_t pagina = 0; pagina < paginas; ++pagina) {
+            alterado_inicio_[pagina] = 0xFF;
+            alterado_fim_[pagina] = 0;
+        }
+    }
+
+    void init() const { Dispositivo::escrever(sequencia_init); }
+
+    void enviar() const {
+        Dispositivo::escrever(janela_completa);
+        Dispositivo::escrever(buffer_);
+    }
+
+    // Só um retângulo (páginas e colunas inclusivas); uma transação de dados por página
+    void enviar_regiao(uint8_t pagina_inicio, uint8_t pagina_fim, uint8_t coluna_inicio, uint8_t coluna_fim) const {
+        const std::array<uint8_t, 7> janela = {{ 0x00, 0x21, coluna_inicio, coluna_fim, 0x22, pagina_inicio, pagina_fim }};
+        Dispositivo::escrever(janela);
+        uint8_t quantidade = coluna_fim - coluna_inicio + 1;
+        uint8_t linha[1 + Largura];
+        linha[0] = 0x40;
+        for (uint8_t pagina = pagina_inicio; pagina <= pagina_fim; ++pagina) {
+            std::memcpy(&linha[1], &buffer_[indice(coluna_inicio, pagina)], quantidade);
+            Dispositivo::escrever(linha, quantidade + 1);
+        }
+    }
+
+    // Intervalo de colunas alterado na página desde a última chamada (false se nenhum)
+    bool pegar_alteracoes(uint8_t pagina, uint8_t &coluna_inicio, uint8_t &coluna_fim) {
+        if (pagina >= paginas || alterado_inicio_[pagina] > alterado_fim_[pagina]) return false;
+        coluna_inicio = alterado_inicio_[pagina];
+        coluna_fim = alterado_fim_[pagina];
+        alterado_inicio_[pagina] = 0xFF;
+        alterado_fim_[pagina] = 0;
+        return true;
+    }
+
+    void pixel(uint8_t x, uint8_t y, bool valor) {
+        if (x >= Largura || y >= Altura) return;
+        uint8_t &byte = buffer_[indice(x, y / 8)];
+        uint8_t antes = byte;
+        if (valor) {
+            byte |= (uint8_t)(1u << (y % 8));
+        } else {
+            byte &= (uint8_t)~(1u << (y % 8));
+        }
+        if (byte != antes) marcar_alterado(y / 8, x);
+    }
+
+    void preencher(bool valor) {
+        for (uint8_t y = 0; y < Altura; ++y) {
+            for (uint8_t x = 0; x < Largura; ++x) pixel(x, y, valor);
+        }
+    }
+
+    void linha_h(uint8_t x0, uint8_t x1, uint8_t y, bool valor) {
+        for (uint8_t x = x0; x <= x1; ++x) pixel(x, y, valor);
+    }
+
+    void linha_v(uint8_t x, uint8_t y0, uint8_t y1, bool valor) {
+        for (uint8_t y = y0; y <= y1; ++y) pixel(x, y, valor);
+    }
+
+    // Caractere Latin-1 do atlas (ou número pequeno 5x5); retorna a largura ocupada
+    uint8_t desenhar_caractere(char c, uint8_t x, uint8_t y, bool numeros_pequenos = false) {
+        if (numeros_pequenos && c >= '0' && c <= '9') {
+            if (y >= Altura) return FONTE_PEQUENA_LARGURA;
+            const uint8_t *colunas = fonte_pequena_colunas[c - '0'];
+            for (uint8_t i = 0; i < FONTE_PEQUENA_LARGURA && x + i < Largura; ++i) {
+                copiar_coluna(x + i, y, colunas[i], 5);
+            }
+            return FONTE_PEQUENA_LARGURA;
+        }
+        if (y >= Altura) return 0;
+        uint8_t glifo = fonte_indice[(uint8_t)c];
+        const uint8_t *colunas = &fonte_colunas[fonte_offset[glifo]];
+        uint8_t largura_glifo = fonte_largura[glifo];
+        // A coluna de espaçamento também é escrita para limpar o fundo
+        for (uint8_t i = 0; i < largura_glifo + FONTE_ESPACAMENTO && x + i < Largura; ++i) {
+            copiar_coluna(x + i, y, i < largura_glifo ? colunas[i] : 0x00, FONTE_ALTURA);
+        }
+        return largura_glifo + FONTE_ESPACAMENTO;
+    }
+
+    // String UTF-8 com quebra de linha automática, como ssd1306_draw_string()
+    void desenhar_texto(const char *str, uint8_t x, uint8_t y, bool numeros_pequenos = false) {
+        while (*str) {
+            char c = proximo_latin1(str);
+            uint8_t largura_c = (numeros_pequenos && c >= '0' && c <= '9')
+                              ? FONTE_PEQUENA_LARGURA
+                              : fonte_largura[fonte_indice[(uint8_t)c]] + FONTE_ESPACAMENTO;
+            if (x + largura_c > Largura) {
+                x = 0;
+                y += 8;
+                if (y + 8 > Altura) break;
+            }
+            x += desenhar_caractere(c, x, y, numeros_pequenos);
+        }
+    }
+
+    const uint8_t *quadro() const { return &buffer_[1]; }
+
+private:
+    static constexpr uint16_t indice(uint8_t x, uint8_t pagina) { return pagina * Largura + x + 1; }
+
+    void marcar_alterado(uint8_t pagina, uint8_t x) {
+        if (x < alterado_inicio_[pagina]) alterado_inicio_[pagina] = x;
+        if (x > alterado_fim_[pagina]) alterado_fim_[pagina] = x;
+    }
+
+    // Coluna de até 8 pixels, alinhada ou não a uma página
+    void copiar_coluna(uint8_t x, uint8_t y, uint8_t coluna, uint8_t altura_coluna) {
+        uint8_t mascara = (uint8_t)((1u << altura_coluna) - 1);
+        uint8_t desloc = y % 8;
+        uint8_t &destino = buffer_[indice(x, y / 8)];
+        uint8_t novo = (desloc == 0 && altura_coluna == 8) ? coluna
+                     : (uint8_t)((destino & ~(uint8_t)(mascara << desloc)) | (uint8_t)(coluna << desloc));
+        if (destino != novo) {
+            destino = novo;
+            marcar_alterado(y / 8, x);
+        }
+        if (desloc + altura_coluna > 8 && (y / 8) + 1 < paginas) {
+            uint8_t &abaixo = buffer_[indice(x, y / 8 + 1)];
+            novo = (uint8_t)((abaixo & ~(uint8_t)(mascara >> (8 - desloc))) | (uint8_t)(coluna >> (8 - desloc)));
+            if (abaixo != novo) {
+                abaixo = novo;
+                marcar_alterado(y / 8 + 1, x);
+            }
+        }
+    }
+
+    std::array<uint8_t, 1 + tamanho_quadro> buffer_{};  // Prefixo 0x40 + GDDRAM espelhada
+    uint8_t alterado_inicio_[paginas];
+    uint8_t alterado_fim_[paginas];
+};
+
+} // namespace drivers
+
+#endif // SSD1306_HPP
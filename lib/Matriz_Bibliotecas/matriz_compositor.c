@@ -0,0 +1,248 @@
+#include "matriz_compositor.h"
+#include "matriz_led.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
+#if COMPOSITOR_SAIDA_PAINEL
+#include "ws2812_paralelo.h"
+#endif
+
+/* ---------- Estado das camadas (alterado pelo programa, lido no tick) ---------- */
+static uint32_t cor_base = COR_OFF;
+static glifo5x5_t padrao = 0;
+static uint32_t cor_padrao;
+static int digito = -1;
+static uint32_t cor_digito;
+static bool chuva_ativa = false;
+static uint32_t cor_chuva;
+static uint8_t gotas[NUM_COLUNAS];    // Linha de cada gota por coluna (0 = sem gota)
+static uint32_t chuva_acumulado_us;   // Tempo desde o último passo da chuva
+
+/* ---------- Envio ---------- */
+static uint32_t quadro[NUM_PIXELS];   // Palavras já alinhadas para o PIO (GRB << 8)
+#if !COMPOSITOR_SAIDA_PAINEL
+static int canal_dma;
+#endif
+static repeating_timer_t timer_quadros;
+static uint32_t ticks;
+static uint32_t ultimo_tick_us;
+static volatile bool suspenso = false;
+static compositor_estatisticas_t estatisticas;
+
+#if COMPOSITOR_SAIDA_PAINEL
+/* ---------- Painel em pistas paralelas ---------- */
+static uint16_t mapa_painel[PAINEL_PIXELS_POR_PISTA * PAINEL_PISTAS];
+static ws2812_paralelo_painel_t painel;
+static ws2812_paralelo_t saida_painel;
+static uint32_t planos_painel[WS2812_PARALELO_PALAVRAS(PAINEL_PIXELS_POR_PISTA)];
+static uint32_t quadro_painel[PAINEL_PIXELS];
+#endif
+
+// --- Funções Internas ---
+
+// Soma dois valores GRB canal a canal, saturando em 255
+static inline uint32_t somar_grb(uint32_t a, uint32_t b) {
+    uint32_t resultado = 0;
+    for (int desloc = 0; desloc < 24; desloc += 8) {
+        uint32_t canal = ((a >> desloc) & 0xFF) + ((b >> desloc) & 0xFF);
+        resultado |= (canal > 0xFF ? 0xFF : canal) << desloc;
+    }
+    return resultado;
+}
+
+// Avança as gotas uma linha; colunas vazias ganham uma gota nova no topo
+static void avancar_chuva(void) {
+    for (int col = 0; col < NUM_COLUNAS; col++) {
+        if (gotas[col] > 0) {
+            gotas[col]++;
+            if (gotas[col] > NUM_LINHAS - 1) gotas[col] = 0;
+        } else {
+            gotas[col] = 1;
+        }
+    }
+}
+
+// Pinta as camadas, de baixo para cima, num único quadro: a base preenche a
+// matriz inteira; padrão e dígito substituem os pixels que acendem; a chuva
+// soma sua cor (com saturação) ao que estiver abaixo
+static void compor(uint32_t grb[NUM_PIXELS]) {
+    for (int i = 0; i < NUM_PIXELS; ++i) grb[i] = cor_base;
+
+    matriz_pintar_glifo(grb, padrao, cor_padrao);
+    if (digito >= 0) matriz_pintar_glifo(grb, padrao_numeros[digito], cor_digito);
+
+    if (chuva_ativa) {
+        glifo5x5_t gotas_acesas = 0;
+        for (int col = 0; col < NUM_COLUNAS; col++) {
+            if (gotas[col] > 0) gotas_acesas |= 1u << GLIFO5X5_BIT(gotas[col] - 1, col);
+        }
+        while (gotas_acesas) {
+            uint8_t i = MATRIZ_MAPA_BITS[__builtin_ctz(gotas_acesas)];
+            grb[i] = somar_grb(grb[i], cor_chuva);
+            gotas_acesas &= gotas_acesas - 1;
+        }
+    }
+}
+
+#if COMPOSITOR_SAIDA_PAINEL
+// Cada pixel lógico da matriz 5x5 vira um bloco do painel (vizinho mais próximo)
+static void ampliar_para_painel(const uint32_t grb[NUM_PIXELS]) {
+    for (int lin = 0; lin < PAINEL_ALTURA; lin++) {
+        int lin_matriz = lin * NUM_LINHAS / PAINEL_ALTURA;
+        for (int col = 0; col < PAINEL_LARGURA; col++) {
+            int col_matriz = col * NUM_COLUNAS / PAINEL_LARGURA;
+            quadro_painel[lin * PAINEL_LARGURA + col] = grb[MATRIZ_INDICE_FISICO(lin_matriz, col_matriz)];
+        }
+    }
+}
+#endif
+
+// Tick do timer: compõe e dispara exatamente um quadro
+static bool tratar_tick(repeating_timer_t *rt) {
+    uint32_t agora = time_us_32();
+    uint32_t intervalo = ticks > 0 ? agora - ultimo_tick_us : 0;
+    if (ticks > 0) {
+        if (intervalo < estatisticas.intervalo_min_us || estatisticas.intervalo_min_us == 0) {
+            estatisticas.intervalo_min_us = intervalo;
+        }
+        if (intervalo > estatisticas.intervalo_max_us) estatisticas.intervalo_max_us = intervalo;
+    }
+    ultimo_tick_us = agora;
+    ticks++;
+
+    // A chuva anda pelo tempo decorrido, não pela contagem de ticks: a
+    // velocidade não depende do fps nem de um período que não divide 50 ms
+    if (chuva_ativa) {
+        chuva_acumulado_us += intervalo;
+        while (chuva_acumulado_us >= COMPOSITOR_PASSO_CHUVA_MS * 1000u) {
+            chuva_acumulado_us -= COMPOSITOR_PASSO_CHUVA_MS * 1000u;
+            avancar_chuva();
+        }
+    }
+
+    if (suspenso) return true;
+#if COMPOSITOR_SAIDA_PAINEL
+    bool ocupado = ws2812_paralelo_ocupado(&saida_painel);
+#else
+    bool ocupado = dma_channel_is_busy(canal_dma);
+#endif
+    if (ocupado) {
+        estatisticas.quadros_perdidos++;
+        return true;
+    }
+
+    uint32_t grb[NUM_PIXELS];
+    compor(grb);
+    for (int i = 0; i < NUM_PIXELS; ++i) quadro[i] = grb[i] << 8u;  // Também é o que compositor_copiar_quadro devolve
+#if COMPOSITOR_SAIDA_PAINEL
+    ampliar_para_painel(grb);
+    ws2812_paralelo_enviar(&saida_painel, quadro_painel);
+#else
+    dma_channel_transfer_from_buffer_now(canal_dma, quadro, NUM_PIXELS);
+#endif
+
+    estatisticas.quadros_enviados++;
+    estatisticas.composicao_ultima_us = time_us_32() - agora;
+    if (estatisticas.composicao_ultima_us > estatisticas.composicao_max_us) {
+        estatisticas.composicao_max_us = estatisticas.composicao_ultima_us;
+    }
+    return true;
+}
+
+// --- Funções Públicas ---
+
+void compositor_init(uint fps) {
+    if (fps == 0) fps = COMPOSITOR_FPS_PADRAO;
+
+#if COMPOSITOR_SAIDA_PAINEL
+    ws2812_paralelo_mapa_faixas(mapa_painel, &painel, PAINEL_LARGURA, PAINEL_ALTURA, PAINEL_PISTAS);
+    ws2812_paralelo_init(&saida_painel, &painel, MATRIZ_PIO, PAINEL_PINO_BASE, planos_painel);
+#else
+    canal_dma = dma_claim_unused_channel(true);
+    dma_channel_config cfg = dma_channel_get_default_config(canal_dma);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, pio_get_dreq(MATRIZ_PIO, MATRIZ_SM, true));
+    dma_channel_configure(canal_dma, &cfg, &MATRIZ_PIO->txf[MATRIZ_SM], quadro, NUM_PIXELS, false);
+#endif
+
+    // Período negativo: o intervalo conta do início de um tick ao início do próximo
+    add_repeating_timer_us(-(int64_t)(1000000 / fps), tratar_tick, NULL, &timer_quadros);
+}
+
+void compositor_definir_base(uint32_t cor) {
+    cor_base = cor;
+}
+
+void compositor_definir_padrao(glifo5x5_t pad, uint32_t cor) {
+    uint32_t irqs = save_and_disable_interrupts();
+    padrao = pad;
+    cor_padrao = cor;
+    restore_interrupts(irqs);
+}
+
+void compositor_definir_digito(int numero, uint32_t cor) {
+    uint32_t irqs = save_and_disable_interrupts();
+    digito = (numero >= 0 && numero <= 9) ? numero : -1;
+    cor_digito = cor;
+    restore_interrupts(irqs);
+}
+
+void compositor_definir_chuva(bool ativa, uint32_t cor) {
+    uint32_t irqs = save_and_disable_interrupts();
+    if (ativa && !chuva_ativa) {
+        for (int col = 0; col < NUM_COLUNAS; col++) gotas[col] = 0;
+        chuva_acumulado_us = 0;
+    }
+    chuva_ativa = ativa;
+    cor_chuva = cor;
+    restore_interrupts(irqs);
+}
+
+void compositor_limpar(void) {
+    uint32_t irqs = save_and_disable_interrupts();
+    cor_base = COR_OFF;
+    padrao = 0;
+    digito = -1;
+    chuva_ativa = false;
+    restore_interrupts(irqs);
+}
+
+void compositor_mudanca_clock(bool antes, uint32_t clk_sys_hz) {
+    if (antes) {
+        suspenso = true;
+#if COMPOSITOR_SAIDA_PAINEL
+        ws2812_paralelo_aguardar(&saida_painel);
+        while (!pio_sm_is_tx_fifo_empty(MATRIZ_PIO, saida_painel.sm)) {
+            tight_loop_contents();
+        }
+#else
+        dma_channel_wait_for_finish_blocking(canal_dma);
+        while (!pio_sm_is_tx_fifo_empty(MATRIZ_PIO, MATRIZ_SM)) {
+            tight_loop_contents();
+        }
+#endif
+        busy_wait_us_32(60); // Último pixel sai do registrador de deslocamento + reset do WS2812
+        return;
+    }
+    matriz_ajustar_clock(clk_sys_hz);
+#if COMPOSITOR_SAIDA_PAINEL
+    ws2812_paralelo_ajustar_clock(&saida_painel, clk_sys_hz);
+#endif
+    suspenso = false;
+}
+
+compositor_estatisticas_t compositor_obter_estatisticas(void) {
+    uint32_t irqs = save_and_disable_interrupts();
+    compositor_estatisticas_t copia = estatisticas;
+    restore_interrupts(irqs);
+    return copia;
+}
+
+uint32_t compositor_copiar_quadro(uint32_t grb[NUM_PIXELS]) {
+    uint32_t irqs = save_and_disable_interrupts();
+    for (int i = 0; i < NUM_PIXELS; ++i) grb[i] = quadro[i] >> 8u;
+    uint32_t enviados = estatisticas.quadros_enviados;
+    restore_interrupts(irqs);
+    return enviados;
+}
@@ -0,0 +1,53 @@
+#ifndef MATRIZ_COMPOSITOR_H
+#define MATRIZ_COMPOSITOR_H
+
+#include "pico/stdlib.h"
+#include "matriz_led.h"
+
+#define COMPOSITOR_FPS_PADRAO   30  // Quadros por segundo enviados à matriz
+#define COMPOSITOR_PASSO_CHUVA_MS 50  // Intervalo entre passos da animação de chuva
+
+// 1: o quadro 5x5 é ampliado para o painel PAINEL_* de ws2812_paralelo.h e sai
+// pelas pistas paralelas em vez da matriz da placa
+#ifndef COMPOSITOR_SAIDA_PAINEL
+#define COMPOSITOR_SAIDA_PAINEL 0
+#endif
+
+/* ---------- Estatísticas de temporização ---------- */
+typedef struct {
+    uint32_t quadros_enviados;
+    uint32_t quadros_perdidos;          // Tick encontrou o DMA ainda enviando o quadro anterior
+    uint32_t composicao_ultima_us;      // Tempo gasto compondo o último quadro
+    uint32_t composicao_max_us;
+    uint32_t intervalo_min_us;          // Menor e maior distância entre ticks (jitter)
+    uint32_t intervalo_max_us;
+} compositor_estatisticas_t;
+
+// Reserva um canal de DMA e inicia o timer de quadros (PIO da matriz já configurado)
+void compositor_init(uint fps);
+
+// Cor de fundo da matriz inteira (COR_OFF desliga a camada)
+void compositor_definir_base(uint32_t cor);
+
+// Padrão 5x5 (PAD_OK, PAD_EXC, PAD_X...); 0 desliga a camada
+void compositor_definir_padrao(glifo5x5_t pad, uint32_t cor);
+
+// Dígito de padrao_numeros; valores fora de 0-9 desligam a camada
+void compositor_definir_digito(int numero, uint32_t cor);
+
+// Liga ou desliga a animação de chuva
+void compositor_definir_chuva(bool ativa, uint32_t cor);
+
+// Desliga todas as camadas
+void compositor_limpar(void);
+
+// Deve ser chamada antes (antes = true) e depois de uma mudança do clk_sys:
+// segura os quadros até o PIO esvaziar e reajusta o divisor do WS2812
+void compositor_mudanca_clock(bool antes, uint32_t clk_sys_hz);
+
+compositor_estatisticas_t compositor_obter_estatisticas(void);
+
+// Copia o último quadro enviado (GRB, ordem física do fio); retorna quantos quadros já foram enviados
+uint32_t compositor_copiar_quadro(uint32_t grb[NUM_PIXELS]);
+
+#endif /* MATRIZ_COMPOSITOR_H */
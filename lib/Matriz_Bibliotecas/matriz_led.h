@@ -4,26 +4,24 @@
 #include "pico/stdlib.h"
 #include "hardware/pio.h"
 #include "generated/ws2812.pio.h"
+#include "classificador_cor.h"  // GRB(), CorRGB e PALETA_CORES
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 #define PINO_WS2812   7  // Pino GPIO para comunicação com WS2812
+#define MATRIZ_PIO    pio0    // Bloco PIO do WS2812
+#define MATRIZ_SM     0       // Máquina de estados do WS2812
+#define MATRIZ_FREQ_WS2812 800000  // Taxa de bits do protocolo (Hz)
 #define NUM_LINHAS    5  // Número de linhas da matriz
 #define NUM_COLUNAS   5  // Número de colunas da matriz
 #define NUM_PIXELS    (NUM_LINHAS * NUM_COLUNAS)  // Total de LEDs (25)
 #define RGBW_ATIVO    false  // Define protocolo RGB (não RGBW)
 
-/* ---------- Utilidades de cor ---------- */
-#define GRB(r,g,b)   ( ((uint32_t)(g) << 16) | ((uint32_t)(r) << 8) | (b) )  // Converte RGB para formato GRB do WS2812
-
-/* ---------- Estrutura de cor RGB ---------- */
-typedef struct {
-    const char* nome;
-    uint8_t r;
-    uint8_t g;
-    uint8_t b;
-} CorRGB;
-
-/* ---------- Paleta de cores ---------- */
-extern const CorRGB PALETA_CORES[];
+/* ---------- Montagem da placa ---------- */
+#define MATRIZ_DE_CABECA_PARA_BAIXO 1  // A linha de baixo é a primeira do fio
+#define MATRIZ_SERPENTINA           1  // Linhas do fio alternam o sentido (as pares vão da direita para a esquerda)
 
 /* ---------- Cores básicas para padrões ---------- */
 #define COR_BRANCO    GRB(255, 255, 255)  // Branco
@@ -39,19 +37,52 @@ extern const CorRGB PALETA_CORES[];
 #define COR_VERMELHO  GRB(190, 0, 0)     // Vermelho
 #define COR_OFF       GRB(0, 0, 0)        // Desliga LEDs
 
+/* ---------- Glifos 5x5 empacotados ----------
+ * Um glifo é um inteiro de 25 bits escrito linha a linha, de cima para baixo,
+ * com o bit mais significativo de cada linha na coluna da esquerda. O bit
+ * (24 - (lin * 5 + col)) corresponde ao pixel lógico (lin, col). */
+typedef uint32_t glifo5x5_t;
+#define GLIFO5X5(l0, l1, l2, l3, l4) \
+    ((glifo5x5_t)(((l0) << 20) | ((l1) << 15) | ((l2) << 10) | ((l3) << 5) | (l4)))
+#define GLIFO5X5_BIT(lin, col) (24 - ((lin) * NUM_COLUNAS + (col)))
+
+/* ---------- Remapeamento lógico → físico (resolvido em tempo de compilação) ---------- */
+#define MATRIZ_LINHA_FIO(lin)  (MATRIZ_DE_CABECA_PARA_BAIXO ? (NUM_LINHAS - 1 - (lin)) : (lin))
+#define MATRIZ_INDICE_FISICO(lin, col) \
+    (MATRIZ_LINHA_FIO(lin) * NUM_COLUNAS + \
+     ((MATRIZ_SERPENTINA && MATRIZ_LINHA_FIO(lin) % 2 == 0) ? (NUM_COLUNAS - 1 - (col)) : (col)))
+
+// Posição no fio do LED de cada bit de um glifo5x5_t
+extern const uint8_t MATRIZ_MAPA_BITS[NUM_PIXELS];
+
 /* ---------- Padrões 5 × 5 (✓, !, X) ---------- */
-extern const uint8_t PAD_OK[5];   // Padrão "✓" para verde
-extern const uint8_t PAD_EXC[5];  // Padrão "!" para amarelo
-extern const uint8_t PAD_X[5];    // Padrão "X" para vermelho
+extern const glifo5x5_t PAD_OK;   // Padrão "✓" para verde
+extern const glifo5x5_t PAD_EXC;  // Padrão "!" para amarelo
+extern const glifo5x5_t PAD_X;    // Padrão "X" para vermelho
 
-/* ---------- Padrões para dígitos 0-9 (novo formato) ---------- */
-extern const bool padrao_numeros[10][25];  // Array 2D com padrões dos números 0-9
+/* ---------- Padrões para dígitos 0-9 ---------- */
+extern const glifo5x5_t padrao_numeros[10];
 
-/* ---------- API ---------- */
-void inicializar_matriz_led(void);  // Inicializa PIO para WS2812
-void matriz_draw_pattern(const uint8_t pad[5], uint32_t cor_on);  // Desenha padrão na matriz
+// Escreve `cor` no quadro (ordem do fio) em cada pixel aceso do glifo
+static inline void matriz_pintar_glifo(uint32_t quadro[NUM_PIXELS], glifo5x5_t glifo, uint32_t cor) {
+    while (glifo) {
+        quadro[MATRIZ_MAPA_BITS[__builtin_ctz(glifo)]] = cor;
+        glifo &= glifo - 1;  // Apaga o bit menos significativo aceso
+    }
+}
+
+/* ---------- API ----------
+ * Os quadros são enviados pelo compositor (matriz_compositor.h) a cada tick do
+ * timer; as funções abaixo apenas trocam o conteúdo das camadas. */
+void inicializar_matriz_led(void);  // Inicializa PIO para WS2812 e o compositor
+void matriz_ajustar_clock(uint32_t clk_sys_hz);  // Recalcula o divisor do PIO para manter 800 kHz
+void matriz_draw_pattern(glifo5x5_t pad, uint32_t cor_on);  // Desenha padrão na matriz
 void matriz_draw_number(uint8_t numero, uint32_t cor_on);  // Desenha número (0-9) na matriz
-void matriz_draw_rain_animation(uint32_t cor_on);  // Desenha animação de chuva
+void matriz_draw_rain_animation(uint32_t cor_on);  // Liga a animação de chuva
 void matriz_clear(void);  // Limpa todos os LEDs
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* MATRIZ_LED_H */
\ No newline at end of file
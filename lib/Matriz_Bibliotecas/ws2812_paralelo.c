@@ -0,0 +1,120 @@
+#include "ws2812_paralelo.h"
+#include "matriz_led.h"
+#include "generated/ws2812_paralelo.pio.h"
+#include "hardware/dma.h"
+
+// --- Funções Internas ---
+
+// Transpõe a matriz de bits 8x8 guardada em (alto, baixo): o byte N passa a
+// conter o bit N de cada um dos 8 bytes de entrada. Só usa deslocamentos de
+// 32 bits, que o Cortex-M0+ executa em um ciclo.
+static inline void transpor_8x8(uint32_t *alto, uint32_t *baixo) {
+    uint32_t x = *baixo, y = *alto, t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AAu;  x ^= t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AAu;  y ^= t ^ (t << 7);
+
+    t = (x ^ (x >> 14)) & 0x0000CCCCu; x ^= t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCCu; y ^= t ^ (t << 14);
+
+    t = (x ^ (y << 4)) & 0xF0F0F0F0u;
+    x ^= t;
+    y ^= t >> 4;
+
+    *baixo = x;
+    *alto = y;
+}
+
+// --- Funções Públicas ---
+
+void ws2812_paralelo_mapa_faixas(uint16_t *mapa, ws2812_paralelo_painel_t *painel,
+                                 uint16_t largura, uint16_t altura, uint8_t pistas) {
+    uint16_t linhas_por_faixa = (altura + pistas - 1) / pistas;
+    uint16_t por_pista = linhas_por_faixa * largura;
+
+    for (uint16_t pos = 0; pos < por_pista; pos++) {
+        uint16_t lin_faixa = pos / largura;
+        uint16_t col = pos % largura;
+        if (lin_faixa % 2) col = largura - 1 - col;  // Serpentina
+        for (uint8_t pista = 0; pista < pistas; pista++) {
+            uint16_t lin = pista * linhas_por_faixa + lin_faixa;
+            mapa[pos * pistas + pista] = (lin < altura) ? lin * largura + col : WS2812_PARALELO_SEM_PIXEL;
+        }
+    }
+
+    painel->num_pistas = pistas;
+    painel->pixels_por_pista = por_pista;
+    painel->mapa = mapa;
+}
+
+void ws2812_paralelo_transpor(const ws2812_paralelo_painel_t *painel,
+                              const uint32_t *quadro_grb, uint32_t *planos) {
+    const uint16_t *mapa = painel->mapa;
+    uint8_t pistas = painel->num_pistas;
+    uint16_t por_pista = painel->pixels_por_pista;
+
+    for (uint16_t pos = 0; pos < por_pista; pos++) {
+        // Um byte por pista para cada canal: pistas 0-3 em "baixo", 4-7 em "alto"
+        uint32_t g[2] = {0, 0}, r[2] = {0, 0}, b[2] = {0, 0};
+        for (uint8_t pista = 0; pista < pistas; pista++) {
+            uint32_t pixel = mapa ? mapa[pos * pistas + pista] : (uint32_t)pista * por_pista + pos;
+            if (pixel == WS2812_PARALELO_SEM_PIXEL) continue;
+            uint32_t grb = quadro_grb[pixel];
+            uint32_t desloc = (pista & 3u) * 8u;
+            g[pista >> 2] |= ((grb >> 16) & 0xFFu) << desloc;
+            r[pista >> 2] |= ((grb >> 8) & 0xFFu) << desloc;
+            b[pista >> 2] |= (grb & 0xFFu) << desloc;
+        }
+        transpor_8x8(&g[1], &g[0]);
+        transpor_8x8(&r[1], &r[0]);
+        transpor_8x8(&b[1], &b[0]);
+
+        // O PIO desloca para a esquerda: o byte mais alto da palavra sai primeiro,
+        // então "alto" (planos dos bits 7-4) precede "baixo" (bits 3-0)
+        planos[0] = g[1]; planos[1] = g[0];
+        planos[2] = r[1]; planos[3] = r[0];
+        planos[4] = b[1]; planos[5] = b[0];
+        planos += 6;
+    }
+}
+
+void ws2812_paralelo_init(ws2812_paralelo_t *saida, const ws2812_paralelo_painel_t *painel,
+                          PIO pio, uint pino_base, uint32_t *planos) {
+    saida->painel = painel;
+    saida->pio = pio;
+    saida->planos = planos;
+    saida->sm = pio_claim_unused_sm(pio, true);
+    saida->offset = pio_add_program(pio, &ws2812_paralelo_program);
+    ws2812_paralelo_program_init(pio, saida->sm, saida->offset, pino_base, painel->num_pistas,
+                                 MATRIZ_FREQ_WS2812);
+
+    saida->canal_dma = dma_claim_unused_channel(true);
+    dma_channel_config cfg = dma_channel_get_default_config(saida->canal_dma);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, pio_get_dreq(pio, saida->sm, true));
+    dma_channel_configure(saida->canal_dma, &cfg, &pio->txf[saida->sm], planos,
+                          WS2812_PARALELO_PALAVRAS(painel->pixels_por_pista), false);
+}
+
+bool ws2812_paralelo_enviar(ws2812_paralelo_t *saida, const uint32_t *quadro_grb) {
+    if (ws2812_paralelo_ocupado(saida)) return false;
+    ws2812_paralelo_transpor(saida->painel, quadro_grb, saida->planos);
+    dma_channel_transfer_from_buffer_now(saida->canal_dma, saida->planos,
+                                         WS2812_PARALELO_PALAVRAS(saida->painel->pixels_por_pista));
+    return true;
+}
+
+bool ws2812_paralelo_ocupado(const ws2812_paralelo_t *saida) {
+    return dma_channel_is_busy(saida->canal_dma);
+}
+
+void ws2812_paralelo_aguardar(const ws2812_paralelo_t *saida) {
+    dma_channel_wait_for_finish_blocking(saida->canal_dma);
+}
+
+void ws2812_paralelo_ajustar_clock(ws2812_paralelo_t *saida, uint32_t clk_sys_hz) {
+    int ciclos_por_bit = ws2812_paralelo_T1 + ws2812_paralelo_T2 + ws2812_paralelo_T3;
+    pio_sm_set_clkdiv(saida->pio, saida->sm, clk_sys_hz / ((float)MATRIZ_FREQ_WS2812 * ciclos_por_bit));
+}
@@ -0,0 +1,72 @@
+#ifndef WS2812_PARALELO_H
+#define WS2812_PARALELO_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+/* ---------- Saída WS2812 em até 8 pistas paralelas ----------
+ * Cada pista é uma fita (ou um trecho do painel) ligada a um pino a partir de
+ * pino_base. O quadro GRB é transposto em planos de bits: um byte por tempo de
+ * bit, com o bit N indo para a pista N, quatro planos por palavra do FIFO. Um
+ * painel de P pixels por pista leva o mesmo tempo que uma fita de P LEDs. */
+
+#define WS2812_PARALELO_MAX_PISTAS 8
+#define WS2812_PARALELO_SEM_PIXEL  0xFFFF  // Posição do mapa sem LED (pista mais curta)
+
+// Palavras de 32 bits de planos por quadro: 24 bits por pixel, 4 planos por palavra
+#define WS2812_PARALELO_PALAVRAS(pixels_por_pista) ((pixels_por_pista) * 6)
+
+/* ---------- Painel usado com COMPOSITOR_SAIDA_PAINEL (ajuste para a montagem usada) ---------- */
+#define PAINEL_LARGURA   16   // Colunas do painel
+#define PAINEL_ALTURA    16   // Linhas do painel
+#define PAINEL_PISTAS    4    // Faixas horizontais, uma por pino de dados
+#define PAINEL_PINO_BASE 16   // GP16..GP19 (GP14/15 ficam com o I2C do display)
+#define PAINEL_PIXELS    (PAINEL_LARGURA * PAINEL_ALTURA)
+// Faixas de linhas inteiras, como ws2812_paralelo_mapa_faixas monta
+#define PAINEL_PIXELS_POR_PISTA (((PAINEL_ALTURA + PAINEL_PISTAS - 1) / PAINEL_PISTAS) * PAINEL_LARGURA)
+
+/* ---------- Geometria: quem vai em cada posição de cada pista ---------- */
+typedef struct {
+    uint8_t num_pistas;          // Pinos de dados usados (1 a 8)
+    uint16_t pixels_por_pista;   // LEDs da pista mais longa
+    // mapa[posicao * num_pistas + pista] = índice no quadro GRB ou WS2812_PARALELO_SEM_PIXEL.
+    // NULL: pista N recebe os pixels N * pixels_por_pista em diante, em ordem.
+    const uint16_t *mapa;
+} ws2812_paralelo_painel_t;
+
+/* ---------- Estado de uma saída ---------- */
+typedef struct {
+    const ws2812_paralelo_painel_t *painel;
+    PIO pio;
+    uint sm;
+    uint offset;
+    int canal_dma;
+    uint32_t *planos;            // WS2812_PARALELO_PALAVRAS(pixels_por_pista) palavras
+} ws2812_paralelo_t;
+
+// Preenche o mapa de um painel largura x altura dividido em faixas horizontais,
+// uma por pista, cada faixa ligada em serpentina (linhas alternam o sentido).
+// O quadro é indexado por linha * largura + coluna.
+void ws2812_paralelo_mapa_faixas(uint16_t *mapa, ws2812_paralelo_painel_t *painel,
+                                 uint16_t largura, uint16_t altura, uint8_t pistas);
+
+// Converte o quadro GRB (um uint32_t por pixel, 0x00GGRRBB) em planos de bits
+void ws2812_paralelo_transpor(const ws2812_paralelo_painel_t *painel,
+                              const uint32_t *quadro_grb, uint32_t *planos);
+
+// Carrega o programa PIO numa máquina livre e reserva um canal de DMA
+void ws2812_paralelo_init(ws2812_paralelo_t *saida, const ws2812_paralelo_painel_t *painel,
+                          PIO pio, uint pino_base, uint32_t *planos);
+
+// Transpõe e dispara o DMA; retorna false (sem tocar nos planos) se o quadro anterior ainda sai
+bool ws2812_paralelo_enviar(ws2812_paralelo_t *saida, const uint32_t *quadro_grb);
+
+bool ws2812_paralelo_ocupado(const ws2812_paralelo_t *saida);
+
+// Bloqueia até o DMA entregar o quadro em andamento ao PIO
+void ws2812_paralelo_aguardar(const ws2812_paralelo_t *saida);
+
+// Mantém a taxa de bits após uma mudança do clk_sys
+void ws2812_paralelo_ajustar_clock(ws2812_paralelo_t *saida, uint32_t clk_sys_hz);
+
+#endif /* WS2812_PARALELO_H */
@@ -0,0 +1,187 @@
+#include "alarmes_lux.h"
+#include <math.h>
+#include <string.h>
+
+static const char *const nomes_regras[NUM_REGRAS_ALARME_LUX] = {
+    "lux baixo", "lux alto", "variacao rapida", "desvio da media",
+};
+
+// --- Funções Internas ---
+
+static inline uint8_t posicao(const janela_lux_t *j, uint8_t inicio, uint8_t k) {
+    uint8_t p = inicio + k;
+    return p >= j->tamanho ? p - j->tamanho : p;
+}
+
+// Tira da frente das filas a amostra que saiu da janela
+static void filas_remover(janela_lux_t *j, uint32_t seq) {
+    if (j->min_quantidade && j->fila_min[j->min_inicio].seq == seq) {
+        j->min_inicio = posicao(j, j->min_inicio, 1);
+        j->min_quantidade--;
+    }
+    if (j->max_quantidade && j->fila_max[j->max_inicio].seq == seq) {
+        j->max_inicio = posicao(j, j->max_inicio, 1);
+        j->max_quantidade--;
+    }
+}
+
+// Descarta do fim os candidatos que a amostra nova supera; cada amostra entra e sai uma vez só
+static void filas_inserir(janela_lux_t *j, uint32_t seq, uint16_t valor) {
+    while (j->min_quantidade && j->fila_min[posicao(j, j->min_inicio, j->min_quantidade - 1)].valor >= valor) {
+        j->min_quantidade--;
+    }
+    j->fila_min[posicao(j, j->min_inicio, j->min_quantidade++)] = (item_fila_t){ seq, valor };
+    while (j->max_quantidade && j->fila_max[posicao(j, j->max_inicio, j->max_quantidade - 1)].valor <= valor) {
+        j->max_quantidade--;
+    }
+    j->fila_max[posicao(j, j->max_inicio, j->max_quantidade++)] = (item_fila_t){ seq, valor };
+}
+
+static void remover_mais_antiga(janela_lux_t *j) {
+    double x = j->valores[j->inicio];
+    double t = (double)(int32_t)(j->instantes_ms[j->inicio] - j->base_ms);
+    if (j->quantidade > 1) {
+        double d = x - j->media;
+        j->media -= d / (j->quantidade - 1);
+        j->m2 -= d * (x - j->media);
+        if (j->m2 < 0) j->m2 = 0;
+    } else {
+        j->media = j->m2 = 0;
+    }
+    // Termos inteiros: somar e subtrair em double é exato, sem deriva
+    j->soma_x -= x;
+    j->soma_t -= t;
+    j->soma_t2 -= t * t;
+    j->soma_tx -= t * x;
+    filas_remover(j, j->seq - j->quantidade);
+    j->inicio = posicao(j, j->inicio, 1);
+    j->quantidade--;
+}
+
+// Refaz média, variância e somas a partir do anel. A remoção de Welford acumula
+// arredondamento e o tempo relativo cresce; uma vez por volta (O(1) amortizado) basta.
+static void ancorar(janela_lux_t *j) {
+    j->base_ms = j->instantes_ms[j->inicio];
+    double soma = 0;
+    for (uint8_t k = 0; k < j->quantidade; k++) soma += j->valores[posicao(j, j->inicio, k)];
+    j->media = soma / j->quantidade;
+    j->m2 = j->soma_t = j->soma_t2 = j->soma_tx = 0;
+    for (uint8_t k = 0; k < j->quantidade; k++) {
+        uint8_t p = posicao(j, j->inicio, k);
+        double x = j->valores[p];
+        double t = (double)(int32_t)(j->instantes_ms[p] - j->base_ms);
+        j->m2 += (x - j->media) * (x - j->media);
+        j->soma_t += t;
+        j->soma_t2 += t * t;
+        j->soma_tx += t * x;
+    }
+    j->soma_x = soma;
+}
+
+// --- Funções Públicas ---
+
+void janela_lux_init(janela_lux_t *j, uint8_t tamanho) {
+    memset(j, 0, sizeof(*j));
+    if (tamanho < 2) tamanho = 2;
+    if (tamanho > ALARMES_LUX_JANELA_MAX) tamanho = ALARMES_LUX_JANELA_MAX;
+    j->tamanho = tamanho;
+}
+
+void janela_lux_adicionar(janela_lux_t *j, uint16_t valor, uint32_t instante_ms) {
+    if (j->quantidade == j->tamanho) remover_mais_antiga(j);
+    if (j->quantidade == 0) j->base_ms = instante_ms;
+
+    uint8_t p = posicao(j, j->inicio, j->quantidade);
+    j->valores[p] = valor;
+    j->instantes_ms[p] = instante_ms;
+    j->quantidade++;
+
+    double x = valor;
+    double d = x - j->media;
+    j->media += d / j->quantidade;
+    j->m2 += d * (x - j->media);
+
+    double t = (double)(int32_t)(instante_ms - j->base_ms);
+    j->soma_x += x;
+    j->soma_t += t;
+    j->soma_t2 += t * t;
+    j->soma_tx += t * x;
+
+    filas_inserir(j, j->seq, valor);
+    j->seq++;
+    if (j->quantidade == j->tamanho && j->seq % j->tamanho == 0) ancorar(j);
+}
+
+float janela_lux_media(const janela_lux_t *j) {
+    return (float)j->media;
+}
+
+float janela_lux_desvio(const janela_lux_t *j) {
+    return j->quantidade < 2 ? 0.0f : (float)sqrt(j->m2 / (j->quantidade - 1));
+}
+
+uint16_t janela_lux_minimo(const janela_lux_t *j) {
+    return j->min_quantidade ? j->fila_min[j->min_inicio].valor : 0;
+}
+
+uint16_t janela_lux_maximo(const janela_lux_t *j) {
+    return j->max_quantidade ? j->fila_max[j->max_inicio].valor : 0;
+}
+
+float janela_lux_inclinacao(const janela_lux_t *j) {
+    double n = j->quantidade;
+    double den = n * j->soma_t2 - j->soma_t * j->soma_t;
+    if (j->quantidade < 2 || den <= 0) return 0.0f;
+    return (float)((n * j->soma_tx - j->soma_t * j->soma_x) / den * 1000.0);
+}
+
+void alarmes_lux_init(alarmes_lux_t *a, uint8_t tamanho_janela) {
+    memset(a, 0, sizeof(*a));
+    janela_lux_init(&a->janela, tamanho_janela);
+}
+
+uint8_t alarmes_lux_atualizar(alarmes_lux_t *a, const config_alarmes_lux_t *cfg, uint16_t lux, uint32_t agora_ms) {
+    janela_lux_t *j = &a->janela;
+    // Taxa e desvio só depois de meia janela: antes disso a média e a reta não dizem nada
+    bool aquecida = j->quantidade >= (j->tamanho + 1) / 2;
+    uint8_t condicoes = 0;
+
+    int32_t folga_baixo = (a->ativos & ALARME_LUX_BAIXO) ? cfg->histerese_lux : 0;
+    int32_t folga_alto = (a->ativos & ALARME_LUX_ALTO) ? cfg->histerese_lux : 0;
+    if (lux < cfg->lux_min + folga_baixo) condicoes |= ALARME_LUX_BAIXO;
+    if (lux > cfg->lux_max - folga_alto) condicoes |= ALARME_LUX_ALTO;
+
+    // Desvio contra a janela anterior, para o próprio pico não puxar a média
+    if (aquecida && cfg->desvio_z > 0) {
+        float desvio = janela_lux_desvio(j);
+        if (desvio < cfg->desvio_min_lux) desvio = cfg->desvio_min_lux;
+        if (fabsf((float)lux - janela_lux_media(j)) > cfg->desvio_z * desvio) condicoes |= ALARME_LUX_DESVIO;
+    }
+
+    janela_lux_adicionar(j, lux, agora_ms);
+    if (aquecida && cfg->taxa_max_lux_s > 0 && fabsf(janela_lux_inclinacao(j)) > cfg->taxa_max_lux_s) {
+        condicoes |= ALARME_LUX_TAXA;
+    }
+
+    // Só a borda dispara; uma borda dentro da espera é engolida
+    uint8_t bordas = condicoes & ~a->ativos;
+    a->ativos = condicoes;
+    uint8_t disparados = 0;
+    for (uint8_t k = 0; k < NUM_REGRAS_ALARME_LUX; k++) {
+        uint8_t bit = 1u << k;
+        if (!(bordas & bit)) continue;
+        if ((a->ja_disparou & bit) && agora_ms - a->ultimo_disparo_ms[k] < cfg->espera_ms) continue;
+        disparados |= bit;
+        a->ja_disparou |= bit;
+        a->ultimo_disparo_ms[k] = agora_ms;
+        a->disparos[k]++;
+    }
+    return disparados;
+}
+
+const char *alarmes_lux_nome(uint8_t regra) {
+    for (uint8_t k = 0; k < NUM_REGRAS_ALARME_LUX; k++) {
+        if (regra == (1u << k)) return nomes_regras[k];
+    }
+    return "?";
+}
@@ -0,0 +1,80 @@
+#ifndef ALARMES_LUX_H
+#define ALARMES_LUX_H
+
+/* ---------- Alarmes de luminosidade ----------
+ * Estatísticas de uma janela deslizante das últimas amostras, todas O(1)
+ * por amostra: média e variância (Welford com remoção), mínimo e máximo
+ * (filas monotônicas) e inclinação (mínimos quadrados sobre o tempo de
+ * cada amostra). As regras disparam na borda (quando a condição passa a
+ * valer) e depois respeitam uma espera antes de disparar de novo.
+ * C puro, sem o Pico SDK: tools/replay roda o mesmo motor sobre traces. */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ALARMES_LUX_JANELA_MAX    64
+#define ALARMES_LUX_JANELA_PADRAO 16  // ~5 s com o intervalo padrão de 300 ms
+
+/* ---------- Regras (bits de alarmes_lux_t.ativos e do retorno de alarmes_lux_atualizar) ---------- */
+enum {
+    ALARME_LUX_BAIXO  = 1 << 0,    // Abaixo de lux_min
+    ALARME_LUX_ALTO   = 1 << 1,    // Acima de lux_max
+    ALARME_LUX_TAXA   = 1 << 2,    // |inclinação da janela| acima de taxa_max_lux_s
+    ALARME_LUX_DESVIO = 1 << 3,    // Amostra a mais de desvio_z desvios da média da janela
+};
+#define NUM_REGRAS_ALARME_LUX 4
+
+typedef struct {
+    int32_t lux_min, lux_max;
+    int32_t histerese_lux;         // Baixo/alto só se desfazem com essa folga para dentro da faixa
+    float taxa_max_lux_s;          // 0 desliga a regra de taxa
+    float desvio_z;                // 0 desliga a regra de desvio
+    float desvio_min_lux;          // Piso do desvio padrão (luz estável não dispara por ruído)
+    uint32_t espera_ms;            // Intervalo mínimo entre dois disparos da mesma regra
+} config_alarmes_lux_t;
+
+/* ---------- Janela deslizante ---------- */
+typedef struct {
+    uint32_t seq;                  // Número da amostra (para saber quando sai da janela)
+    uint16_t valor;
+} item_fila_t;
+
+typedef struct {
+    uint16_t valores[ALARMES_LUX_JANELA_MAX];   // Anel com as amostras da janela
+    uint32_t instantes_ms[ALARMES_LUX_JANELA_MAX];
+    uint8_t tamanho, quantidade, inicio;
+    uint32_t seq;                  // Amostras recebidas desde o início
+    double media, m2;              // Welford
+    uint32_t base_ms;              // Origem do tempo nas somas da inclinação
+    double soma_t, soma_t2, soma_tx;
+    double soma_x;
+    item_fila_t fila_min[ALARMES_LUX_JANELA_MAX];  // Candidatos a mínimo, valores crescentes
+    item_fila_t fila_max[ALARMES_LUX_JANELA_MAX];  // Candidatos a máximo, valores decrescentes
+    uint8_t min_inicio, min_quantidade, max_inicio, max_quantidade;
+} janela_lux_t;
+
+typedef struct {
+    janela_lux_t janela;
+    uint8_t ativos;                // Regras cuja condição vale agora
+    uint32_t ultimo_disparo_ms[NUM_REGRAS_ALARME_LUX];
+    uint8_t ja_disparou;           // Bit por regra: ultimo_disparo_ms é válido
+    uint32_t disparos[NUM_REGRAS_ALARME_LUX];
+} alarmes_lux_t;
+
+void janela_lux_init(janela_lux_t *j, uint8_t tamanho);
+void janela_lux_adicionar(janela_lux_t *j, uint16_t valor, uint32_t instante_ms);
+float janela_lux_media(const janela_lux_t *j);
+float janela_lux_desvio(const janela_lux_t *j);     // Desvio padrão amostral
+uint16_t janela_lux_minimo(const janela_lux_t *j);
+uint16_t janela_lux_maximo(const janela_lux_t *j);
+float janela_lux_inclinacao(const janela_lux_t *j); // lux/s
+
+void alarmes_lux_init(alarmes_lux_t *a, uint8_t tamanho_janela);
+
+// Avalia as regras para a amostra nova (antes de ela entrar na janela) e a acrescenta.
+// Retorna os bits das regras que dispararam nesta amostra.
+uint8_t alarmes_lux_atualizar(alarmes_lux_t *a, const config_alarmes_lux_t *cfg, uint16_t lux, uint32_t agora_ms);
+
+const char *alarmes_lux_nome(uint8_t regra);
+
+#endif // ALARMES_LUX_H
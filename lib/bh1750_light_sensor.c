@@ -3,8 +3,8 @@
 ///
 /// Simple driver for interfacing with the 
 /// BH1750 light sensor over I2C.
-/// This interface assumes a I2C block & 
-/// bus has been initialized already.
+/// This interface assumes the I2C bus has
+/// been initialized with i2c_barramento_init().
 ///
 /// Created by Michael Hogue.
 ///
@@ -12,7 +12,9 @@
 #include "bh1750_light_sensor.h"
 
 #define _BH1750_I2C_ADDR 0x23       // Device's I2C address
+#define _BH1750_I2C_BAUDRATE 400000 // Fast-mode is supported by the BH1750
 
+const uint8_t _POWER_DOWN_C = 0x00; // Power down command (no active state)
 const uint8_t _POWER_ON_C = 0x01;   // Power on command
 const uint8_t _CONT_HRES_C = 0x10;  // Modo de alta resolução (1 lux)
 const uint8_t _CONT_HRES2_C = 0x11; // Modo de alta resolução 2 (0.5 lux)
@@ -21,40 +23,107 @@ const uint8_t _CONT_LRES_C = 0x13;  // Modo de baixa resolução (4 lux)
 /**
  * @brief Push one byte of data to TX FIFO.
  * 
- * @param i2c Initialized RP2040 I2C block.
+ * @param bar Initialized I2C bus.
  * @param byte Byte of data to push.
+ * @return true if the device acknowledged the byte.
  */
-void _i2c_write_byte(i2c_inst_t* i2c, uint8_t byte) {
-    i2c_write_blocking(i2c, _BH1750_I2C_ADDR, &byte, 1, false);
+bool _i2c_write_byte(i2c_barramento_t* bar, uint8_t byte) {
+    return i2c_barramento_transferir(bar, _BH1750_I2C_ADDR, _BH1750_I2C_BAUDRATE,
+                                     &byte, 1, NULL, 0) == I2C_TRANSACAO_OK;
 }
 
 /**
  * @brief Powers on the BH1750.
  * 
- * @param i2c Initialized RP2040 I2C block.
+ * @param bar Initialized I2C bus.
  */
-void bh1750_power_on(i2c_inst_t* i2c) {
-    _i2c_write_byte(i2c, _POWER_ON_C);
+void bh1750_power_on(i2c_barramento_t* bar) {
+    _i2c_write_byte(bar, _POWER_ON_C);
 }
 
 /**
- * @brief Get a measurement of ambient light from the BH1750.
+ * @brief Powers down the BH1750 between samples.
+ * 
+ * bh1750_power_on() must be called again before the next measurement.
+ * 
+ * @param bar Initialized I2C bus.
+ */
+void bh1750_power_down(i2c_barramento_t* bar) {
+    _i2c_write_byte(bar, _POWER_DOWN_C);
+}
+
+/**
+ * @brief Starts a high-resolution measurement without waiting for it.
+ * 
+ * The result is available BH1750_TEMPO_MEDICAO_MS later through
+ * bh1750_read_result(), so the caller can do other work meanwhile.
  * 
- * @param i2c Initialized RP2040 I2C block.
- * @return uint16_t Measurement result (lux).
+ * @param bar Initialized I2C bus.
+ * @return true if the device acknowledged the command.
  */
-uint16_t bh1750_read_measurement(i2c_inst_t* i2c) {
+bool bh1750_start_measurement(i2c_barramento_t* bar) {
     // Send "Continuously H-resolution mode" instruction
-    _i2c_write_byte(i2c, _CONT_HRES_C);
+    return _i2c_write_byte(bar, _CONT_HRES_C);
+}
 
-    // Wait at least 180 ms to complete measurement
-    sleep_ms(200);
+/**
+ * @brief Reads the result of the measurement started earlier.
+ * 
+ * @param bar Initialized I2C bus.
+ * @return uint16_t Measurement result (lux), or 0 if the bus failed.
+ */
+uint16_t bh1750_read_result(i2c_barramento_t* bar) {
+    bh1750_leitura_t leitura;
+    bh1750_begin_read_result(bar, &leitura);
+    return bh1750_end_read_result(&leitura);
+}
 
-    uint8_t buff[2];
+/**
+ * @brief Enqueues the result read without waiting for it.
+ * 
+ * @param bar Initialized I2C bus.
+ * @param leitura Must stay valid until bh1750_end_read_result().
+ * @return true if the transaction fit in the bus queue.
+ */
+bool bh1750_begin_read_result(i2c_barramento_t* bar, bh1750_leitura_t* leitura) {
+    leitura->transacao = (i2c_transacao_t){
+        .endereco = _BH1750_I2C_ADDR,
+        .leitura = leitura->buff,
+        .tam_leitura = 2,
+        .baudrate = _BH1750_I2C_BAUDRATE,
+    };
+    return i2c_barramento_enfileirar(bar, &leitura->transacao);
+}
 
-    i2c_read_blocking(i2c, _BH1750_I2C_ADDR, buff, 2, false);
+/**
+ * @brief Waits for a read enqueued by bh1750_begin_read_result().
+ * 
+ * @param leitura Read in progress.
+ * @return uint16_t Measurement result (lux), or 0 if the bus failed.
+ */
+uint16_t bh1750_end_read_result(bh1750_leitura_t* leitura) {
+    if (i2c_barramento_aguardar(&leitura->transacao) != I2C_TRANSACAO_OK) {
+        return 0;
+    }
 
-    return (((uint16_t)buff[0] << 8) | buff[1]) / 1.2;
+    return (((uint16_t)leitura->buff[0] << 8) | leitura->buff[1]) / 1.2;
     // Obs. quando utilizar _CONT_HRES2_C dividir por 2.4
     // Quando utilizar _CONT_HRES_C dividir por 1.2
+}
+
+/**
+ * @brief Get a measurement of ambient light from the BH1750.
+ * 
+ * Blocks for BH1750_TEMPO_MEDICAO_MS.
+ * 
+ * @param bar Initialized I2C bus.
+ * @return uint16_t Measurement result (lux), or 0 if the bus failed.
+ */
+uint16_t bh1750_read_measurement(i2c_barramento_t* bar) {
+    if (!bh1750_start_measurement(bar)) return 0;
+
+    // Wait at least 180 ms to complete measurement
+    sleep_ms(BH1750_TEMPO_MEDICAO_MS);
+
+    return bh1750_read_result(bar);
 }
\ No newline at end of file
@@ -2,13 +2,39 @@
 #define BH1750_LIGHT_SENSOR_H
 
 #include "pico/stdlib.h"
-#include "hardware/i2c.h"
+#include "i2c_barramento.h"
 #include "hardware/gpio.h"
 
-void _i2c_write_byte(i2c_inst_t* i2c, uint8_t byte); 
+#ifdef __cplusplus
+extern "C" {
+#endif
 
-void bh1750_power_on(i2c_inst_t* i2c);
+#define BH1750_TEMPO_MEDICAO_MS 200 // Alta resolução: no máximo 180 ms, com folga
 
-uint16_t bh1750_read_measurement(i2c_inst_t* i2c);
+bool _i2c_write_byte(i2c_barramento_t* bar, uint8_t byte);
+
+void bh1750_power_on(i2c_barramento_t* bar);
+
+void bh1750_power_down(i2c_barramento_t* bar);
+
+bool bh1750_start_measurement(i2c_barramento_t* bar);
+
+uint16_t bh1750_read_result(i2c_barramento_t* bar);
+
+// Two-step result read: enqueue now, wait later (e.g. while another bus works)
+typedef struct {
+    i2c_transacao_t transacao;
+    uint8_t buff[2];
+} bh1750_leitura_t;
+
+bool bh1750_begin_read_result(i2c_barramento_t* bar, bh1750_leitura_t* leitura);
+
+uint16_t bh1750_end_read_result(bh1750_leitura_t* leitura);
+
+uint16_t bh1750_read_measurement(i2c_barramento_t* bar);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include "botoes.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+
+/* ---------- Máquina de estados de cada botão ---------- */
+typedef enum {
+    BOTAO_SOLTO = 0,
+    BOTAO_CONFIRMANDO_PRESSAO,
+    BOTAO_PRESSIONADO,
+    BOTAO_CONFIRMANDO_SOLTURA,
+} estado_botao_t;
+
+typedef struct {
+    uint8_t gpio;
+    estado_botao_t estado;
+    uint8_t estaveis;            // Leituras seguidas no nível que está sendo confirmado
+    uint32_t borda_us;           // Primeira borda desde que o botão ficou solto
+    bool borda_pendente;
+} botao_t;
+
+static botao_t botoes[BOTOES_MAX];
+static uint8_t num_botoes;
+static botoes_callback_t callback;
+
+// Fila circular: produzida no timer, consumida no laço principal
+static evento_botao_t fila[BOTOES_FILA_TAM];
+static volatile uint8_t cabeca, cauda;
+static uint32_t perdidos;
+
+static repeating_timer_t timer_amostragem;
+static bool amostrando = false;
+
+// --- Funções Internas ---
+
+static void publicar(const botao_t *botao) {
+    uint8_t proxima = (cauda + 1) % BOTOES_FILA_TAM;
+    if (proxima == cabeca) {
+        perdidos++;
+        return;
+    }
+    fila[cauda] = (evento_botao_t){ .gpio = botao->gpio, .instante_us = botao->borda_us };
+    cauda = proxima;
+    if (callback) callback();
+}
+
+// Um passo da máquina de estados; retorna true enquanto o botão ainda não está em repouso
+static bool atualizar(botao_t *botao) {
+    bool apertado = !gpio_get(botao->gpio);
+
+    switch (botao->estado) {
+    case BOTAO_SOLTO:
+        if (apertado) {
+            botao->estado = BOTAO_CONFIRMANDO_PRESSAO;
+            botao->estaveis = 1;
+        }
+        break;
+    case BOTAO_CONFIRMANDO_PRESSAO:
+        if (!apertado) {
+            botao->estado = BOTAO_SOLTO;  // Ruído: volta sem evento
+        } else if (++botao->estaveis >= BOTOES_AMOSTRAS_ESTAVEIS) {
+            botao->estado = BOTAO_PRESSIONADO;
+            publicar(botao);
+        }
+        break;
+    case BOTAO_PRESSIONADO:
+        if (!apertado) {
+            botao->estado = BOTAO_CONFIRMANDO_SOLTURA;
+            botao->estaveis = 1;
+        }
+        break;
+    case BOTAO_CONFIRMANDO_SOLTURA:
+        if (apertado) {
+            botao->estado = BOTAO_PRESSIONADO;
+        } else if (++botao->estaveis >= BOTOES_AMOSTRAS_ESTAVEIS) {
+            botao->estado = BOTAO_SOLTO;
+        }
+        break;
+    }
+
+    if (botao->estado == BOTAO_SOLTO) {
+        botao->borda_pendente = false;
+        return false;
+    }
+    return true;
+}
+
+static bool tratar_amostragem(repeating_timer_t *rt) {
+    bool ativo = false;
+    for (uint8_t i = 0; i < num_botoes; i++) {
+        if (atualizar(&botoes[i])) ativo = true;
+    }
+    amostrando = ativo;
+    return ativo;  // false desliga o timer até a próxima borda
+}
+
+static void tratar_borda(uint gpio, uint32_t eventos) {
+    uint32_t agora = time_us_32();
+    for (uint8_t i = 0; i < num_botoes; i++) {
+        if (botoes[i].gpio != gpio) continue;
+        if (!botoes[i].borda_pendente && botoes[i].estado == BOTAO_SOLTO) {
+            botoes[i].borda_us = agora;
+            botoes[i].borda_pendente = true;
+        }
+    }
+    // Mesma prioridade do alarme: não há corrida com tratar_amostragem
+    if (!amostrando) {
+        amostrando = true;
+        add_repeating_timer_ms(-BOTOES_PERIODO_MS, tratar_amostragem, NULL, &timer_amostragem);
+    }
+}
+
+// --- Funções Públicas ---
+
+void botoes_init(const uint8_t *pinos, uint8_t quantidade, botoes_callback_t ao_pressionar) {
+    if (quantidade > BOTOES_MAX) quantidade = BOTOES_MAX;
+    num_botoes = quantidade;
+    callback = ao_pressionar;
+    for (uint8_t i = 0; i < quantidade; i++) {
+        botoes[i] = (botao_t){ .gpio = pinos[i], .estado = BOTAO_SOLTO };
+        gpio_init(pinos[i]);
+        gpio_set_dir(pinos[i], GPIO_IN);
+        gpio_pull_up(pinos[i]);
+        gpio_set_irq_enabled_with_callback(pinos[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, &tratar_borda);
+    }
+}
+
+bool botoes_proximo_evento(evento_botao_t *evento) {
+    if (cabeca == cauda) return false;
+    uint32_t irqs = save_and_disable_interrupts();
+    *evento = fila[cabeca];
+    cabeca = (cabeca + 1) % BOTOES_FILA_TAM;
+    restore_interrupts(irqs);
+    return true;
+}
+
+uint32_t botoes_eventos_perdidos(void) {
+    return perdidos;
+}
@@ -0,0 +1,36 @@
+#ifndef BOTOES_H
+#define BOTOES_H
+
+#include "pico/stdlib.h"
+
+/* ---------- Botões com debounce por timer ----------
+ * A interrupção do GPIO só anota o instante da primeira borda e liga a
+ * amostragem; um timer lê os pinos a cada BOTOES_PERIODO_MS e só aceita
+ * um novo nível depois de BOTOES_AMOSTRAS_ESTAVEIS leituras iguais. Cada
+ * pressão confirmada vira um evento na fila, com o instante da borda, e o
+ * timer se desliga sozinho quando todos os botões estão soltos e estáveis. */
+
+#define BOTOES_MAX               4
+#define BOTOES_FILA_TAM          8
+#define BOTOES_PERIODO_MS        5
+#define BOTOES_AMOSTRAS_ESTAVEIS 4   // 4 x 5 ms = 20 ms de nível estável
+
+/* ---------- Evento de botão ---------- */
+typedef struct {
+    uint8_t gpio;
+    uint32_t instante_us;        // Primeira borda de descida (para medir a latência)
+} evento_botao_t;
+
+// Chamado (em interrupção) a cada pressão confirmada, ex.: energia_acordar
+typedef void (*botoes_callback_t)(void);
+
+// Configura os pinos (entrada com pull-up, ativo em nível baixo) e as interrupções
+void botoes_init(const uint8_t *pinos, uint8_t quantidade, botoes_callback_t ao_pressionar);
+
+// Retira o evento mais antigo da fila; false se ela estiver vazia
+bool botoes_proximo_evento(evento_botao_t *evento);
+
+// Pressões descartadas por fila cheia
+uint32_t botoes_eventos_perdidos(void);
+
+#endif // BOTOES_H
@@ -0,0 +1,68 @@
+#include "captura_adc.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+static uint16_t blocos[2][CAPTURA_ADC_AMOSTRAS];
+static int canais[2];
+static volatile uint32_t sequencia = 0;        // Blocos completos desde o início
+static volatile uint8_t ultimo = 0;            // Buffer do último bloco completo
+
+// --- Funções Internas ---
+
+// Fim de um bloco: o outro canal já começou (encadeamento); este volta ao início
+// do seu buffer sem disparar, esperando a vez dele
+static void tratar_irq_dma(void) {
+    for (uint8_t i = 0; i < 2; i++) {
+        if (!dma_channel_get_irq1_status(canais[i])) continue;
+        dma_channel_acknowledge_irq1(canais[i]);
+        dma_channel_set_write_addr(canais[i], blocos[i], false);
+        ultimo = i;
+        sequencia++;
+    }
+}
+
+static void configurar_canal(uint8_t i) {
+    dma_channel_config cfg = dma_channel_get_default_config(canais[i]);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    channel_config_set_chain_to(&cfg, canais[1 - i]);
+    dma_channel_configure(canais[i], &cfg, blocos[i], &adc_hw->fifo, CAPTURA_ADC_AMOSTRAS, false);
+    dma_channel_set_irq1_enabled(canais[i], true);
+}
+
+// --- Funções Públicas ---
+
+void captura_adc_init(void) {
+    adc_init();
+    adc_gpio_init(CAPTURA_ADC_PINO);
+    adc_select_input(CAPTURA_ADC_PINO - 26);
+    adc_fifo_setup(true, true, 1, false, false);   // FIFO com DREQ a cada amostra, 12 bits sem deslocamento
+    adc_set_clkdiv(48000000.0f / CAPTURA_ADC_TAXA_HZ - 1); // Cada conversão leva (1 + div) ciclos de 48 MHz
+
+    canais[0] = dma_claim_unused_channel(true);
+    canais[1] = dma_claim_unused_channel(true);
+    configurar_canal(0);
+    configurar_canal(1);
+    // DMA_IRQ_1: o DMA_IRQ_0 fica livre para quem precisar de um exclusivo
+    irq_add_shared_handler(DMA_IRQ_1, tratar_irq_dma, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    dma_channel_start(canais[0]);
+    adc_run(true);
+}
+
+uint32_t captura_adc_ultimo_bloco(const uint16_t **amostras) {
+    uint32_t irqs = save_and_disable_interrupts();
+    uint32_t numero = sequencia;
+    *amostras = blocos[ultimo];
+    restore_interrupts(irqs);
+    return numero;
+}
+
+uint32_t captura_adc_sequencia(void) {
+    return sequencia;
+}
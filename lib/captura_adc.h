@@ -0,0 +1,27 @@
+#ifndef CAPTURA_ADC_H
+#define CAPTURA_ADC_H
+
+#include "pico/stdlib.h"
+#include "cintilacao.h"
+
+/* ---------- Captura contínua do fotodiodo pelo ADC ----------
+ * O ADC converte sem parar a CAPTURA_ADC_TAXA_HZ e dois canais de DMA
+ * encadeados enchem dois buffers alternadamente (ping-pong): enquanto um
+ * bloco é analisado o DMA escreve no outro. O ADC usa o clk_adc (48 MHz da
+ * PLL da USB), então a taxa não muda quando o modo de baixo consumo reduz o
+ * clk_sys. */
+
+#define CAPTURA_ADC_PINO      28                       // GPIO do fotodiodo (ADC2); 26-28 são analógicos
+#define CAPTURA_ADC_TAXA_HZ   20000                    // Amostras por segundo
+#define CAPTURA_ADC_AMOSTRAS  CINTILACAO_MAX_AMOSTRAS  // Por bloco: 102,4 ms a 20 kHz
+
+// Configura o ADC e os dois canais de DMA e inicia a captura
+void captura_adc_init(void);
+
+// Último bloco completo em *amostras; retorna o número dele (0 = nenhum ainda).
+// O bloco só é sobrescrito depois que o próximo terminar: compare o número com
+// captura_adc_sequencia() ao fim da leitura para saber se ela foi íntegra.
+uint32_t captura_adc_ultimo_bloco(const uint16_t **amostras);
+uint32_t captura_adc_sequencia(void);
+
+#endif // CAPTURA_ADC_H
@@ -0,0 +1,91 @@
+#include "cintilacao.h"
+#include <math.h>
+
+#define MAX_DECIMADAS (CINTILACAO_MAX_AMOSTRAS / CINTILACAO_DECIMACAO)
+#define COEF_BITS 14
+
+// Rede elétrica de 50/60 Hz, suas harmônicas e frequências comuns de dimmers PWM
+static const uint16_t candidatas[] = {
+    50, 60, 100, 120, 150, 180, 200, 240, 300, 360, 400, 480, 500, 600, 1000, 2000,
+};
+#define NUM_CANDIDATAS (sizeof(candidatas) / sizeof(candidatas[0]))
+
+static int32_t coeficientes[NUM_CANDIDATAS];   // 2 cos(2 pi f / fs) em Q14
+static uint32_t taxa_coeficientes = 0;         // Taxa (já decimada) dos coeficientes acima
+
+// --- Funções Internas ---
+
+// Os cossenos só são recalculados quando a taxa muda; o laço de análise é todo inteiro
+static void preparar_coeficientes(uint32_t taxa_decimada) {
+    if (taxa_decimada == taxa_coeficientes) return;
+    for (uint32_t k = 0; k < NUM_CANDIDATAS; k++) {
+        float w = 2.0f * 3.14159265f * candidatas[k] / (float)taxa_decimada;
+        coeficientes[k] = (int32_t)lroundf(2.0f * cosf(w) * (1 << COEF_BITS));
+    }
+    taxa_coeficientes = taxa_decimada;
+}
+
+// Energia do sinal (sem a média) na frequência do coeficiente
+static int64_t goertzel(const int16_t *x, uint32_t m, int32_t coef) {
+    int32_t s1 = 0, s2 = 0;
+    for (uint32_t i = 0; i < m; i++) {
+        int32_t s = x[i] + (int32_t)(((int64_t)coef * s1) >> COEF_BITS) - s2;
+        s2 = s1;
+        s1 = s;
+    }
+    int32_t c_s1 = (int32_t)(((int64_t)coef * s1) >> COEF_BITS);
+    return (int64_t)s1 * s1 + (int64_t)s2 * s2 - (int64_t)c_s1 * s2;
+}
+
+// --- Funções Públicas ---
+
+void cintilacao_analisar(const uint16_t *amostras, uint32_t n, uint32_t taxa_hz, cintilacao_resultado_t *r) {
+    *r = (cintilacao_resultado_t){ 0 };
+    if (n > CINTILACAO_MAX_AMOSTRAS) n = CINTILACAO_MAX_AMOSTRAS;
+    uint32_t m = n / CINTILACAO_DECIMACAO;
+    if (m < 16 || taxa_hz == 0) return;
+
+    // 1. Percentual e índice sobre as amostras brutas (a média de 4 arredondaria picos e bordas)
+    uint32_t total = 0;
+    uint16_t minimo = UINT16_MAX, maximo = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        uint16_t v = amostras[i] & 0x0FFF;
+        total += v;
+        if (v < minimo) minimo = v;
+        if (v > maximo) maximo = v;
+    }
+    uint32_t media_q4 = (total << 4) / n;          // Média com 4 bits de fração
+    r->media = media_q4 >> 4;
+    if (maximo + minimo == 0) return;
+    r->percentual_x10 = (uint32_t)(maximo - minimo) * 1000u / (maximo + minimo);
+
+    // Índice: área acima da média sobre a área total (as duas em relação ao zero)
+    uint32_t acima_q4 = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t v_q4 = (uint32_t)(amostras[i] & 0x0FFF) << 4;
+        if (v_q4 > media_q4) acima_q4 += v_q4 - media_q4;
+    }
+    r->indice_x1000 = (uint32_t)((uint64_t)acima_q4 * 1000u / ((uint64_t)total << 4));
+
+    // 2. Decimação para o Goertzel: soma de 4 amostras menos 4 × a média
+    int16_t x[MAX_DECIMADAS];
+    for (uint32_t i = 0; i < m; i++) {
+        const uint16_t *a = &amostras[i * CINTILACAO_DECIMACAO];
+        int32_t soma = 0;
+        for (uint32_t k = 0; k < CINTILACAO_DECIMACAO; k++) soma += a[k] & 0x0FFF;
+        x[i] = (int16_t)(soma - (int32_t)(media_q4 * CINTILACAO_DECIMACAO >> 4));
+    }
+
+    // 3. Frequência dominante entre as candidatas abaixo de Nyquist
+    if (r->percentual_x10 < CINTILACAO_MIN_PERCENTUAL_X10) return;
+    uint32_t taxa_decimada = taxa_hz / CINTILACAO_DECIMACAO;
+    preparar_coeficientes(taxa_decimada);
+    int64_t melhor = 0;
+    for (uint32_t k = 0; k < NUM_CANDIDATAS && candidatas[k] * 2u < taxa_decimada; k++) {
+        int64_t energia = goertzel(x, m, coeficientes[k]);
+        if (energia > melhor) {
+            melhor = energia;
+            r->frequencia_hz = candidatas[k];
+        }
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef CINTILACAO_H
+#define CINTILACAO_H
+
+/* ---------- Análise de cintilação (flicker) da luz ----------
+ * C puro em ponto fixo, sem o Pico SDK: recebe um bloco de amostras do ADC
+ * (12 bits) e calcula as métricas da IES sobre o bloco inteiro mais a
+ * frequência dominante por Goertzel em frequências candidatas. Compilado
+ * também no computador por tools/cintilacao_sintetica. */
+
+#include <stdint.h>
+
+#define CINTILACAO_DECIMACAO 4            // Soma de 4 amostras antes do Goertzel (filtro anti-alias simples)
+#define CINTILACAO_MAX_AMOSTRAS 2048      // Amostras por bloco (antes da decimação)
+#define CINTILACAO_MIN_PERCENTUAL_X10 10  // Abaixo de 1% não há cintilação: frequência 0
+
+typedef struct {
+    uint16_t percentual_x10;     // Percentual de cintilação 100 × (max - min) / (max + min), × 10
+    uint16_t indice_x1000;       // Índice de cintilação (área acima da média / área total), × 1000
+    uint16_t frequencia_hz;      // Candidata com mais energia (0 se não há cintilação)
+    uint16_t media;              // Nível médio em contagens do ADC (0-4095)
+} cintilacao_resultado_t;
+
+// Analisa n amostras (até CINTILACAO_MAX_AMOSTRAS) capturadas a taxa_hz
+void cintilacao_analisar(const uint16_t *amostras, uint32_t n, uint32_t taxa_hz, cintilacao_resultado_t *r);
+
+#endif // CINTILACAO_H
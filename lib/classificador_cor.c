@@ -0,0 +1,133 @@
+#include "classificador_cor.h"
+#include <string.h>
+
+const CorRGB PALETA_CORES[NUM_CORES_PALETA] = {
+    {"Branco",  255, 255, 255},
+    {"Prata",   192, 192, 192},
+    {"Cinza",    40,  35,  35},
+    {"Violeta", 130,   0, 130},
+    {"Azul",      0,   0, 200},
+    {"Marrom",   30,  10,  10},
+    {"Verde",     0, 150,   0},
+    {"Ouro",    218, 165,  32},
+    {"Laranja", 255,  65,   0},
+    {"Amarelo", 255, 140,   0},
+    {"Vermelho",190,   0,   0},
+    {"---",       0,   0,   0}
+};
+
+// Identifica a cor com base nos valores RGB e intensidade
+const char* identificar_cor(uint16_t r, uint16_t g, uint16_t b, uint16_t c, const limiares_cor_t *lim) {
+    if (c < lim->c_escuro) return "---";            // Ambiente escuro
+    
+    float total = r + g + b;
+    if (total == 0) return "---";                    // Sem dados válidos
+    
+    // Normalização dos componentes
+    float rn = r / total;
+    float gn = g / total;
+    float bn = b / total;
+    float rg_ratio = (g > 0) ? (float)r / (float)g : 99.0f;
+    
+    // Lógica de identificação de cores
+    if (rg_ratio > lim->rg_vermelho) {
+        return (bn < lim->bn_laranja) ? "Laranja" : "Vermelho";
+    }
+    if (rg_ratio > lim->rg_amarelo && rg_ratio <= lim->rg_vermelho) {
+        return (c > lim->c_ouro) ? "Ouro" : "Amarelo";
+    }
+    if (gn > rn && gn > bn) return "Verde";
+    if (bn > rn && bn > gn) return "Azul";
+    if (bn > lim->bn_violeta && rn > lim->rn_violeta && gn < lim->gn_violeta) return "Violeta";
+    if (rg_ratio > lim->rg_marrom && c < lim->c_marrom && c > lim->c_escuro) return "Marrom";
+    
+    // Detecção de cores neutras (tons de cinza)
+    bool is_balanced = (rn > gn - lim->tol_neutro && rn < gn + lim->tol_neutro) && 
+                       (gn > bn - lim->tol_neutro && gn < bn + lim->tol_neutro);
+    if (is_balanced) {
+        if (c > lim->c_branco) return "Branco";
+        if (c > lim->c_prata) return "Prata";
+        if (c > lim->c_cinza) return "Cinza";
+    }
+    
+    return "Desconhecido";
+}
+
+// A ordem das regras é a de identificar_cor(), aplicada de trás para frente:
+// cada regra que vale sobrescreve as de menor prioridade. As contas em float
+// são as mesmas (e na mesma ordem), então o resultado é idêntico.
+void identificar_cor_lote(const uint16_t *r, const uint16_t *g, const uint16_t *b, const uint16_t *c,
+                          uint8_t *ids, uint32_t n, const limiares_cor_t *lim) {
+    const limiares_cor_t l = *lim; // Cópia local: o compilador não precisa supor aliasing com ids[]
+    // Com G = 0 identificar_cor() usa R/G = 99: essas comparações não dependem da amostra
+    const bool sem_g_vermelho = 99.0f > l.rg_vermelho;
+    const bool sem_g_amarelo = 99.0f > l.rg_amarelo;
+    const bool sem_g_marrom = 99.0f > l.rg_marrom;
+    for (uint32_t i = 0; i < n; i++) {
+        float ri = r[i], gi = g[i], bi = b[i], ci = c[i];
+        float total = ri + gi + bi;
+        float rn = ri / total;                         // NaN se total == 0 (descartado abaixo)
+        float gn = gi / total;
+        float bn = bi / total;
+        float rg_ratio = ri / gi;                      // Inf/NaN se G == 0 (trocado pelas constantes acima)
+        bool com_g = g[i] > 0;
+
+        // Toda comparação é feita sempre: uma comparação de float dentro de um ?:
+        // pode sinalizar exceção e impede o compilador de remover o desvio
+        bool balanced = (rn > gn - l.tol_neutro) & (rn < gn + l.tol_neutro) &
+                        (gn > bn - l.tol_neutro) & (gn < bn + l.tol_neutro);
+        bool cinza = balanced & (ci > l.c_cinza);
+        bool prata = balanced & (ci > l.c_prata);
+        bool branco = balanced & (ci > l.c_branco);
+        bool marrom = ((com_g & (rg_ratio > l.rg_marrom)) | (!com_g & sem_g_marrom)) & (ci < l.c_marrom) & (ci > l.c_escuro);
+        bool violeta = (bn > l.bn_violeta) & (rn > l.rn_violeta) & (gn < l.gn_violeta);
+        bool azul = (bn > rn) & (bn > gn);
+        bool verde = (gn > rn) & (gn > bn);
+        bool amarelo = (com_g & (rg_ratio > l.rg_amarelo)) | (!com_g & sem_g_amarelo);
+        bool ouro = ci > l.c_ouro;
+        bool vermelho = (com_g & (rg_ratio > l.rg_vermelho)) | (!com_g & sem_g_vermelho);
+        bool laranja = bn < l.bn_laranja;
+        bool escuro = (ci < l.c_escuro) | (total == 0);
+
+        int id = COR_ID_DESCONHECIDO;
+        id = cinza ? COR_ID_CINZA : id;
+        id = prata ? COR_ID_PRATA : id;
+        id = branco ? COR_ID_BRANCO : id;
+        id = marrom ? COR_ID_MARROM : id;
+        id = violeta ? COR_ID_VIOLETA : id;
+        id = azul ? COR_ID_AZUL : id;
+        id = verde ? COR_ID_VERDE : id;
+        id = amarelo ? (ouro ? COR_ID_OURO : COR_ID_AMARELO) : id;
+        id = vermelho ? (laranja ? COR_ID_LARANJA : COR_ID_VERMELHO) : id;
+        id = escuro ? COR_ID_ESCURO : id;
+        ids[i] = (uint8_t)id;
+    }
+}
+
+const char *nome_cor_id(uint8_t id) {
+    return id < NUM_CORES_PALETA ? PALETA_CORES[id].nome : "Desconhecido";
+}
+
+uint32_t obter_grb_pelo_nome(const char *nome_da_cor, uint16_t lux, const int32_t brilho_lux[3]) {
+    const int32_t *faixa = brilho_lux; // Padrão: 50, 300, 1000
+    int DIVISOR_DE_BRILHO;
+    if (lux <= faixa[0]) DIVISOR_DE_BRILHO = 1;
+    else if (lux <= faixa[1]) DIVISOR_DE_BRILHO = 3 + ((lux - (faixa[0] + 1)) * 3) / (faixa[1] - faixa[0] - 1);
+    else if (lux <= faixa[2]) DIVISOR_DE_BRILHO = 7 + ((lux - (faixa[1] + 1)) * 2) / (faixa[2] - faixa[1] - 1);
+    else DIVISOR_DE_BRILHO = 10;
+    for (int i = 0; i < NUM_CORES_PALETA; i++) {
+        if (strcmp(nome_da_cor, PALETA_CORES[i].nome) == 0) {
+            uint8_t r = PALETA_CORES[i].r / DIVISOR_DE_BRILHO;
+            uint8_t g = PALETA_CORES[i].g / DIVISOR_DE_BRILHO;
+            uint8_t b = PALETA_CORES[i].b / DIVISOR_DE_BRILHO;
+            return GRB(r, g, b);
+        }
+    }
+    return 0; // COR_OFF
+}
+
+void classificador_processar(const amostra_sensores_t *a, const config_classificador_t *cfg, decisao_cor_t *d) {
+    d->cor = identificar_cor(a->r, a->g, a->b, a->c, &cfg->cor);
+    d->grb = obter_grb_pelo_nome(d->cor, a->lux, cfg->brilho_lux);
+    d->lux_fora_do_limite = a->lux < cfg->lux_min || a->lux > cfg->lux_max;
+}
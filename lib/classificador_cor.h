@@ -0,0 +1,103 @@
+#ifndef CLASSIFICADOR_COR_H
+#define CLASSIFICADOR_COR_H
+
+/* ---------- Classificação de cor e cor da matriz ----------
+ * C puro, sem o Pico SDK: o mesmo arquivo é compilado no firmware e na
+ * ferramenta de replay (tools/replay), então uma amostra gravada produz
+ * no computador exatamente a decisão que produziu na placa. */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ---------- Utilidades de cor ---------- */
+#define GRB(r,g,b)   ( ((uint32_t)(g) << 16) | ((uint32_t)(r) << 8) | (b) )  // Converte RGB para formato GRB do WS2812
+
+/* ---------- Estrutura de cor RGB ---------- */
+typedef struct {
+    const char* nome;
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} CorRGB;
+
+/* ---------- Paleta de cores ---------- */
+// Índices da PALETA_CORES, usados pela classificação em lote
+typedef enum {
+    COR_ID_BRANCO = 0,
+    COR_ID_PRATA,
+    COR_ID_CINZA,
+    COR_ID_VIOLETA,
+    COR_ID_AZUL,
+    COR_ID_MARROM,
+    COR_ID_VERDE,
+    COR_ID_OURO,
+    COR_ID_LARANJA,
+    COR_ID_AMARELO,
+    COR_ID_VERMELHO,
+    COR_ID_ESCURO,               // "---"
+    NUM_CORES_PALETA,
+    COR_ID_DESCONHECIDO = NUM_CORES_PALETA,  // Fora da paleta
+} cor_id_t;
+
+extern const CorRGB PALETA_CORES[NUM_CORES_PALETA];
+
+// --- Limiares do classificador de cor (ajustáveis em tempo de execução) ---
+typedef struct {
+    float c_escuro;        // Abaixo disso: ambiente escuro ("---")
+    float rg_vermelho;     // Razão R/G acima disso: vermelho/laranja
+    float rg_amarelo;      // Razão R/G entre este e rg_vermelho: amarelo/ouro
+    float bn_laranja;      // Azul normalizado abaixo disso: laranja
+    float c_ouro;          // Intensidade acima disso: ouro (senão amarelo)
+    float bn_violeta;      // Violeta: azul, vermelho e verde normalizados
+    float rn_violeta;
+    float gn_violeta;
+    float rg_marrom;       // Marrom: razão R/G e faixa de intensidade
+    float c_marrom;
+    float tol_neutro;      // Diferença máxima entre canais de um tom de cinza
+    float c_branco;        // Intensidades de branco, prata e cinza
+    float c_prata;
+    float c_cinza;
+} limiares_cor_t;
+
+#define LIMIARES_COR_PADRAO { \
+    .c_escuro = 30.0f, .rg_vermelho = 1.15f, .rg_amarelo = 0.85f, .bn_laranja = 0.23f, \
+    .c_ouro = 400.0f, .bn_violeta = 0.4f, .rn_violeta = 0.3f, .gn_violeta = 0.3f, \
+    .rg_marrom = 1.2f, .c_marrom = 80.0f, .tol_neutro = 0.15f, \
+    .c_branco = 600.0f, .c_prata = 300.0f, .c_cinza = 80.0f }
+
+/* ---------- Entrada e saída do pipeline ---------- */
+typedef struct {
+    uint16_t r, g, b, c;         // Canais brutos do GY-33
+    uint16_t lux;                // BH1750
+} amostra_sensores_t;
+
+typedef struct {
+    limiares_cor_t cor;
+    int32_t lux_min, lux_max;    // Limites do alerta de luminosidade
+    int32_t brilho_lux[3];       // Faixas de brilho da matriz
+} config_classificador_t;
+
+typedef struct {
+    const char *cor;             // Nome da PALETA_CORES (ou "Desconhecido")
+    uint32_t grb;                // Cor enviada à matriz
+    bool lux_fora_do_limite;     // Dispara o alerta nas telas de luz
+} decisao_cor_t;
+
+// Analisa os valores RGB e retorna o nome da cor mais provável.
+const char* identificar_cor(uint16_t r, uint16_t g, uint16_t b, uint16_t c, const limiares_cor_t *lim);
+
+// Mesma decisão de identificar_cor() para n amostras em vetores separados (SoA).
+// Sem desvios no laço, para que o compilador do computador possa vetorizá-lo.
+void identificar_cor_lote(const uint16_t *r, const uint16_t *g, const uint16_t *b, const uint16_t *c,
+                          uint8_t *ids, uint32_t n, const limiares_cor_t *lim);
+
+// Nome de um cor_id_t (o mesmo retornado por identificar_cor)
+const char *nome_cor_id(uint8_t id);
+
+// Cor da paleta com o brilho reduzido conforme a luz ambiente (faixas crescentes em lux)
+uint32_t obter_grb_pelo_nome(const char *nome_da_cor, uint16_t lux, const int32_t brilho_lux[3]);
+
+// Todas as decisões tomadas a partir de uma amostra, na ordem do laço principal
+void classificador_processar(const amostra_sensores_t *a, const config_classificador_t *cfg, decisao_cor_t *d);
+
+#endif // CLASSIFICADOR_COR_H
@@ -0,0 +1,107 @@
+#include "console.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parametros.h"
+#include "trace_amostras.h"
+#include "espelho.h"
+
+static char linha[CONSOLE_TAM_LINHA];
+static uint8_t tamanho = 0;
+static bool descartando = false;      // Linha longa demais: ignora até o fim dela
+
+// --- Funções Internas ---
+
+static void imprimir_parametro(const parametro_t *p) {
+    if (p->tipo == PARAMETRO_INT) {
+        printf("%s = %ld\n", p->nome, (long)parametros_obter(p));
+    } else {
+        printf("%s = %g\n", p->nome, parametros_obter(p));
+    }
+}
+
+static void listar(void) {
+    size_t n;
+    const parametro_t *tabela = parametros_tabela(&n);
+    for (size_t i = 0; i < n; i++) {
+        const parametro_t *p = &tabela[i];
+        printf("%-18s %10g  [%g..%g]  %s\n", p->nome, parametros_obter(p), p->minimo, p->maximo, p->descricao);
+    }
+}
+
+static void executar(char *comando) {
+    char *cmd = strtok(comando, " \t");
+    char *nome = strtok(NULL, " \t");
+    char *valor = strtok(NULL, " \t");
+    if (cmd == NULL) return;
+
+    if (strcmp(cmd, "help") == 0) {
+        printf("Comandos: list | get <nome> | set <nome> <valor> | save | defaults | trace on|off | espelho on|off\n");
+    } else if (strcmp(cmd, "list") == 0) {
+        listar();
+    } else if (strcmp(cmd, "get") == 0 || strcmp(cmd, "set") == 0) {
+        const parametro_t *p = nome ? parametros_buscar(nome) : NULL;
+        if (p == NULL) {
+            printf("erro: parametro desconhecido (use list)\n");
+            return;
+        }
+        if (cmd[0] == 's') {
+            char *fim;
+            float v = valor ? strtof(valor, &fim) : 0;
+            if (valor == NULL || *fim != '\0') {
+                printf("erro: valor invalido\n");
+                return;
+            }
+            const char *erro = parametros_definir(p, v);
+            if (erro) {
+                printf("erro: %s\n", erro);
+                return;
+            }
+        }
+        imprimir_parametro(p);
+    } else if (strcmp(cmd, "save") == 0) {
+        printf(parametros_salvar() ? "ok: gravado na flash\n" : "erro: falha ao gravar na flash\n");
+    } else if (strcmp(cmd, "defaults") == 0) {
+        parametros_restaurar_padrao();
+        printf("ok: padroes restaurados (save para gravar)\n");
+    } else if (strcmp(cmd, "trace") == 0) {
+        if (nome == NULL || (strcmp(nome, "on") != 0 && strcmp(nome, "off") != 0)) {
+            printf("trace %s\n", trace_amostras_ligado() ? "on" : "off");
+            return;
+        }
+        trace_amostras_ligar(nome[1] == 'n');
+    } else if (strcmp(cmd, "espelho") == 0) {
+        if (nome == NULL || (strcmp(nome, "on") != 0 && strcmp(nome, "off") != 0)) {
+            espelho_estatisticas_t e = espelho_obter_estatisticas();
+            printf("espelho %s: %lu trechos, %lu bytes alterados, %lu comprimidos, %lu quadros da matriz\n",
+                   espelho_ligado() ? "on" : "off", (unsigned long)e.trechos, (unsigned long)e.bytes_alterados,
+                   (unsigned long)e.bytes_enviados, (unsigned long)e.quadros_matriz);
+            return;
+        }
+        espelho_ligar(nome[1] == 'n');
+    } else {
+        printf("erro: comando desconhecido (use help)\n");
+    }
+}
+
+// --- Funções Públicas ---
+
+void console_atender(void) {
+    int ch;
+    while ((ch = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        if (ch == '\r' || ch == '\n') {
+            if (!descartando && tamanho > 0) {
+                linha[tamanho] = '\0';
+                executar(linha);
+            } else if (descartando) {
+                printf("erro: linha longa demais\n");
+            }
+            tamanho = 0;
+            descartando = false;
+        } else if (tamanho < CONSOLE_TAM_LINHA - 1) {
+            linha[tamanho++] = (char)ch;
+        } else {
+            descartando = true;
+        }
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include "pico/stdlib.h"
+
+#define CONSOLE_TAM_LINHA 64
+
+/* ---------- Console de configuração pela USB ----------
+ * Comandos, um por linha:
+ *   help | list | get <nome> | set <nome> <valor> | save | defaults
+ *   trace [on|off]  (amostras brutas para tools/replay)
+ *   espelho [on|off]  (display e matriz para tools/espelho.py) */
+
+// Lê o que já chegou na serial sem esperar e executa cada linha completa
+void console_atender(void);
+
+#endif // CONSOLE_H
@@ -0,0 +1,78 @@
+#include "energia.h"
+#include "hardware/clocks.h"
+
+static bool modo_baixo_consumo = false;
+static volatile bool despertar = false;
+static energia_estatisticas_t estatisticas;
+static uint64_t inicio_ativo_us;
+static energia_callback_clock_t ao_mudar_clock = NULL;
+
+// --- Funções Internas ---
+
+// Reconfigura o clk_sys como PLL_SYS dividida; o relógio do timer vem do clk_ref e não é afetado
+static void definir_clk_sys(uint32_t divisor) {
+    uint32_t frequencia = SYS_CLK_KHZ * 1000 / divisor;
+    if (ao_mudar_clock) ao_mudar_clock(true, frequencia);
+    clock_configure(clk_sys,
+                    CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                    CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS,
+                    SYS_CLK_KHZ * 1000,
+                    frequencia);
+    if (ao_mudar_clock) ao_mudar_clock(false, frequencia);
+}
+
+// --- Funções Públicas ---
+
+void energia_init(void) {
+    clock_configure(clk_peri, 0,
+                    CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB,
+                    USB_CLK_KHZ * 1000,
+                    USB_CLK_KHZ * 1000);
+    inicio_ativo_us = time_us_64();
+}
+
+void energia_registrar_mudanca_clock(energia_callback_clock_t callback) {
+    ao_mudar_clock = callback;
+}
+
+void energia_definir_modo_baixo_consumo(bool ativo) {
+    modo_baixo_consumo = ativo;
+}
+
+bool energia_modo_baixo_consumo(void) {
+    return modo_baixo_consumo;
+}
+
+void energia_ocioso_ms(uint32_t duracao_ms) {
+    uint64_t inicio = time_us_64();
+    estatisticas.tempo_ativo_us += inicio - inicio_ativo_us;
+    absolute_time_t fim = make_timeout_time_ms(duracao_ms);
+
+    if (modo_baixo_consumo) definir_clk_sys(ENERGIA_DIVISOR_OCIOSO);
+    // Qualquer interrupção (alarme do timer, botões) tira o núcleo do WFE
+    while (!despertar && !best_effort_wfe_or_timeout(fim)) {
+    }
+    if (modo_baixo_consumo) definir_clk_sys(1);
+
+    // Um pedido feito durante o tempo ativo também encerra a espera (imediatamente)
+    if (despertar) {
+        despertar = false;
+        estatisticas.despertares_botao++;
+    }
+    inicio_ativo_us = time_us_64();
+    estatisticas.tempo_ocioso_us += inicio_ativo_us - inicio;
+}
+
+void energia_acordar(void) {
+    despertar = true;
+}
+
+void energia_registrar_amostra(void) {
+    estatisticas.amostras++;
+}
+
+energia_estatisticas_t energia_obter_estatisticas(void) {
+    energia_estatisticas_t copia = estatisticas;
+    copia.tempo_ativo_us += time_us_64() - inicio_ativo_us;
+    return copia;
+}
@@ -0,0 +1,43 @@
+#ifndef ENERGIA_H
+#define ENERGIA_H
+
+#include "pico/stdlib.h"
+
+// Divisor aplicado ao clk_sys enquanto a placa espera a próxima amostra (125 MHz / 8)
+#define ENERGIA_DIVISOR_OCIOSO 8
+
+/* ---------- Contadores de ciclo de trabalho ---------- */
+typedef struct {
+    uint64_t tempo_ativo_us;     // Tempo com clk_sys em velocidade plena
+    uint64_t tempo_ocioso_us;    // Tempo dentro de energia_ocioso_ms()
+    uint32_t amostras;           // Amostras registradas com energia_registrar_amostra()
+    uint32_t despertares_botao;  // Esperas encerradas antes do prazo por energia_acordar()
+} energia_estatisticas_t;
+
+// Avisado antes (antes = true) e depois de cada mudança do clk_sys, com a nova frequência
+typedef void (*energia_callback_clock_t)(bool antes, uint32_t clk_sys_hz);
+
+// Move clk_peri para a PLL USB (48 MHz) para que UART e I2C não dependam do clk_sys.
+// Deve ser chamada antes de stdio_init_all() e da inicialização dos barramentos.
+void energia_init(void);
+
+// Registra quem depende do clk_sys (ex.: PIO da matriz de LEDs)
+void energia_registrar_mudanca_clock(energia_callback_clock_t callback);
+
+// Liga ou desliga o modo de baixo consumo (com ele desligado a espera é um sleep_ms comum)
+void energia_definir_modo_baixo_consumo(bool ativo);
+bool energia_modo_baixo_consumo(void);
+
+// Espera `duracao_ms` com o clk_sys reduzido; retorna antes se energia_acordar() for chamada
+void energia_ocioso_ms(uint32_t duracao_ms);
+
+// Encerra a espera atual (seguro em interrupções, ex.: botões)
+void energia_acordar(void);
+
+// Conta uma amostra completa para o cálculo de energia por amostra
+void energia_registrar_amostra(void);
+
+// Copia os contadores (o tempo ativo em curso é incluído até o instante da chamada)
+energia_estatisticas_t energia_obter_estatisticas(void);
+
+#endif // ENERGIA_H
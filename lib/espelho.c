@@ -0,0 +1,119 @@
+#include "espelho.h"
+#include <stdio.h>
+#include <string.h>
+#include "matriz_compositor.h"
+
+#define MAX_BYTES_PAGINA 128
+#define MAX_PACKBITS (MAX_BYTES_PAGINA + MAX_BYTES_PAGINA / 128 + 1)
+
+static ssd1306_t *display = NULL;
+static bool ligado = false;
+static bool matriz_pendente = false;       // Reenvia a matriz mesmo sem mudança (ao ligar)
+static uint32_t quadro_anterior[NUM_PIXELS];
+static espelho_estatisticas_t estatisticas;
+static char linha[16 + 2 * MAX_PACKBITS];  // Maior linha: @d de uma página inteira sem repetições
+
+// --- Funções Internas ---
+
+static char *hex_byte(char *p, uint8_t v) {
+    static const char digitos[] = "0123456789ABCDEF";
+    *p++ = digitos[v >> 4];
+    *p++ = digitos[v & 0x0F];
+    return p;
+}
+
+static void enviar_trecho(uint8_t pagina, uint8_t col_inicio, uint8_t col_fim) {
+    uint8_t comprimido[MAX_PACKBITS];
+    uint16_t n = col_fim - col_inicio + 1;
+    uint16_t tamanho = espelho_packbits(&display->ram_buffer[pagina * display->width + col_inicio + 1], n, comprimido);
+
+    char *p = linha + sprintf(linha, "@d %u %u %u ", pagina, col_inicio, n);
+    for (uint16_t i = 0; i < tamanho; i++) p = hex_byte(p, comprimido[i]);
+    *p++ = '\n';
+    fwrite(linha, 1, p - linha, stdout);
+
+    estatisticas.bytes_alterados += n;
+    estatisticas.bytes_enviados += tamanho;
+    estatisticas.trechos++;
+}
+
+static void enviar_matriz(void) {
+    uint32_t grb[NUM_PIXELS];
+    compositor_copiar_quadro(grb);
+    if (!matriz_pendente && memcmp(grb, quadro_anterior, sizeof(grb)) == 0) return;
+    matriz_pendente = false;
+    memcpy(quadro_anterior, grb, sizeof(grb));
+
+    // Ordem lógica (linha 0 em cima, coluna 0 à esquerda) para o visualizador não depender da montagem
+    char *p = linha + sprintf(linha, "@m");
+    for (int lin = 0; lin < NUM_LINHAS; lin++) {
+        for (int col = 0; col < NUM_COLUNAS; col++) {
+            uint32_t cor = grb[MATRIZ_INDICE_FISICO(lin, col)];
+            *p++ = ' ';
+            p = hex_byte(p, cor >> 16);
+            p = hex_byte(p, cor >> 8);
+            p = hex_byte(p, cor);
+        }
+    }
+    *p++ = '\n';
+    fwrite(linha, 1, p - linha, stdout);
+    estatisticas.quadros_matriz++;
+}
+
+// --- Funções Públicas ---
+
+void espelho_init(ssd1306_t *ssd) {
+    display = ssd;
+}
+
+void espelho_ligar(bool ligar) {
+    if (ligar && !ligado && display != NULL) {
+        printf("@espelho %d %u %u %d %d\n", ESPELHO_VERSAO, display->width, display->height, NUM_LINHAS, NUM_COLUNAS);
+        ssd1306_mark_all_dirty(display);
+        matriz_pendente = true;
+    }
+    ligado = ligar && display != NULL;
+}
+
+bool espelho_ligado(void) {
+    return ligado;
+}
+
+void espelho_atender(void) {
+    if (!ligado) return;
+    uint8_t inicio, fim;
+    for (uint8_t pagina = 0; pagina < display->pages; pagina++) {
+        if (ssd1306_take_dirty(display, pagina, &inicio, &fim)) enviar_trecho(pagina, inicio, fim);
+    }
+    enviar_matriz();
+}
+
+espelho_estatisticas_t espelho_obter_estatisticas(void) {
+    return estatisticas;
+}
+
+uint16_t espelho_packbits(const uint8_t *dados, uint16_t n, uint8_t *saida) {
+    uint16_t i = 0, o = 0;
+    while (i < n) {
+        // Repetição: 3 a 128 cópias do mesmo byte viram 2 bytes (pares ficam no literal,
+        // senão a alternância par/byte solto expandiria os dados)
+        uint16_t rep = 1;
+        while (i + rep < n && rep < 128 && dados[i + rep] == dados[i]) rep++;
+        if (rep >= 3) {
+            saida[o++] = (uint8_t)(1 - rep);           // -1..-127
+            saida[o++] = dados[i];
+            i += rep;
+            continue;
+        }
+        // Literal: até a próxima repetição de 3 ou mais
+        uint16_t inicio = i;
+        while (i < n && i - inicio < 128) {
+            if (i + 2 < n && dados[i] == dados[i + 1] && dados[i] == dados[i + 2]) break;
+            i++;
+        }
+        saida[o++] = (uint8_t)(i - inicio - 1);        // 0..127
+        memcpy(&saida[o], &dados[inicio], i - inicio);
+        o += i - inicio;
+    }
+    return o;
+}
@@ -0,0 +1,40 @@
+#ifndef ESPELHO_H
+#define ESPELHO_H
+
+#include "pico/stdlib.h"
+#include "ssd1306.h"
+
+/* ---------- Espelho do display e da matriz pela USB ----------
+ * Com o espelho ligado (comando "espelho on" do console) as alterações do
+ * buffer do SSD1306 e os quadros novos da matriz saem em linhas de texto,
+ * misturadas ao resto do log:
+ *   @espelho <versao> <largura> <altura> <linhas> <colunas>   cabeçalho
+ *   @d <pagina> <coluna> <bytes> <PackBits em hex>             trecho de uma página
+ *   @m <GRB em hex, 6 dígitos por LED, linha a linha>          quadro da matriz
+ * Só as colunas marcadas pelo rastreador do ssd1306 são enviadas; ao ligar,
+ * o buffer inteiro é marcado para o visualizador partir de uma cópia completa.
+ * O visualizador é tools/espelho.py. */
+
+#define ESPELHO_VERSAO 1
+#define ESPELHO_INTERVALO_MS 50  // Com o espelho ligado, esperas longas são fatiadas nisso (matriz a ~20 fps)
+
+typedef struct {
+    uint32_t bytes_alterados;    // Bytes do buffer do display enviados (antes da compressão)
+    uint32_t bytes_enviados;     // Bytes de PackBits depois da compressão
+    uint32_t trechos;            // Linhas @d
+    uint32_t quadros_matriz;     // Linhas @m
+} espelho_estatisticas_t;
+
+void espelho_init(ssd1306_t *ssd);
+void espelho_ligar(bool ligar);
+bool espelho_ligado(void);
+
+// Envia o que mudou desde a última chamada (nada se o espelho estiver desligado)
+void espelho_atender(void);
+
+espelho_estatisticas_t espelho_obter_estatisticas(void);
+
+// Comprime com PackBits; retorna o tamanho da saída (no máximo n + n / 128 + 1)
+uint16_t espelho_packbits(const uint8_t *dados, uint16_t n, uint8_t *saida);
+
+#endif // ESPELHO_H
@@ -2,15 +2,69 @@
 #define GY33_H
 
 #include "pico/stdlib.h"
-#include "hardware/i2c.h"
+#include "i2c_barramento.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// --- Definições do Sensor GY-33 ---
+#define GY33_I2C_ADDR 0x29          // Endereço I2C padrão do sensor
+#define GY33_I2C_BAUDRATE 400000    // O TCS34725 suporta fast-mode (400 kHz)
+
+// --- Registos do Sensor GY-33 ---
+#define ENABLE_REG 0x80             // Habilita o sensor e controla modos de operação
+#define ENABLE_PON_AEN 0x03         // Oscilador interno (PON) e ADC RGBC (AEN) ligados
+#define ENABLE_AIEN 0x10            // Interrupção RGBC: acende o AINT conforme o PERS_REG
+#define ATIME_REG 0x81              // Configura o tempo de integração do ADC
+#define PERS_REG 0x8C               // Persistência da interrupção (0 = todo ciclo acende o AINT)
+#define CONTROL_REG 0x8F            // Controla o ganho do sensor
+#define STATUS_REG 0x93             // Bits AVALID e AINT
+#define STATUS_AVALID 0x01          // Já houve uma integração completa (fica aceso)
+#define STATUS_AINT 0x10            // Interrupção RGBC pendente; apagado por LIMPAR_AINT
+#define LIMPAR_AINT 0xE6            // Comando de função especial que apaga o AINT
+#define CDATA_REG 0x94              // Registrador de dados de luz clara (Clear)
+#define RDATA_REG 0x96              // Registrador de dados do canal vermelho (Red)
+#define GDATA_REG 0x98              // Registrador de dados do canal verde (Green)
+#define BDATA_REG 0x9A              // Registrador de dados do canal azul (Blue)
+#define AUTO_INCREMENTO 0x20        // Bit do comando que avança o registrador a cada byte lido
 
 //Inicializa o sensor de cor GY-33 (TCS34725).
-void gy33_init(i2c_inst_t *i2c);
+void gy33_init(i2c_barramento_t *bar);
+
+//Desliga o oscilador e o ADC (bits PON/AEN) até o próximo gy33_power_up().
+void gy33_power_down(i2c_barramento_t *bar);
+
+//Religa o sensor; a primeira leitura válida sai após um tempo de integração.
+void gy33_power_up(i2c_barramento_t *bar);
+
+//Define o tempo de integração (ATIME: (256 - atime) x 2,4 ms) e o ganho (0-3 = 1x, 4x, 16x, 60x).
+void gy33_set_integration(i2c_barramento_t *bar, uint8_t atime, uint8_t gain);
+
+//Indica se já terminou uma integração desde o último gy33_power_up() (STATUS.AVALID).
+//false também se a leitura do STATUS falhar.
+bool gy33_integracao_pronta(i2c_barramento_t *bar);
+
+//Lê os valores de cor brutos do sensor. Retorna false se a transação I2C falhar.
+bool gy33_read_color(i2c_barramento_t *bar, uint16_t *r, uint16_t *g, uint16_t *b, uint16_t *c);
+
+// --- Leitura de cor em duas etapas ---
+// Enfileira a leitura e volta na hora; quem chamou pode enfileirar outras
+// transações (ex.: em outro barramento) antes de aguardar o resultado.
+typedef struct {
+    i2c_transacao_t transacao;
+    uint8_t reg;
+    uint8_t buffer[8];
+} gy33_leitura_t;
+
+//Enfileira a leitura de cor. `leitura` deve continuar válida até gy33_concluir_leitura_cor().
+bool gy33_iniciar_leitura_cor(i2c_barramento_t *bar, gy33_leitura_t *leitura);
 
-//Lê os valores de cor brutos do sensor.
-void gy33_read_color(i2c_inst_t *i2c, uint16_t *r, uint16_t *g, uint16_t *b, uint16_t *c);
+//Aguarda a leitura enfileirada e converte os valores (zeros e false se a transação falhar).
+bool gy33_concluir_leitura_cor(gy33_leitura_t *leitura, uint16_t *r, uint16_t *g, uint16_t *b, uint16_t *c);
 
-//Analisa os valores RGB e retorna o nome da cor mais provável.
-const char* identificar_cor(uint16_t r, uint16_t g, uint16_t b, uint16_t c);
+#ifdef __cplusplus
+}
+#endif
 
 #endif // GY33_H
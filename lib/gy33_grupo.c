@@ -0,0 +1,218 @@
+#include "gy33_grupo.h"
+#include "gy33.h"
+#include "hardware/sync.h"
+
+// --- Funções Internas ---
+
+// Seleciona um único canal do multiplexador (bloqueante; só na configuração)
+static bool selecionar_canal(gy33_grupo_t *grupo, uint8_t canal) {
+    uint8_t mascara = 1u << canal;
+    return i2c_barramento_transferir(grupo->bar, grupo->endereco_mux, GY33_I2C_BAUDRATE,
+                                     &mascara, 1, NULL, 0) == I2C_TRANSACAO_OK;
+}
+
+// Escreve um registrador do sensor atrás do canal já selecionado
+static bool escrever_registrador(gy33_grupo_t *grupo, uint8_t reg, uint8_t valor) {
+    uint8_t buffer[2] = {reg, valor};
+    return i2c_barramento_transferir(grupo->bar, GY33_I2C_ADDR, GY33_I2C_BAUDRATE,
+                                     buffer, 2, NULL, 0) == I2C_TRANSACAO_OK;
+}
+
+// Fim da limpeza do AINT, a última das três transações (contexto de interrupção):
+// guarda os valores brutos se a leitura trouxe uma integração nova
+static void leitura_concluida(i2c_transacao_t *t) {
+    gy33_grupo_t *grupo = (gy33_grupo_t *)t->contexto;
+    int8_t i = grupo->em_leitura;
+    uint8_t bit = 1u << i;
+
+    // Se a seleção de canal falhou, os dados seriam do sensor selecionado antes.
+    // Se a limpeza falhou, o AINT continua aceso e a próxima leitura o repetiria:
+    // descartar esta mantém a contagem certa (a próxima traz o mesmo dado ou um mais novo).
+    bool valida = grupo->t_mux.status == I2C_TRANSACAO_OK &&
+                  grupo->t_dados.status == I2C_TRANSACAO_OK &&
+                  t->status == I2C_TRANSACAO_OK;
+    bool nova = valida && (grupo->buffer[0] & STATUS_AINT);
+    grupo->sem_novidade &= ~bit;
+    if (nova) {
+        const uint8_t *d = &grupo->buffer[1];
+        grupo->bruto_c[i] = (d[1] << 8) | d[0];
+        grupo->bruto_r[i] = (d[3] << 8) | d[2];
+        grupo->bruto_g[i] = (d[5] << 8) | d[4];
+        grupo->bruto_b[i] = (d[7] << 8) | d[6];
+        grupo->com_falha &= ~bit;
+    } else if (valida) {
+        grupo->com_falha &= ~bit;
+        grupo->sem_novidade |= bit;  // AVALID fica aceso: só o AINT diz que a integração é nova
+    } else {
+        grupo->com_falha |= bit;
+    }
+    grupo->prontos |= bit;
+    grupo->em_leitura = -1;
+}
+
+// Aplica calibração e filtro às amostras que chegaram desde a última chamada
+static void processar_prontos(gy33_grupo_t *grupo) {
+    uint32_t irqs = save_and_disable_interrupts();
+    uint8_t prontos = grupo->prontos;
+    uint8_t com_falha = grupo->com_falha;
+    uint8_t sem_novidade = grupo->sem_novidade;
+    grupo->prontos = 0;
+    restore_interrupts(irqs);
+
+    for (uint8_t i = 0; i < grupo->quantidade; i++) {
+        uint8_t bit = 1u << i;
+        if (!(prontos & bit)) continue;
+        if (com_falha & bit) {
+            grupo->falhas[i]++;
+            continue;
+        }
+        if (sem_novidade & bit) {
+            // Oscilador do sensor mais lento que o nominal: tenta de novo um ciclo do ADC
+            // depois, e as próximas janelas deste sensor seguem a partir daí
+            grupo->repetidas[i]++;
+            grupo->proxima_us[i] = time_us_32() + GY33_CICLO_ADC_US;
+            grupo->proximo = i;
+            continue;
+        }
+        float a = grupo->alfa[i];
+        float c = grupo->bruto_c[i];
+        float r = grupo->bruto_r[i] * grupo->calib_r[i];
+        float g = grupo->bruto_g[i] * grupo->calib_g[i];
+        float b = grupo->bruto_b[i] * grupo->calib_b[i];
+        if (grupo->amostras[i] == 0) a = 1.0f;  // Primeira amostra inicializa o filtro
+        grupo->filtro_c[i] += a * (c - grupo->filtro_c[i]);
+        grupo->filtro_r[i] += a * (r - grupo->filtro_r[i]);
+        grupo->filtro_g[i] += a * (g - grupo->filtro_g[i]);
+        grupo->filtro_b[i] += a * (b - grupo->filtro_b[i]);
+        grupo->amostras[i]++;
+        grupo->novos |= bit;
+    }
+}
+
+// --- Funções Públicas ---
+
+void gy33_grupo_init(gy33_grupo_t *grupo, i2c_barramento_t *bar, uint8_t endereco_mux, uint8_t atime) {
+    *grupo = (gy33_grupo_t){0};
+    grupo->bar = bar;
+    grupo->endereco_mux = endereco_mux;
+    grupo->atime = atime ? atime : GY33_ATIME_PADRAO;
+    grupo->periodo_us = (256u - grupo->atime) * GY33_CICLO_ADC_US;
+    grupo->em_leitura = -1;
+}
+
+int gy33_grupo_adicionar(gy33_grupo_t *grupo, uint8_t canal, gy33_ganho_t ganho) {
+    if (grupo->quantidade == GY33_GRUPO_MAX || canal >= GY33_GRUPO_MAX) return -1;
+    uint8_t i = grupo->quantidade++;
+    grupo->canal[i] = canal;
+    grupo->ganho[i] = ganho;
+    gy33_grupo_calibrar(grupo, i, 1.0f, 1.0f, 1.0f, 1.0f);
+    return i;
+}
+
+void gy33_grupo_calibrar(gy33_grupo_t *grupo, uint8_t sensor, float r, float g, float b, float alfa) {
+    grupo->calib_r[sensor] = r;
+    grupo->calib_g[sensor] = g;
+    grupo->calib_b[sensor] = b;
+    grupo->alfa[sensor] = alfa;
+}
+
+void gy33_grupo_iniciar(gy33_grupo_t *grupo) {
+    if (grupo->quantidade == 0) return;
+
+    // Configura todos com o ADC parado
+    for (uint8_t i = 0; i < grupo->quantidade; i++) {
+        if (!selecionar_canal(grupo, grupo->canal[i])) {
+            grupo->falhas[i]++;
+            continue;
+        }
+        escrever_registrador(grupo, ENABLE_REG, 0x01);  // Só o oscilador (PON)
+        escrever_registrador(grupo, ATIME_REG, grupo->atime);
+        escrever_registrador(grupo, PERS_REG, 0x00);  // Todo ciclo acende o AINT
+        escrever_registrador(grupo, CONTROL_REG, grupo->ganho[i]);
+    }
+    sleep_us(GY33_CICLO_ADC_US);  // O datasheet pede 2,4 ms entre PON e AEN
+
+    // Liga o ADC de cada um defasado de período/N
+    uint32_t passo = grupo->periodo_us / grupo->quantidade;
+    uint32_t inicio = time_us_32();
+    for (uint8_t i = 0; i < grupo->quantidade; i++) {
+        uint32_t alvo = inicio + i * passo;
+        while ((int32_t)(time_us_32() - alvo) < 0) {
+            tight_loop_contents();
+        }
+        if (selecionar_canal(grupo, grupo->canal[i])) {
+            escrever_registrador(grupo, ENABLE_REG, ENABLE_PON_AEN | ENABLE_AIEN);
+        }
+        grupo->proxima_us[i] = time_us_32() + grupo->periodo_us + GY33_GRUPO_MARGEM_US;
+    }
+    grupo->proximo = 0;
+}
+
+void gy33_grupo_servico(gy33_grupo_t *grupo) {
+    processar_prontos(grupo);
+    if (grupo->quantidade == 0 || grupo->em_leitura >= 0) return;
+
+    uint8_t i = grupo->proximo;
+    uint32_t agora = time_us_32();
+    if ((int32_t)(agora - grupo->proxima_us[i]) < 0) return;
+
+    grupo->cmd_mux = 1u << grupo->canal[i];
+    grupo->t_mux = (i2c_transacao_t){
+        .endereco = grupo->endereco_mux,
+        .escrita = &grupo->cmd_mux,
+        .tam_escrita = 1,
+        .baudrate = GY33_I2C_BAUDRATE,
+    };
+    grupo->cmd_dados = STATUS_REG | AUTO_INCREMENTO;
+    grupo->t_dados = (i2c_transacao_t){
+        .endereco = GY33_I2C_ADDR,
+        .escrita = &grupo->cmd_dados,
+        .tam_escrita = 1,
+        .leitura = grupo->buffer,
+        .tam_leitura = sizeof(grupo->buffer),
+        .baudrate = GY33_I2C_BAUDRATE,
+    };
+    grupo->cmd_limpar = LIMPAR_AINT;
+    grupo->t_limpar = (i2c_transacao_t){
+        .endereco = GY33_I2C_ADDR,
+        .escrita = &grupo->cmd_limpar,
+        .tam_escrita = 1,
+        .baudrate = GY33_I2C_BAUDRATE,
+        .callback = leitura_concluida,
+        .contexto = grupo,
+    };
+
+    // As três entram juntas na fila (ou nenhuma): a seleção vale para as duas logo atrás
+    uint32_t irqs = save_and_disable_interrupts();
+    bool cabe = grupo->bar->ocupados <= I2C_FILA_TAM - 3;
+    if (cabe) {
+        grupo->em_leitura = i;
+        i2c_barramento_enfileirar(grupo->bar, &grupo->t_mux);
+        i2c_barramento_enfileirar(grupo->bar, &grupo->t_dados);
+        i2c_barramento_enfileirar(grupo->bar, &grupo->t_limpar);
+    }
+    restore_interrupts(irqs);
+    if (!cabe) return;  // Tenta de novo na próxima chamada
+
+    // Próxima janela deste sensor; se atrasamos mais de um período, realinha
+    grupo->proxima_us[i] += grupo->periodo_us;
+    if ((int32_t)(agora - grupo->proxima_us[i]) >= 0) grupo->proxima_us[i] = agora + grupo->periodo_us;
+    grupo->proximo = (i + 1) % grupo->quantidade;
+}
+
+bool gy33_grupo_ler(gy33_grupo_t *grupo, uint8_t sensor, float *r, float *g, float *b, float *c) {
+    uint8_t bit = 1u << sensor;
+    *r = grupo->filtro_r[sensor];
+    *g = grupo->filtro_g[sensor];
+    *b = grupo->filtro_b[sensor];
+    *c = grupo->filtro_c[sensor];
+    bool novo = grupo->novos & bit;
+    grupo->novos &= ~bit;
+    return novo;
+}
+
+uint32_t gy33_grupo_total_amostras(const gy33_grupo_t *grupo) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < grupo->quantidade; i++) total += grupo->amostras[i];
+    return total;
+}
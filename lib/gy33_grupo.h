@@ -0,0 +1,103 @@
+#ifndef GY33_GRUPO_H
+#define GY33_GRUPO_H
+
+#include "pico/stdlib.h"
+#include "i2c_barramento.h"
+
+/* ---------- Vários GY-33 atrás de um multiplexador TCA9548A ----------
+ * Todos os sensores têm o mesmo endereço (0x29), então cada um fica num canal
+ * do multiplexador. As janelas de integração são defasadas de período/N:
+ * enquanto um sensor integra, o anterior é lido pela fila assíncrona do
+ * barramento, e o grupo entrega perto de N amostras por período de integração.
+ * Uma amostra só conta como nova com o AINT aceso (PERS = 0: todo ciclo o
+ * acende); ele é apagado logo depois de cada leitura.
+ * Um GY-33 avulso (gy33_read_color) não pode dividir o barramento com o
+ * multiplexador: responderia no mesmo endereço que o canal selecionado. */
+
+#define GY33_GRUPO_MAX        8      // Canais do TCA9548A
+#define TCA9548A_ENDERECO     0x70   // A0-A2 em nível baixo
+#define GY33_ATIME_PADRAO     0xF5   // 11 ciclos de 2,4 ms = 26,4 ms de integração
+#define GY33_CICLO_ADC_US     2400   // Duração de um ciclo do ADC do TCS34725
+#define GY33_GRUPO_MARGEM_US  3000   // Inicialização do ADC após AEN + folga do oscilador interno
+
+/* ---------- Ganho analógico (CONTROL_REG) ---------- */
+typedef enum {
+    GY33_GANHO_1X = 0,
+    GY33_GANHO_4X,
+    GY33_GANHO_16X,
+    GY33_GANHO_60X,
+} gy33_ganho_t;
+
+/* ---------- Estado do grupo (estrutura de vetores: um índice por sensor) ---------- */
+typedef struct {
+    i2c_barramento_t *bar;
+    uint8_t endereco_mux;
+    uint8_t quantidade;
+    uint8_t atime;                       // Comum a todos: a defasagem depende do mesmo período
+    uint32_t periodo_us;
+
+    // Configuração
+    uint8_t canal[GY33_GRUPO_MAX];       // Canal do multiplexador (0-7)
+    uint8_t ganho[GY33_GRUPO_MAX];       // gy33_ganho_t
+    float calib_r[GY33_GRUPO_MAX];       // Multiplicadores de calibração por canal de cor
+    float calib_g[GY33_GRUPO_MAX];
+    float calib_b[GY33_GRUPO_MAX];
+    float alfa[GY33_GRUPO_MAX];          // Filtro exponencial (1 = sem filtro)
+
+    // Últimas leituras brutas (escritas na interrupção do barramento)
+    volatile uint16_t bruto_c[GY33_GRUPO_MAX];
+    volatile uint16_t bruto_r[GY33_GRUPO_MAX];
+    volatile uint16_t bruto_g[GY33_GRUPO_MAX];
+    volatile uint16_t bruto_b[GY33_GRUPO_MAX];
+
+    // Valores calibrados e filtrados
+    float filtro_c[GY33_GRUPO_MAX];
+    float filtro_r[GY33_GRUPO_MAX];
+    float filtro_g[GY33_GRUPO_MAX];
+    float filtro_b[GY33_GRUPO_MAX];
+
+    // Agenda e contadores
+    uint32_t proxima_us[GY33_GRUPO_MAX]; // Instante em que a próxima integração termina
+    uint32_t amostras[GY33_GRUPO_MAX];
+    uint32_t falhas[GY33_GRUPO_MAX];
+    uint32_t repetidas[GY33_GRUPO_MAX];  // Leituras sem integração nova (AINT apagado)
+
+    // Pipeline: seleção de canal, leitura em rajada e limpeza do AINT
+    uint8_t proximo;                     // Próximo sensor na ordem circular
+    volatile int8_t em_leitura;          // Sensor sendo lido (-1 = nenhum)
+    volatile uint8_t prontos;            // Bit i: amostra nova do sensor i ainda não filtrada
+    volatile uint8_t com_falha;          // Bit i: última leitura do sensor i falhou
+    volatile uint8_t sem_novidade;       // Bit i: última leitura do sensor i repetiu a integração anterior
+    uint8_t novos;                       // Bit i: amostra filtrada ainda não consumida
+    uint8_t cmd_mux;
+    uint8_t cmd_dados;
+    uint8_t cmd_limpar;
+    uint8_t buffer[9];                   // STATUS + C, R, G, B
+    i2c_transacao_t t_mux;
+    i2c_transacao_t t_dados;
+    i2c_transacao_t t_limpar;
+} gy33_grupo_t;
+
+// Prepara o grupo vazio (atime = 0 usa GY33_ATIME_PADRAO)
+void gy33_grupo_init(gy33_grupo_t *grupo, i2c_barramento_t *bar, uint8_t endereco_mux, uint8_t atime);
+
+// Acrescenta um sensor no canal dado; retorna seu índice ou -1 se o grupo estiver cheio
+int gy33_grupo_adicionar(gy33_grupo_t *grupo, uint8_t canal, gy33_ganho_t ganho);
+
+// Ajusta a calibração (multiplicadores R, G, B) e o filtro de um sensor
+void gy33_grupo_calibrar(gy33_grupo_t *grupo, uint8_t sensor, float r, float g, float b, float alfa);
+
+// Configura todos os sensores e liga cada um defasado de período/N (bloqueia por até um período)
+void gy33_grupo_iniciar(gy33_grupo_t *grupo);
+
+// Chamar no laço principal: filtra o que chegou e enfileira a próxima leitura vencida.
+// Nunca bloqueia.
+void gy33_grupo_servico(gy33_grupo_t *grupo);
+
+// Copia a amostra filtrada do sensor; retorna true se ela é nova desde a última chamada
+bool gy33_grupo_ler(gy33_grupo_t *grupo, uint8_t sensor, float *r, float *g, float *b, float *c);
+
+// Soma das amostras de todos os sensores (para medir a vazão agregada)
+uint32_t gy33_grupo_total_amostras(const gy33_grupo_t *grupo);
+
+#endif // GY33_GRUPO_H
@@ -0,0 +1,33 @@
+#include "historico_lux.h"
+
+void historico_lux_init(historico_lux_t *h, uint16_t amostras_por_coluna) {
+    *h = (historico_lux_t){0};
+    h->amostras_por_coluna = amostras_por_coluna ? amostras_por_coluna : 1;
+}
+
+bool historico_lux_adicionar(historico_lux_t *h, uint16_t lux) {
+    if (h->acumuladas == 0) {
+        h->acumulando.min = lux;
+        h->acumulando.max = lux;
+    } else {
+        if (lux < h->acumulando.min) h->acumulando.min = lux;
+        if (lux > h->acumulando.max) h->acumulando.max = lux;
+    }
+    if (++h->acumuladas < h->amostras_por_coluna) return false;
+
+    // Fecha a coluna: com o anel cheio ela ocupa o lugar da mais antiga
+    uint8_t destino = (h->inicio + h->quantidade) % HISTORICO_LUX_COLUNAS;
+    h->colunas[destino] = h->acumulando;
+    if (h->quantidade < HISTORICO_LUX_COLUNAS) {
+        h->quantidade++;
+    } else {
+        h->inicio = (h->inicio + 1) % HISTORICO_LUX_COLUNAS;
+    }
+    h->acumuladas = 0;
+    h->total_colunas++;
+    return true;
+}
+
+const coluna_lux_t *historico_lux_coluna(const historico_lux_t *h, uint8_t i) {
+    return &h->colunas[(h->inicio + i) % HISTORICO_LUX_COLUNAS];
+}
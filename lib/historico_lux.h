@@ -0,0 +1,36 @@
+#ifndef HISTORICO_LUX_H
+#define HISTORICO_LUX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Uma coluna por pixel horizontal do display
+#define HISTORICO_LUX_COLUNAS 128
+
+/* ---------- Coluna decimada (mínimo e máximo das amostras agrupadas) ---------- */
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+} coluna_lux_t;
+
+/* ---------- Anel de colunas com tamanho fixo ---------- */
+typedef struct {
+    coluna_lux_t colunas[HISTORICO_LUX_COLUNAS];
+    uint8_t inicio;                // Índice da coluna mais antiga
+    uint8_t quantidade;            // Colunas já fechadas (até HISTORICO_LUX_COLUNAS)
+    uint16_t amostras_por_coluna;  // Fator de decimação: janela = colunas × amostras_por_coluna
+    uint32_t total_colunas;        // Colunas fechadas desde o início (não volta a zero no anel)
+    coluna_lux_t acumulando;       // Coluna em formação
+    uint16_t acumuladas;
+} historico_lux_t;
+
+// Limpa o histórico e define quantas amostras formam cada coluna
+void historico_lux_init(historico_lux_t *h, uint16_t amostras_por_coluna);
+
+// Acrescenta uma amostra; retorna true quando ela fecha uma nova coluna
+bool historico_lux_adicionar(historico_lux_t *h, uint16_t lux);
+
+// Coluna `i` em ordem cronológica (0 = mais antiga, quantidade - 1 = mais recente)
+const coluna_lux_t *historico_lux_coluna(const historico_lux_t *h, uint8_t i);
+
+#endif // HISTORICO_LUX_H
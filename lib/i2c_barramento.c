@@ -0,0 +1,507 @@
+#include "i2c_barramento.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/clocks.h"
+#include "i2c_mestre.pio.h"  // Gerado pelo pioasm no build; tools/ usam a cópia de lib/generated
+
+// Palavras de controle do programa i2c_mestre (formato em i2c_mestre.pio)
+#define PIO_I2C_EXECUTAR(n)     ((uint16_t)((n) - 1) << 10)  // As n palavras seguintes são instruções
+#define PIO_I2C_FINAL           (1u << 9)                    // NAK esperado (último byte lido)
+#define PIO_I2C_NAK             1u
+#define PIO_I2C_BYTE(b)         ((uint16_t)((b) << 1) | PIO_I2C_NAK)
+#define PIO_I2C_FLAG_FIM(sm)    (((sm) + 2) & 3)             // Flag levantada pelo STOP (irq 2 rel)
+#define PIO_I2C_PALAVRAS_START   3
+#define PIO_I2C_PALAVRAS_RESTART 5
+#define PIO_I2C_PALAVRAS_STOP    5
+
+// Barramento associado a cada controlador (usado pelos tratadores de interrupção)
+static i2c_barramento_t *barramentos[2];
+
+// Barramentos do PIO por bloco e SM, e onde o programa foi carregado em cada bloco
+static i2c_barramento_t *barramentos_pio[2][4];
+static int offset_programa_pio[2] = { -1, -1 };
+
+static const uint16_t palavras_start[PIO_I2C_PALAVRAS_START] = {
+    PIO_I2C_EXECUTAR(2),
+    i2c_mestre_scl_sda_program_instructions[I2C_SC1_SD0],  // SDA desce com SCL alto
+    i2c_mestre_scl_sda_program_instructions[I2C_SC0_SD0],
+};
+static const uint16_t palavras_restart[PIO_I2C_PALAVRAS_RESTART] = {
+    PIO_I2C_EXECUTAR(4),
+    i2c_mestre_scl_sda_program_instructions[I2C_SC0_SD1],
+    i2c_mestre_scl_sda_program_instructions[I2C_SC1_SD1],
+    i2c_mestre_scl_sda_program_instructions[I2C_SC1_SD0],
+    i2c_mestre_scl_sda_program_instructions[I2C_SC0_SD0],
+};
+// A última instrução do STOP é montada em tempo de execução (irq 2 rel)
+static uint16_t palavras_stop[PIO_I2C_PALAVRAS_STOP] = {
+    PIO_I2C_EXECUTAR(4),
+    i2c_mestre_scl_sda_program_instructions[I2C_SC0_SD0],
+    i2c_mestre_scl_sda_program_instructions[I2C_SC1_SD0],
+    i2c_mestre_scl_sda_program_instructions[I2C_SC1_SD1],  // SDA sobe com SCL alto
+    0,
+};
+
+static void iniciar_proxima(i2c_barramento_t *bar);
+
+// --- Funções Internas ---
+
+// Desliga as interrupções do controlador enquanto ele está ocioso
+static inline void desabilitar_irqs(i2c_hw_t *hw) {
+    hw->intr_mask = 0;
+}
+
+// Fontes de interrupção de uma SM: RX com dado, as flags de NAK e de fim e, opcionalmente, TX com espaço
+static inline uint32_t fontes_irq_pio(uint sm, bool tx) {
+    return (1u << (pis_sm0_rx_fifo_not_empty + sm)) | (1u << (pis_interrupt0 + sm)) |
+           (1u << (pis_interrupt0 + PIO_I2C_FLAG_FIM(sm))) | (tx ? 1u << (pis_sm0_tx_fifo_not_full + sm) : 0);
+}
+
+static void desabilitar_irqs_barramento(i2c_barramento_t *bar) {
+    if (bar->pio) {
+        pio_set_irq0_source_mask_enabled(bar->pio, fontes_irq_pio(bar->sm, true), false);
+    } else {
+        desabilitar_irqs(i2c_get_hw(bar->i2c));
+    }
+}
+
+// Total de comandos (bytes escritos + bytes lidos) de uma transação
+static inline uint16_t total_comandos(const i2c_transacao_t *t) {
+    return t->tam_escrita + t->tam_leitura;
+}
+
+// Encerra a transação atual, avisa o dono e passa para a próxima da fila
+static void finalizar(i2c_barramento_t *bar, i2c_status_t status) {
+    i2c_transacao_t *t = bar->atual;
+    desabilitar_irqs_barramento(bar);
+    if (bar->alarme_prazo > 0) {
+        cancel_alarm(bar->alarme_prazo);
+        bar->alarme_prazo = 0;
+    }
+    bar->atual = NULL;
+
+    switch (status) {
+    case I2C_TRANSACAO_OK:      bar->total_ok++; break;
+    case I2C_TRANSACAO_NACK:    bar->total_nack++; break;
+    case I2C_TRANSACAO_TIMEOUT: bar->total_timeout++; break;
+    default: break;
+    }
+
+    t->status = status;
+    if (t->callback) t->callback(t);
+    iniciar_proxima(bar);
+}
+
+// Estouro de prazo: aborta, recupera o barramento e falha a transação
+static int64_t tratar_prazo(alarm_id_t id, void *dados) {
+    i2c_barramento_t *bar = (i2c_barramento_t *)dados;
+    if (bar->atual == NULL || bar->alarme_prazo != id) return 0;
+    bar->alarme_prazo = 0;
+    desabilitar_irqs_barramento(bar);
+    i2c_barramento_recuperar(bar);
+    finalizar(bar, I2C_TRANSACAO_TIMEOUT);
+    return 0;
+}
+
+// Coloca na FIFO de TX tantos comandos quanto couberem
+static void alimentar_tx(i2c_barramento_t *bar) {
+    i2c_hw_t *hw = i2c_get_hw(bar->i2c);
+    i2c_transacao_t *t = bar->atual;
+    uint16_t total = total_comandos(t);
+
+    while (bar->cmds_enviados < total && hw->txflr < IC_TX_BUFFER_DEPTH) {
+        uint16_t k = bar->cmds_enviados++;
+        uint32_t cmd;
+        if (k < t->tam_escrita) {
+            cmd = t->escrita[k];
+        } else {
+            cmd = I2C_IC_DATA_CMD_CMD_BITS; // Leitura
+            if (k == t->tam_escrita && t->tam_escrita > 0) cmd |= I2C_IC_DATA_CMD_RESTART_BITS;
+        }
+        if (k == total - 1) cmd |= I2C_IC_DATA_CMD_STOP_BITS;
+        hw->data_cmd = cmd;
+    }
+
+    if (bar->cmds_enviados == total) {
+        hw->intr_mask &= ~I2C_IC_INTR_MASK_M_TX_EMPTY_BITS;
+    }
+}
+
+// Esvazia a FIFO de RX no buffer de leitura
+static void drenar_rx(i2c_barramento_t *bar) {
+    i2c_hw_t *hw = i2c_get_hw(bar->i2c);
+    i2c_transacao_t *t = bar->atual;
+    while (hw->rxflr > 0) {
+        uint8_t byte = (uint8_t)hw->data_cmd;
+        if (bar->bytes_lidos < t->tam_leitura) t->leitura[bar->bytes_lidos++] = byte;
+    }
+}
+
+// Palavras de uma transação no PIO: START, endereço e bytes escritos,
+// RESTART, endereço e bytes lidos, STOP
+static uint16_t total_palavras_pio(const i2c_transacao_t *t) {
+    uint16_t total = PIO_I2C_PALAVRAS_START + PIO_I2C_PALAVRAS_STOP;
+    if (t->tam_escrita) total += 1 + t->tam_escrita;
+    if (t->tam_leitura) total += (t->tam_escrita ? PIO_I2C_PALAVRAS_RESTART : 0) + 1 + t->tam_leitura;
+    return total;
+}
+
+// Palavra `k` da transação, calculada na hora para não precisar de buffer
+static uint16_t palavra_pio(const i2c_transacao_t *t, uint16_t k) {
+    if (k < PIO_I2C_PALAVRAS_START) return palavras_start[k];
+    k -= PIO_I2C_PALAVRAS_START;
+    if (t->tam_escrita) {
+        if (k == 0) return PIO_I2C_BYTE(t->endereco << 1);
+        if (--k < t->tam_escrita) return PIO_I2C_BYTE(t->escrita[k]);
+        k -= t->tam_escrita;
+    }
+    if (t->tam_leitura) {
+        if (t->tam_escrita) {
+            if (k < PIO_I2C_PALAVRAS_RESTART) return palavras_restart[k];
+            k -= PIO_I2C_PALAVRAS_RESTART;
+        }
+        if (k == 0) return PIO_I2C_BYTE((t->endereco << 1) | 1);
+        if (--k < t->tam_leitura) {
+            // Bits em 1 soltam SDA para o escravo; ACK em todos menos no último
+            return k == t->tam_leitura - 1 ? PIO_I2C_BYTE(0xFF) | PIO_I2C_FINAL : (uint16_t)(0xFF << 1);
+        }
+        k -= t->tam_leitura;
+    }
+    return palavras_stop[k];
+}
+
+// Coloca na FIFO de TX da SM tantas palavras quanto couberem
+static void alimentar_tx_pio(i2c_barramento_t *bar) {
+    i2c_transacao_t *t = bar->atual;
+    uint16_t total = total_palavras_pio(t);
+    while (bar->cmds_enviados < total && !pio_sm_is_tx_fifo_full(bar->pio, bar->sm)) {
+        pio_sm_put(bar->pio, bar->sm, (uint32_t)palavra_pio(t, bar->cmds_enviados++) << 16);
+    }
+    if (bar->cmds_enviados == total) {
+        pio_set_irq0_source_enabled(bar->pio, pis_sm0_tx_fifo_not_full + bar->sm, false);
+    }
+}
+
+// Esvazia a FIFO de RX da SM, descartando o eco do endereço e dos bytes escritos
+static void drenar_rx_pio(i2c_barramento_t *bar) {
+    i2c_transacao_t *t = bar->atual;
+    uint16_t eco = (t->tam_escrita ? 1 + t->tam_escrita : 0) + (t->tam_leitura ? 1 : 0);
+    while (!pio_sm_is_rx_fifo_empty(bar->pio, bar->sm)) {
+        uint8_t byte = (uint8_t)pio_sm_get(bar->pio, bar->sm);
+        if (bar->bytes_recebidos++ >= eco && bar->bytes_lidos < t->tam_leitura) {
+            t->leitura[bar->bytes_lidos++] = byte;
+        }
+    }
+}
+
+static void definir_baudrate_pio(i2c_barramento_t *bar, uint32_t baudrate) {
+    // 32 ciclos da SM por bit
+    float divisor = (float)bar->clk_sys_hz / (32.0f * baudrate);
+    pio_sm_set_clkdiv(bar->pio, bar->sm, divisor < 1.0f ? 1.0f : divisor);
+}
+
+// Liga a SM aos pinos com a FIFO, as flags e as fontes de interrupção limpas
+static void iniciar_sm_pio(i2c_barramento_t *bar) {
+    pio_set_irq0_source_mask_enabled(bar->pio, fontes_irq_pio(bar->sm, true), false);
+    pio_sm_set_enabled(bar->pio, bar->sm, false);
+    pio_sm_clear_fifos(bar->pio, bar->sm);
+    pio_sm_restart(bar->pio, bar->sm);
+    pio_interrupt_clear(bar->pio, bar->sm);
+    pio_interrupt_clear(bar->pio, PIO_I2C_FLAG_FIM(bar->sm));
+    i2c_mestre_program_init(bar->pio, bar->sm, bar->offset_pio, bar->sda_pin,
+                            (float)bar->clk_sys_hz / (32.0f * bar->baudrate_padrao));
+}
+
+// Programa o controlador para a transação na cabeça da fila (chamada com IRQs desligadas)
+static void iniciar_proxima(i2c_barramento_t *bar) {
+    if (bar->atual != NULL || bar->ocupados == 0) return;
+
+    i2c_transacao_t *t = bar->fila[bar->cabeca];
+    bar->cabeca = (bar->cabeca + 1) % I2C_FILA_TAM;
+    bar->ocupados--;
+
+    bar->atual = t;
+    bar->cmds_enviados = 0;
+    bar->bytes_lidos = 0;
+
+    uint32_t baudrate = t->baudrate ? t->baudrate : bar->baudrate_padrao;
+    if (bar->baudrate_maximo && baudrate > bar->baudrate_maximo) baudrate = bar->baudrate_maximo;
+    if (baudrate != bar->baudrate_atual) {
+        if (bar->pio) {
+            definir_baudrate_pio(bar, baudrate);
+        } else {
+            i2c_set_baudrate(bar->i2c, baudrate);
+        }
+        bar->baudrate_atual = baudrate;
+    }
+
+    // 9 bits por byte, com folga de 2x sobre o tempo nominal
+    uint32_t prazo = t->timeout_us ? t->timeout_us
+                   : I2C_TIMEOUT_MARGEM_US + (uint32_t)((uint64_t)total_comandos(t) * 18 * 1000000 / baudrate);
+    bar->alarme_prazo = add_alarm_in_us(prazo, tratar_prazo, bar, true);
+    if (bar->alarme_prazo < 0) {
+        // Sem prazo um barramento travado nunca seria abortado: falha antes de enviar
+        bar->alarme_prazo = 0;
+        finalizar(bar, I2C_TRANSACAO_SEM_ALARME);
+        return;
+    }
+
+    if (bar->pio) {
+        bar->bytes_recebidos = 0;
+        bar->nack_pio = false;
+        pio_set_irq0_source_mask_enabled(bar->pio, fontes_irq_pio(bar->sm, true), true);
+        alimentar_tx_pio(bar);
+        return;
+    }
+
+    i2c_hw_t *hw = i2c_get_hw(bar->i2c);
+    hw->enable = 0;
+    hw->tar = t->endereco;
+    hw->enable = I2C_IC_ENABLE_ENABLE_BITS;
+    (void)hw->clr_intr;
+
+    hw->intr_mask = I2C_IC_INTR_MASK_M_TX_EMPTY_BITS | I2C_IC_INTR_MASK_M_RX_FULL_BITS |
+                    I2C_IC_INTR_MASK_M_TX_ABRT_BITS | I2C_IC_INTR_MASK_M_STOP_DET_BITS;
+    alimentar_tx(bar);
+}
+
+// Máquina de estados da transação, executada na interrupção do controlador
+static void tratar_irq(i2c_barramento_t *bar) {
+    i2c_hw_t *hw = i2c_get_hw(bar->i2c);
+    uint32_t estado = hw->intr_stat;
+    if (bar->atual == NULL) {
+        desabilitar_irqs(hw);
+        (void)hw->clr_intr;
+        return;
+    }
+
+    if (estado & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+        // O controlador gera STOP e descarta a FIFO sozinho após um abort
+        (void)hw->clr_tx_abrt;
+        (void)hw->clr_stop_det;
+        finalizar(bar, I2C_TRANSACAO_NACK);
+        return;
+    }
+    if (estado & I2C_IC_INTR_STAT_R_RX_FULL_BITS) {
+        drenar_rx(bar);
+    }
+    if (estado & I2C_IC_INTR_STAT_R_TX_EMPTY_BITS) {
+        alimentar_tx(bar);
+    }
+    if (estado & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+        (void)hw->clr_stop_det;
+        drenar_rx(bar);
+        bool completa = bar->cmds_enviados == total_comandos(bar->atual) &&
+                        bar->bytes_lidos == bar->atual->tam_leitura;
+        finalizar(bar, completa ? I2C_TRANSACAO_OK : I2C_TRANSACAO_NACK);
+    }
+}
+
+static void tratar_irq_i2c0(void) { tratar_irq(barramentos[0]); }
+static void tratar_irq_i2c1(void) { tratar_irq(barramentos[1]); }
+
+// Mesma máquina de estados para uma SM do PIO. O NAK é a flag da própria SM,
+// que fica parada até ser liberada; o fim é a flag levantada pelo STOP.
+static void tratar_irq_pio(i2c_barramento_t *bar) {
+    PIO pio = bar->pio;
+    uint sm = bar->sm;
+    if (bar->atual == NULL) {
+        desabilitar_irqs_barramento(bar);
+        return;
+    }
+
+    drenar_rx_pio(bar);
+    if (pio_interrupt_get(pio, sm)) {
+        // Descarta o resto da transação, devolve a SM ao ponto de entrada e gera o STOP
+        pio_sm_drain_tx_fifo(pio, sm);
+        pio_sm_exec(pio, sm, pio_encode_jmp(bar->offset_pio + i2c_mestre_offset_entry_point));
+        pio_interrupt_clear(pio, sm);
+        bar->nack_pio = true;
+        bar->cmds_enviados = total_palavras_pio(bar->atual) - PIO_I2C_PALAVRAS_STOP;
+        pio_set_irq0_source_enabled(pio, pis_sm0_tx_fifo_not_full + sm, true);
+    }
+    if (pio_interrupt_get(pio, PIO_I2C_FLAG_FIM(sm))) {
+        pio_interrupt_clear(pio, PIO_I2C_FLAG_FIM(sm));
+        drenar_rx_pio(bar);
+        bool completa = !bar->nack_pio && bar->bytes_lidos == bar->atual->tam_leitura;
+        finalizar(bar, completa ? I2C_TRANSACAO_OK : I2C_TRANSACAO_NACK);
+        return;
+    }
+    alimentar_tx_pio(bar);
+}
+
+static void tratar_irq_pio_bloco(uint indice) {
+    for (uint sm = 0; sm < 4; sm++) {
+        if (barramentos_pio[indice][sm]) tratar_irq_pio(barramentos_pio[indice][sm]);
+    }
+}
+
+static void tratar_irq_pio0(void) { tratar_irq_pio_bloco(0); }
+static void tratar_irq_pio1(void) { tratar_irq_pio_bloco(1); }
+
+// --- Funções Públicas ---
+
+void i2c_barramento_init(i2c_barramento_t *bar, i2c_inst_t *i2c, uint sda_pin, uint scl_pin, uint32_t baudrate) {
+    *bar = (i2c_barramento_t){0};
+    bar->i2c = i2c;
+    bar->sda_pin = sda_pin;
+    bar->scl_pin = scl_pin;
+    bar->baudrate_padrao = baudrate;
+    bar->baudrate_atual = baudrate;
+
+    // Um dispositivo pode ter ficado no meio de um byte após um reset da placa
+    i2c_barramento_recuperar(bar);
+    bar->total_recuperacoes = 0;
+
+    uint indice = i2c_hw_index(i2c);
+    barramentos[indice] = bar;
+    uint irq = indice == 0 ? I2C0_IRQ : I2C1_IRQ;
+    // Mesma prioridade do alarme de prazo: um nunca interrompe o outro
+    irq_set_exclusive_handler(irq, indice == 0 ? tratar_irq_i2c0 : tratar_irq_i2c1);
+    irq_set_priority(irq, PICO_DEFAULT_IRQ_PRIORITY);
+    irq_set_enabled(irq, true);
+}
+
+bool i2c_barramento_init_pio(i2c_barramento_t *bar, PIO pio, uint sda_pin, uint32_t baudrate) {
+    uint indice = pio_get_index(pio);
+    if (offset_programa_pio[indice] < 0) {
+        if (!pio_can_add_program(pio, &i2c_mestre_program)) return false;
+        offset_programa_pio[indice] = pio_add_program(pio, &i2c_mestre_program);
+    }
+
+    // A flag de fim de uma SM é a de NAK da SM duas posições adiante: as duas não podem ser barramentos
+    int sm = -1;
+    for (uint i = 0; i < 4 && sm < 0; i++) {
+        if (!pio_sm_is_claimed(pio, i) && barramentos_pio[indice][PIO_I2C_FLAG_FIM(i)] == NULL) sm = i;
+    }
+    if (sm < 0) return false;
+    pio_sm_claim(pio, sm);
+
+    *bar = (i2c_barramento_t){0};
+    bar->pio = pio;
+    bar->sm = sm;
+    bar->offset_pio = offset_programa_pio[indice];
+    bar->clk_sys_hz = clock_get_hz(clk_sys);
+    bar->sda_pin = sda_pin;
+    bar->scl_pin = sda_pin + 1;
+    bar->baudrate_padrao = baudrate;
+    bar->baudrate_atual = baudrate;
+    palavras_stop[PIO_I2C_PALAVRAS_STOP - 1] = pio_encode_irq_set(true, 2);
+
+    i2c_barramento_recuperar(bar);
+    bar->total_recuperacoes = 0;
+
+    barramentos_pio[indice][sm] = bar;
+    uint irq = indice == 0 ? PIO0_IRQ_0 : PIO1_IRQ_0;
+    irq_set_exclusive_handler(irq, indice == 0 ? tratar_irq_pio0 : tratar_irq_pio1);
+    irq_set_priority(irq, PICO_DEFAULT_IRQ_PRIORITY);
+    irq_set_enabled(irq, true);
+    return true;
+}
+
+bool i2c_barramento_enfileirar(i2c_barramento_t *bar, i2c_transacao_t *transacao) {
+    if (total_comandos(transacao) == 0) {
+        transacao->status = I2C_TRANSACAO_NACK;
+        return false;
+    }
+    transacao->status = I2C_TRANSACAO_PENDENTE;
+
+    uint32_t irqs = save_and_disable_interrupts();
+    if (bar->ocupados == I2C_FILA_TAM) {
+        restore_interrupts(irqs);
+        transacao->status = I2C_TRANSACAO_FILA_CHEIA;
+        return false;
+    }
+    bar->fila[bar->cauda] = transacao;
+    bar->cauda = (bar->cauda + 1) % I2C_FILA_TAM;
+    bar->ocupados++;
+    iniciar_proxima(bar);
+    restore_interrupts(irqs);
+    return true;
+}
+
+i2c_status_t i2c_barramento_transferir(i2c_barramento_t *bar, uint8_t endereco, uint32_t baudrate,
+                                       const uint8_t *escrita, uint16_t tam_escrita,
+                                       uint8_t *leitura, uint16_t tam_leitura) {
+    i2c_transacao_t t = {
+        .endereco = endereco,
+        .escrita = escrita,
+        .tam_escrita = tam_escrita,
+        .leitura = leitura,
+        .tam_leitura = tam_leitura,
+        .baudrate = baudrate,
+    };
+    if (!i2c_barramento_enfileirar(bar, &t)) return t.status;
+    return i2c_barramento_aguardar(&t);
+}
+
+i2c_status_t i2c_barramento_aguardar(const i2c_transacao_t *transacao) {
+    while (transacao->status == I2C_TRANSACAO_PENDENTE) {
+        tight_loop_contents();
+    }
+    return transacao->status;
+}
+
+void i2c_barramento_limitar_baudrate(i2c_barramento_t *bar, uint32_t baudrate_maximo) {
+    bar->baudrate_maximo = baudrate_maximo;
+}
+
+bool i2c_barramento_ocupado(const i2c_barramento_t *bar) {
+    return bar->atual != NULL || bar->ocupados > 0;
+}
+
+void i2c_barramento_recuperar(i2c_barramento_t *bar) {
+    // Assume os pinos como GPIO em dreno aberto: nível baixo = saída, alto = entrada com pull-up
+    gpio_init(bar->sda_pin);
+    gpio_init(bar->scl_pin);
+    gpio_pull_up(bar->sda_pin);
+    gpio_pull_up(bar->scl_pin);
+    gpio_put(bar->sda_pin, 0);
+    gpio_put(bar->scl_pin, 0);
+    gpio_set_dir(bar->sda_pin, GPIO_IN);
+    gpio_set_dir(bar->scl_pin, GPIO_IN);
+    busy_wait_us_32(10);
+
+    // Até 9 pulsos de clock para o escravo terminar o byte que estava enviando
+    for (int i = 0; i < 9 && !gpio_get(bar->sda_pin); ++i) {
+        gpio_set_dir(bar->scl_pin, GPIO_OUT);
+        busy_wait_us_32(5);
+        gpio_set_dir(bar->scl_pin, GPIO_IN);
+        busy_wait_us_32(5);
+    }
+
+    // Condição de STOP: SDA sobe com SCL em nível alto
+    gpio_set_dir(bar->sda_pin, GPIO_OUT);
+    busy_wait_us_32(5);
+    gpio_set_dir(bar->sda_pin, GPIO_IN);
+    busy_wait_us_32(5);
+
+    // Reinicia o controlador e devolve os pinos a ele
+    if (bar->pio) {
+        bar->baudrate_atual = bar->baudrate_padrao;
+        iniciar_sm_pio(bar);
+        bar->total_recuperacoes++;
+        return;
+    }
+    i2c_init(bar->i2c, bar->baudrate_padrao);
+    bar->baudrate_atual = bar->baudrate_padrao;
+    gpio_set_function(bar->sda_pin, GPIO_FUNC_I2C);
+    gpio_set_function(bar->scl_pin, GPIO_FUNC_I2C);
+    gpio_pull_up(bar->sda_pin);
+    gpio_pull_up(bar->scl_pin);
+    desabilitar_irqs(i2c_get_hw(bar->i2c)); // O reset do bloco deixa todas as fontes habilitadas
+    bar->total_recuperacoes++;
+}
+
+void i2c_barramento_mudanca_clock(i2c_barramento_t *bar, bool antes, uint32_t clk_sys_hz) {
+    if (bar->pio == NULL) return;
+    if (antes) {
+        while (i2c_barramento_ocupado(bar)) {
+            tight_loop_contents();
+        }
+        return;
+    }
+    bar->clk_sys_hz = clk_sys_hz;
+    definir_baudrate_pio(bar, bar->baudrate_atual);
+}
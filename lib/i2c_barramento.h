@@ -0,0 +1,120 @@
+#ifndef I2C_BARRAMENTO_H
+#define I2C_BARRAMENTO_H
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Capacidade da fila de transações de cada barramento
+#define I2C_FILA_TAM 8
+
+// Prazo padrão quando o descritor não define um: esta margem fixa somada
+// ao dobro do tempo nominal dos bytes na velocidade da transação
+#define I2C_TIMEOUT_MARGEM_US 5000
+
+/* ---------- Estado de uma transação ---------- */
+typedef enum {
+    I2C_TRANSACAO_PENDENTE = 0,  // Na fila ou em andamento
+    I2C_TRANSACAO_OK,            // Concluída com sucesso
+    I2C_TRANSACAO_NACK,          // Dispositivo não respondeu (endereço ou dado)
+    I2C_TRANSACAO_TIMEOUT,       // Prazo estourado; barramento foi recuperado
+    I2C_TRANSACAO_FILA_CHEIA,    // Não coube na fila do barramento
+    I2C_TRANSACAO_SEM_ALARME,    // Nenhum alarme livre para o prazo; nada foi enviado
+} i2c_status_t;
+
+typedef struct i2c_transacao i2c_transacao_t;
+
+// Chamado em contexto de interrupção quando a transação termina
+typedef void (*i2c_callback_t)(i2c_transacao_t *transacao);
+
+/* ---------- Descritor de transação ----------
+ * Escreve `tam_escrita` bytes e, em seguida (com RESTART), lê `tam_leitura`
+ * bytes. Os buffers e o próprio descritor pertencem a quem enfileirou e
+ * devem continuar válidos até o status deixar de ser PENDENTE. */
+struct i2c_transacao {
+    uint8_t endereco;            // Endereço de 7 bits do dispositivo
+    const uint8_t *escrita;      // Bytes a escrever (pode ser NULL)
+    uint16_t tam_escrita;
+    uint8_t *leitura;            // Destino dos bytes lidos (pode ser NULL)
+    uint16_t tam_leitura;
+    uint32_t baudrate;           // Velocidade do dispositivo (0 = padrão do barramento)
+    uint32_t timeout_us;         // Prazo da transação (0 = calculado pelo tamanho)
+    i2c_callback_t callback;     // Opcional
+    void *contexto;              // Livre para uso de quem enfileirou
+    volatile i2c_status_t status;
+};
+
+/* ---------- Barramento ----------
+ * Controlado por um dos blocos I2C do RP2040 (i2c_barramento_init) ou por
+ * uma máquina de estados do PIO (i2c_barramento_init_pio). A fila, os
+ * prazos e os status são os mesmos; os drivers não percebem a diferença. */
+typedef struct {
+    i2c_inst_t *i2c;             // NULL num barramento do PIO
+    uint sda_pin, scl_pin;
+    uint32_t baudrate_padrao;    // Velocidade usada quando o descritor não define uma
+    uint32_t baudrate_atual;
+    uint32_t baudrate_maximo;    // Teto aplicado a todas as transações (0 = sem teto)
+
+    // Fila circular de descritores (índices manipulados com interrupções desligadas)
+    i2c_transacao_t *fila[I2C_FILA_TAM];
+    uint8_t cabeca, cauda, ocupados;
+
+    // Transação em andamento
+    i2c_transacao_t *atual;
+    uint16_t cmds_enviados;      // Comandos já colocados na FIFO de TX
+    uint16_t bytes_lidos;
+    alarm_id_t alarme_prazo;
+
+    // Barramento feito no PIO (pio == NULL: bloco I2C de hardware)
+    PIO pio;
+    uint8_t sm, offset_pio;
+    uint32_t clk_sys_hz;         // O divisor do PIO depende do clk_sys
+    uint16_t bytes_recebidos;    // A FIFO de RX também traz o eco dos bytes escritos
+    bool nack_pio;
+
+    // Estatísticas
+    uint32_t total_ok, total_nack, total_timeout, total_recuperacoes;
+} i2c_barramento_t;
+
+// Configura pinos, controlador e interrupção de um barramento
+void i2c_barramento_init(i2c_barramento_t *bar, i2c_inst_t *i2c, uint sda_pin, uint scl_pin, uint32_t baudrate);
+
+// Configura um barramento numa SM livre do bloco `pio`, com SDA em `sda_pin` e SCL
+// no pino seguinte. Retorna false se não houver SM ou espaço para o programa.
+bool i2c_barramento_init_pio(i2c_barramento_t *bar, PIO pio, uint sda_pin, uint32_t baudrate);
+
+// Enfileira uma transação; retorna false (status FILA_CHEIA) se não houver espaço
+bool i2c_barramento_enfileirar(i2c_barramento_t *bar, i2c_transacao_t *transacao);
+
+// Enfileira e aguarda a conclusão. Não deve ser chamada de dentro de interrupções.
+i2c_status_t i2c_barramento_transferir(i2c_barramento_t *bar, uint8_t endereco, uint32_t baudrate,
+                                       const uint8_t *escrita, uint16_t tam_escrita,
+                                       uint8_t *leitura, uint16_t tam_leitura);
+
+// Aguarda o fim de uma transação enfileirada e devolve o status final.
+// Não deve ser chamada de dentro de interrupções.
+i2c_status_t i2c_barramento_aguardar(const i2c_transacao_t *transacao);
+
+// Limita a velocidade de todas as transações seguintes (0 remove o limite)
+void i2c_barramento_limitar_baudrate(i2c_barramento_t *bar, uint32_t baudrate_maximo);
+
+// Indica se há transação em andamento ou na fila
+bool i2c_barramento_ocupado(const i2c_barramento_t *bar);
+
+// Libera um barramento travado (SDA preso em nível baixo) pulsando SCL manualmente
+void i2c_barramento_recuperar(i2c_barramento_t *bar);
+
+// Avisa o barramento de uma mudança do clk_sys (mesma assinatura de energia_callback_clock_t).
+// Antes da mudança espera a fila esvaziar; depois recalcula o divisor do PIO.
+// Nada a fazer nos blocos de hardware, que usam clk_peri.
+void i2c_barramento_mudanca_clock(i2c_barramento_t *bar, bool antes, uint32_t clk_sys_hz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // I2C_BARRAMENTO_H
@@ -0,0 +1,205 @@
+#include "parametros.h"
+#include <string.h>
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+
+// Último setor da flash, longe do programa
+#define PARAMETROS_OFFSET_FLASH (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+
+/* ---------- Registro gravado na flash ---------- */
+typedef struct {
+    uint32_t magico;
+    uint16_t versao;
+    uint16_t tamanho;                  // sizeof(parametros_t) na gravação
+    parametros_t dados;
+    uint32_t crc;                      // CRC32 de todos os campos anteriores
+} registro_parametros_t;
+
+static const parametros_t padrao = {
+    .lux_min = 20,
+    .lux_max = 100,
+    .intervalo_ms = 300,
+    .i2c_sensores_khz = 400,
+    .i2c_display_khz = 400,
+    .gy33_atime = 0xF5,
+    .gy33_ganho = 0,
+    .brilho_lux = {50, 300, 1000},
+    .cor = LIMIARES_COR_PADRAO,
+    .alarme_histerese = 2,
+    .alarme_espera_ms = 10000,
+    .alarme_taxa_lux_s = 15.0f,
+    .alarme_desvio_z = 4.0f,
+    .alarme_desvio_min = 5.0f,
+};
+
+#define INT(campo, min, max, desc)   { #campo, PARAMETRO_INT, offsetof(parametros_t, campo), min, max, desc }
+#define FLOAT(campo, min, max, desc) { #campo, PARAMETRO_FLOAT, offsetof(parametros_t, cor.campo), min, max, desc }
+
+static const parametro_t tabela[] = {
+    INT(lux_min, 0, 65535, "Lux abaixo disso dispara o alerta"),
+    INT(lux_max, 0, 65535, "Lux acima disso dispara o alerta"),
+    INT(intervalo_ms, 20, 10000, "Espera entre amostras (ms)"),
+    INT(i2c_sensores_khz, 10, 1000, "Teto do I2C dos sensores (kHz)"),
+    INT(i2c_display_khz, 10, 1000, "Teto do I2C do display (kHz)"),
+    INT(gy33_atime, 0, 255, "ATIME do GY-33: (256 - x) x 2,4 ms"),
+    INT(gy33_ganho, 0, 3, "Ganho do GY-33: 0=1x 1=4x 2=16x 3=60x"),
+    { "brilho_lux1", PARAMETRO_INT, offsetof(parametros_t, brilho_lux[0]), 0, 65535, "Fim da faixa de brilho máximo" },
+    { "brilho_lux2", PARAMETRO_INT, offsetof(parametros_t, brilho_lux[1]), 0, 65535, "Fim da faixa de brilho médio" },
+    { "brilho_lux3", PARAMETRO_INT, offsetof(parametros_t, brilho_lux[2]), 0, 65535, "Acima disso, brilho mínimo" },
+    FLOAT(c_escuro, 0, 65535, "Intensidade mínima para classificar"),
+    FLOAT(rg_vermelho, 0, 10, "R/G acima disso: vermelho/laranja"),
+    FLOAT(rg_amarelo, 0, 10, "R/G acima disso: amarelo/ouro"),
+    FLOAT(bn_laranja, 0, 1, "B normalizado abaixo disso: laranja"),
+    FLOAT(c_ouro, 0, 65535, "Intensidade acima disso: ouro"),
+    FLOAT(bn_violeta, 0, 1, "Violeta: B normalizado mínimo"),
+    FLOAT(rn_violeta, 0, 1, "Violeta: R normalizado mínimo"),
+    FLOAT(gn_violeta, 0, 1, "Violeta: G normalizado máximo"),
+    FLOAT(rg_marrom, 0, 10, "Marrom: R/G mínimo"),
+    FLOAT(c_marrom, 0, 65535, "Marrom: intensidade máxima"),
+    FLOAT(tol_neutro, 0, 1, "Tolerância entre canais de um cinza"),
+    FLOAT(c_branco, 0, 65535, "Intensidade mínima do branco"),
+    FLOAT(c_prata, 0, 65535, "Intensidade mínima da prata"),
+    FLOAT(c_cinza, 0, 65535, "Intensidade mínima do cinza"),
+    INT(alarme_histerese, 0, 1000, "Folga para desfazer o alarme de lux baixo/alto"),
+    INT(alarme_espera_ms, 0, 600000, "Espera entre disparos da mesma regra (ms)"),
+    { "alarme_taxa_lux_s", PARAMETRO_FLOAT, offsetof(parametros_t, alarme_taxa_lux_s), 0, 100000, "Variação acima disso dispara (lux/s, 0 desliga)" },
+    { "alarme_desvio_z", PARAMETRO_FLOAT, offsetof(parametros_t, alarme_desvio_z), 0, 100, "Desvios da média que disparam (0 desliga)" },
+    { "alarme_desvio_min", PARAMETRO_FLOAT, offsetof(parametros_t, alarme_desvio_min), 0, 65535, "Piso do desvio padrão da janela (lux)" },
+};
+
+#define NUM_PARAMETROS (sizeof(tabela) / sizeof(tabela[0]))
+
+parametros_t parametros;
+static void (*ao_aplicar)(void) = NULL;
+static bool da_flash = false;
+
+// --- Funções Internas ---
+
+static uint32_t crc32(const uint8_t *dados, size_t tamanho) {
+    uint32_t crc = 0xFFFFFFFFu;
+    while (tamanho--) {
+        crc ^= *dados++;
+        for (int i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1u));
+    }
+    return ~crc;
+}
+
+// Regras entre parâmetros; NULL se o conjunto é coerente
+static const char *validar(const parametros_t *p) {
+    if (p->lux_min >= p->lux_max) return "lux_min deve ser menor que lux_max";
+    // As faixas de brilho dividem por (fim - início - 1)
+    if (p->brilho_lux[1] <= p->brilho_lux[0] + 1 || p->brilho_lux[2] <= p->brilho_lux[1] + 1) {
+        return "brilho_lux1 < brilho_lux2 < brilho_lux3, com folga de 2";
+    }
+    if (p->cor.rg_amarelo >= p->cor.rg_vermelho) return "rg_amarelo deve ser menor que rg_vermelho";
+    if (!(p->cor.c_cinza < p->cor.c_prata && p->cor.c_prata < p->cor.c_branco)) {
+        return "c_cinza < c_prata < c_branco";
+    }
+    if (p->alarme_histerese >= p->lux_max - p->lux_min) return "alarme_histerese deve ser menor que lux_max - lux_min";
+    return NULL;
+}
+
+static void aplicar(void) {
+    if (ao_aplicar) ao_aplicar();
+}
+
+// --- Funções Públicas ---
+
+void parametros_init(void) {
+    const registro_parametros_t *gravado = (const registro_parametros_t *)(XIP_BASE + PARAMETROS_OFFSET_FLASH);
+    da_flash = gravado->magico == PARAMETROS_MAGICO &&
+               gravado->versao == PARAMETROS_VERSAO &&
+               gravado->tamanho == sizeof(parametros_t) &&
+               gravado->crc == crc32((const uint8_t *)gravado, offsetof(registro_parametros_t, crc)) &&
+               validar(&gravado->dados) == NULL;
+    parametros = da_flash ? gravado->dados : padrao;
+}
+
+void parametros_registrar_aplicacao(void (*aplicar_cb)(void)) {
+    ao_aplicar = aplicar_cb;
+}
+
+const parametro_t *parametros_tabela(size_t *quantidade) {
+    *quantidade = NUM_PARAMETROS;
+    return tabela;
+}
+
+const parametro_t *parametros_buscar(const char *nome) {
+    for (size_t i = 0; i < NUM_PARAMETROS; i++) {
+        if (strcmp(tabela[i].nome, nome) == 0) return &tabela[i];
+    }
+    return NULL;
+}
+
+float parametros_obter(const parametro_t *p) {
+    const uint8_t *base = (const uint8_t *)&parametros + p->deslocamento;
+    return p->tipo == PARAMETRO_INT ? (float)*(const int32_t *)base : *(const float *)base;
+}
+
+const char *parametros_definir(const parametro_t *p, float valor) {
+    if (valor < p->minimo || valor > p->maximo) return "fora da faixa";
+    if (p->tipo == PARAMETRO_INT && valor != (float)(int32_t)valor) return "valor deve ser inteiro";
+
+    parametros_t novo = parametros;
+    uint8_t *base = (uint8_t *)&novo + p->deslocamento;
+    if (p->tipo == PARAMETRO_INT) {
+        *(int32_t *)base = (int32_t)valor;
+    } else {
+        *(float *)base = valor;
+    }
+    const char *erro = validar(&novo);
+    if (erro) return erro;
+
+    parametros = novo;
+    aplicar();
+    return NULL;
+}
+
+void parametros_restaurar_padrao(void) {
+    parametros = padrao;
+    aplicar();
+}
+
+bool parametros_salvar(void) {
+    // A gravação é feita em páginas inteiras
+    static uint8_t pagina[(sizeof(registro_parametros_t) + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE];
+    registro_parametros_t registro = {
+        .magico = PARAMETROS_MAGICO,
+        .versao = PARAMETROS_VERSAO,
+        .tamanho = sizeof(parametros_t),
+        .dados = parametros,
+    };
+    registro.crc = crc32((const uint8_t *)&registro, offsetof(registro_parametros_t, crc));
+    memset(pagina, 0xFF, sizeof(pagina));
+    memcpy(pagina, &registro, sizeof(registro));
+
+    // Nada pode executar da flash durante o apagamento (inclusive interrupções)
+    uint32_t irqs = save_and_disable_interrupts();
+    flash_range_erase(PARAMETROS_OFFSET_FLASH, FLASH_SECTOR_SIZE);
+    flash_range_program(PARAMETROS_OFFSET_FLASH, pagina, sizeof(pagina));
+    restore_interrupts(irqs);
+
+    const registro_parametros_t *gravado = (const registro_parametros_t *)(XIP_BASE + PARAMETROS_OFFSET_FLASH);
+    return memcmp(gravado, &registro, sizeof(registro)) == 0;
+}
+
+bool parametros_carregados_da_flash(void) {
+    return da_flash;
+}
+
+void parametros_config_classificador(config_classificador_t *cfg) {
+    cfg->cor = parametros.cor;
+    cfg->lux_min = parametros.lux_min;
+    cfg->lux_max = parametros.lux_max;
+    memcpy(cfg->brilho_lux, parametros.brilho_lux, sizeof(cfg->brilho_lux));
+}
+
+void parametros_config_alarmes(config_alarmes_lux_t *cfg) {
+    cfg->lux_min = parametros.lux_min;
+    cfg->lux_max = parametros.lux_max;
+    cfg->histerese_lux = parametros.alarme_histerese;
+    cfg->taxa_max_lux_s = parametros.alarme_taxa_lux_s;
+    cfg->desvio_z = parametros.alarme_desvio_z;
+    cfg->desvio_min_lux = parametros.alarme_desvio_min;
+    cfg->espera_ms = (uint32_t)parametros.alarme_espera_ms;
+}
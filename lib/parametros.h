@@ -0,0 +1,77 @@
+#ifndef PARAMETROS_H
+#define PARAMETROS_H
+
+#include <stddef.h>
+#include "pico/stdlib.h"
+#include "classificador_cor.h"
+#include "alarmes_lux.h"
+
+/* ---------- Parâmetros ajustáveis em tempo de execução ----------
+ * Valores lidos pelo programa a cada uso; alterados pelo console e
+ * gravados no último setor da flash com número mágico, versão e CRC32. */
+
+#define PARAMETROS_MAGICO 0x4D524150u  // "PARM"
+#define PARAMETROS_VERSAO 2            // Mude quando parametros_t mudar de formato
+
+typedef struct {
+    int32_t lux_min;                   // Limites do alerta de luminosidade
+    int32_t lux_max;
+    int32_t intervalo_ms;              // Espera entre amostras
+    int32_t i2c_sensores_khz;          // Teto de velocidade de cada barramento
+    int32_t i2c_display_khz;
+    int32_t gy33_atime;                // Tempo de integração: (256 - atime) x 2,4 ms
+    int32_t gy33_ganho;                // 0-3 = 1x, 4x, 16x, 60x
+    int32_t brilho_lux[3];             // Faixas de brilho da matriz (obter_grb_pelo_nome)
+    limiares_cor_t cor;                // Limiares de identificar_cor
+    int32_t alarme_histerese;          // Regras do motor de alarmes de lux (alarmes_lux.h)
+    int32_t alarme_espera_ms;
+    float alarme_taxa_lux_s;
+    float alarme_desvio_z;
+    float alarme_desvio_min;
+} parametros_t;
+
+typedef enum {
+    PARAMETRO_INT,
+    PARAMETRO_FLOAT,
+} tipo_parametro_t;
+
+/* ---------- Descritor de um parâmetro da tabela ---------- */
+typedef struct {
+    const char *nome;
+    tipo_parametro_t tipo;
+    size_t deslocamento;               // offsetof(parametros_t, campo)
+    float minimo, maximo;
+    const char *descricao;
+} parametro_t;
+
+extern parametros_t parametros;
+
+// Carrega os valores gravados na flash ou, se não houver gravação válida, os padrões
+void parametros_init(void);
+
+// Chamada depois de cada alteração (set, defaults) para repassar valores ao hardware
+void parametros_registrar_aplicacao(void (*aplicar)(void));
+
+const parametro_t *parametros_tabela(size_t *quantidade);
+const parametro_t *parametros_buscar(const char *nome);
+float parametros_obter(const parametro_t *p);
+
+// Valida e aplica; retorna NULL em caso de sucesso ou a mensagem de erro
+const char *parametros_definir(const parametro_t *p, float valor);
+
+// Volta aos padrões de compilação (na RAM; use parametros_salvar para gravar)
+void parametros_restaurar_padrao(void);
+
+// Grava os valores atuais no último setor da flash
+bool parametros_salvar(void);
+
+// Indica se os valores atuais vieram da flash na inicialização
+bool parametros_carregados_da_flash(void);
+
+// Copia os campos usados por classificador_processar()
+void parametros_config_classificador(config_classificador_t *cfg);
+
+// Copia os campos usados por alarmes_lux_atualizar()
+void parametros_config_alarmes(config_alarmes_lux_t *cfg);
+
+#endif // PARAMETROS_H
@@ -0,0 +1,116 @@
+#include "saude.h"
+#include "hardware/watchdog.h"
+
+#define SAUDE_MAGICO 0x5A0D0000u   // Parte alta de scratch[0]: a foto é desta versão do firmware
+
+static const char *const nomes_etapas[NUM_ETAPAS] = {
+    "inicio", "sensor de cor", "sensor de luz", "cintilacao", "classificacao", "matriz",
+    "alerta", "display", "botoes", "relatorio", "ocioso",
+};
+
+static saude_estatisticas_t estatisticas;
+static foto_falha_t foto_reinicio;
+static uint32_t inicio_iteracao_us;
+static marca_etapa_t marca_atual = { ETAPA_INICIO, SAUDE_SEM_BARRAMENTO };
+
+// --- Funções Internas ---
+
+static uint32_t indice_faixa(uint32_t valor) {
+    const uint32_t sub = 1u << HISTOGRAMA_SUBFAIXAS_BITS;
+    if (valor < sub) return valor;                       // Faixa linear: valores exatos
+    uint32_t msb = 31 - __builtin_clz(valor);
+    if (msb >= HISTOGRAMA_MAX_BITS) return HISTOGRAMA_NUM_FAIXAS - 1;
+    uint32_t resto = (valor >> (msb - HISTOGRAMA_SUBFAIXAS_BITS)) & (sub - 1);
+    return ((msb - HISTOGRAMA_SUBFAIXAS_BITS + 1) << HISTOGRAMA_SUBFAIXAS_BITS) + resto;
+}
+
+// Maior valor que cai na faixa
+static uint32_t limite_faixa(uint32_t indice) {
+    const uint32_t sub = 1u << HISTOGRAMA_SUBFAIXAS_BITS;
+    if (indice < sub) return indice;
+    uint32_t msb = (indice >> HISTOGRAMA_SUBFAIXAS_BITS) + HISTOGRAMA_SUBFAIXAS_BITS - 1;
+    uint32_t resto = indice & (sub - 1);
+    uint32_t largura = 1u << (msb - HISTOGRAMA_SUBFAIXAS_BITS);
+    return (1u << msb) + (resto + 1) * largura - 1;
+}
+
+// --- Funções Públicas ---
+
+void histograma_adicionar(histograma_t *h, uint32_t valor) {
+    h->contagem[indice_faixa(valor)]++;
+    h->total++;
+    if (valor > h->maximo) h->maximo = valor;
+}
+
+uint32_t histograma_percentil(const histograma_t *h, float fracao) {
+    if (h->total == 0) return 0;
+    uint32_t alvo = (uint32_t)(fracao * h->total + 0.5f);
+    if (alvo == 0) alvo = 1;
+    uint32_t acumulado = 0;
+    for (uint32_t i = 0; i < HISTOGRAMA_NUM_FAIXAS; i++) {
+        acumulado += h->contagem[i];
+        if (acumulado >= alvo) {
+            uint32_t limite = limite_faixa(i);
+            return limite < h->maximo ? limite : h->maximo;
+        }
+    }
+    return h->maximo;
+}
+
+void saude_init(void) {
+    // Só resets do próprio watchdog (não watchdog_reboot) deixam uma foto confiável
+    if (watchdog_enable_caused_reboot() && (watchdog_hw->scratch[0] & 0xFFFF0000u) == SAUDE_MAGICO) {
+        foto_reinicio = (foto_falha_t){
+            .valida = true,
+            .etapa = (etapa_laco_t)(watchdog_hw->scratch[0] & 0xFFFFu),
+            .barramento = (barramento_etapa_t)watchdog_hw->scratch[1],
+            .instante_us = watchdog_hw->scratch[2],
+            .iteracao = watchdog_hw->scratch[3],
+        };
+        if (foto_reinicio.etapa >= NUM_ETAPAS) foto_reinicio.etapa = ETAPA_INICIO;
+    }
+    saude_etapa(ETAPA_INICIO, SAUDE_SEM_BARRAMENTO);
+    watchdog_enable(SAUDE_WATCHDOG_MS, true); // Pausa durante a depuração
+}
+
+marca_etapa_t saude_etapa(etapa_laco_t etapa, barramento_etapa_t barramento) {
+    marca_etapa_t anterior = marca_atual;
+    marca_atual = (marca_etapa_t){ etapa, barramento };
+    watchdog_hw->scratch[0] = SAUDE_MAGICO | etapa;
+    watchdog_hw->scratch[1] = barramento;
+    watchdog_hw->scratch[2] = time_us_32();
+    watchdog_hw->scratch[3] = estatisticas.iteracoes;
+    return anterior;
+}
+
+void saude_retomar(marca_etapa_t marca) {
+    saude_etapa(marca.etapa, marca.barramento);
+}
+
+void saude_inicio_iteracao(void) {
+    inicio_iteracao_us = time_us_32();
+}
+
+void saude_fim_iteracao(void) {
+    uint32_t trabalho = time_us_32() - inicio_iteracao_us;
+    histograma_adicionar(&estatisticas.trabalho_us, trabalho);
+    if (trabalho > SAUDE_PRAZO_ITERACAO_MS * 1000u) estatisticas.prazos_perdidos++;
+    estatisticas.iteracoes++;
+    watchdog_update();
+}
+
+void saude_alimentar(void) {
+    watchdog_update();
+}
+
+foto_falha_t saude_foto_reinicio(void) {
+    return foto_reinicio;
+}
+
+const char *saude_nome_etapa(etapa_laco_t etapa) {
+    return etapa < NUM_ETAPAS ? nomes_etapas[etapa] : "?";
+}
+
+const saude_estatisticas_t *saude_estatisticas(void) {
+    return &estatisticas;
+}
@@ -0,0 +1,97 @@
+#ifndef SAUDE_H
+#define SAUDE_H
+
+#include "pico/stdlib.h"
+
+/* ---------- Monitor de saúde do laço principal ----------
+ * O watchdog de hardware reinicia a placa se o laço parar de alimentá-lo.
+ * Cada etapa anota nos registradores scratch[0..3] do watchdog (que
+ * sobrevivem ao reset) a etapa, o barramento e o instante de entrada; após
+ * um reset pelo watchdog essa foto é recuperada e impressa. O tempo de
+ * trabalho de cada iteração vai para um histograma logarítmico. */
+
+#define SAUDE_WATCHDOG_MS        3000  // Sem alimentar por este tempo: reset
+#define SAUDE_PRAZO_ITERACAO_MS  1000  // Trabalho de uma iteração acima disso conta como prazo perdido
+#define SAUDE_FATIA_ESPERA_MS    1000  // Esperas longas são fatiadas para alimentar o watchdog
+
+// Histograma com 8 sub-faixas por potência de 2 (erro relativo < 12,5%), de 1 us a ~134 s
+#define HISTOGRAMA_SUBFAIXAS_BITS 3
+#define HISTOGRAMA_MAX_BITS       27
+#define HISTOGRAMA_NUM_FAIXAS     ((HISTOGRAMA_MAX_BITS - HISTOGRAMA_SUBFAIXAS_BITS + 1) << HISTOGRAMA_SUBFAIXAS_BITS)
+
+typedef enum {
+    ETAPA_INICIO = 0,
+    ETAPA_SENSOR_COR,
+    ETAPA_SENSOR_LUX,
+    ETAPA_CINTILACAO,
+    ETAPA_CLASSIFICACAO,
+    ETAPA_MATRIZ,
+    ETAPA_ALERTA,
+    ETAPA_DISPLAY,
+    ETAPA_BOTOES,
+    ETAPA_RELATORIO,
+    ETAPA_OCIOSO,
+    NUM_ETAPAS
+} etapa_laco_t;
+
+typedef enum {
+    SAUDE_SEM_BARRAMENTO = 0,
+    SAUDE_BARRAMENTO_SENSORES,
+    SAUDE_BARRAMENTO_DISPLAY,
+    SAUDE_BARRAMENTO_LUZ_PIO,    // BH1750 no barramento do PIO (SENSOR_LUZ_NO_PIO)
+} barramento_etapa_t;
+
+// Etapa e barramento em curso (para retomar depois de um desvio, ex.: redesenho por botão)
+typedef struct {
+    etapa_laco_t etapa;
+    barramento_etapa_t barramento;
+} marca_etapa_t;
+
+/* ---------- Foto gravada nos registradores scratch ---------- */
+typedef struct {
+    bool valida;
+    etapa_laco_t etapa;
+    barramento_etapa_t barramento;
+    uint32_t instante_us;        // time_us_32() na entrada da etapa
+    uint32_t iteracao;
+} foto_falha_t;
+
+typedef struct {
+    uint32_t contagem[HISTOGRAMA_NUM_FAIXAS];
+    uint32_t total;
+    uint32_t maximo;
+} histograma_t;
+
+typedef struct {
+    histograma_t trabalho_us;    // Tempo de trabalho por iteração (sem a espera final)
+    uint32_t iteracoes;
+    uint32_t prazos_perdidos;
+} saude_estatisticas_t;
+
+// Recupera a foto de um reset anterior e liga o watchdog
+void saude_init(void);
+
+// Marca a entrada numa etapa; retorna a marca anterior
+marca_etapa_t saude_etapa(etapa_laco_t etapa, barramento_etapa_t barramento);
+
+// Volta à etapa devolvida por saude_etapa()
+void saude_retomar(marca_etapa_t marca);
+
+// Início e fim do trabalho de uma iteração (o fim alimenta o watchdog e atualiza o histograma)
+void saude_inicio_iteracao(void);
+void saude_fim_iteracao(void);
+
+// Alimenta o watchdog durante esperas longas
+void saude_alimentar(void);
+
+// Foto do reset pelo watchdog que precedeu esta execução (valida = false se não houve)
+foto_falha_t saude_foto_reinicio(void);
+const char *saude_nome_etapa(etapa_laco_t etapa);
+
+const saude_estatisticas_t *saude_estatisticas(void);
+
+// Valor abaixo do qual estão `fracao` (0-1) das amostras (limite superior da faixa)
+uint32_t histograma_percentil(const histograma_t *h, float fracao);
+void histograma_adicionar(histograma_t *h, uint32_t valor);
+
+#endif // SAUDE_H
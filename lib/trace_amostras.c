@@ -0,0 +1,18 @@
+#include "trace_amostras.h"
+#include <stdio.h>
+
+static bool ligado = false;
+
+void trace_amostras_ligar(bool ligar) {
+    if (ligar && !ligado) printf("@trace %d\n", TRACE_AMOSTRAS_VERSAO);
+    ligado = ligar;
+}
+
+bool trace_amostras_ligado(void) {
+    return ligado;
+}
+
+void trace_amostras_registrar(const amostra_sensores_t *a) {
+    if (!ligado) return;
+    printf("@s %lu %u %u %u %u %u\n", (unsigned long)time_us_32(), a->r, a->g, a->b, a->c, a->lux);
+}
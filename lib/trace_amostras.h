@@ -0,0 +1,22 @@
+#ifndef TRACE_AMOSTRAS_H
+#define TRACE_AMOSTRAS_H
+
+#include "pico/stdlib.h"
+#include "classificador_cor.h"
+
+/* ---------- Gravação das amostras brutas pela USB ----------
+ * Com o trace ligado (comando "trace on" do console) cada amostra sai numa
+ * linha própria, misturada ao resto do log:
+ *   @trace <versao>                     cabeçalho, a cada vez que é ligado
+ *   @s <t_us> <r> <g> <b> <c> <lux>     uma amostra
+ * tools/replay lê só as linhas que começam com '@' e ignora o resto. */
+
+#define TRACE_AMOSTRAS_VERSAO 1
+
+void trace_amostras_ligar(bool ligado);
+bool trace_amostras_ligado(void);
+
+// Imprime a amostra se o trace estiver ligado
+void trace_amostras_registrar(const amostra_sensores_t *a);
+
+#endif // TRACE_AMOSTRAS_H
@@ -3,14 +3,31 @@
 #include <string.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "i2c_barramento.h"
 #include "bh1750_light_sensor.h"
 #include "hardware/gpio.h"
 #include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "pico/stdio_usb.h"
+#include "tusb.h"
 
 // Nossas bibliotecas de hardware
 #include "ssd1306.h"
 #include "matriz_led.h"
+#include "matriz_compositor.h"
 #include "gy33.h"
+#include "energia.h"
+#include "historico_lux.h"
+#include "botoes.h"
+#include "parametros.h"
+#include "console.h"
+#include "saude.h"
+#include "classificador_cor.h"
+#include "trace_amostras.h"
+#include "espelho.h"
+#include "captura_adc.h"
+#include "cintilacao.h"
+#include "alarmes_lux.h"
 
 // =============================================================================
 // Definições do Hardware e Constantes do Projeto
@@ -28,26 +45,68 @@
 #define I2C1_SDA_PIN 14       // Pino SDA do I2C1
 #define I2C1_SCL_PIN 15       // Pino SCL do I2C1
 
-// --- NOVAS CONSTANTES PARA OS LIMITES DE LUZ ---
-#define LIMITE_LUZ_INFERIOR 20
-#define LIMITE_LUZ_SUPERIOR 100
+// BH1750 num terceiro barramento I2C feito no PIO (SCL no pino seguinte ao SDA),
+// lido ao mesmo tempo que o GY-33. 0 = os dois sensores no I2C0.
+#define SENSOR_LUZ_NO_PIO 0
+#define PIO_I2C_BLOCO pio1    // pio0 fica com o WS2812
+#define PIO_I2C_SDA_PIN 2     // SCL no GPIO 3
+
+// Limites de luz, intervalo entre amostras, velocidades do I2C, integração do GY-33,
+// faixas de brilho e limiares de cor ficam em `parametros` (ajustáveis pelo console)
+
+// --- TELAS E GRÁFICO DE HISTÓRICO ---
+#define NUM_TELAS 5
+#define TELA_HISTORICO 3                  // Gráfico rolante de Lux
+#define TELA_CINTILACAO 4                 // Cintilação medida pelo fotodiodo no ADC
+#define HISTORICO_AMOSTRAS_POR_COLUNA 1   // Janela = 128 colunas × N amostras × intervalo_ms
+#define HISTORICO_ESCALA_LUX 200          // Lux correspondente ao topo do gráfico
+#define HISTORICO_PAGINA_INICIAL 2        // Páginas 0-1: cabeçalho fixo; 2-7: gráfico
+#define HISTORICO_Y_TOPO (HISTORICO_PAGINA_INICIAL * 8)
+
+// --- MODO DE BAIXO CONSUMO ---
+#define MODO_BAIXO_CONSUMO_PADRAO true // Sensores desligados e clk_sys reduzido entre amostras
+#define RELATORIO_ENERGIA_AMOSTRAS 20  // Imprime os contadores de energia a cada N amostras
+
+// --- INICIALIZAÇÃO RÁPIDA ---
+#define BOOT_RAPIDO true                // false: esperas fixas de 2 s pela USB e 1,5 s na tela de boas-vindas
+#define BOOT_ENUMERACAO_USB_MS 300      // Sem enumeração nesse tempo não há computador (bateria ou carregador)
+#define BOOT_ESPERA_TERMINAL_MS 1500    // Com computador, tempo para abrir o terminal antes das primeiras mensagens
+
+// --- ÚLTIMA AMOSTRA (redesenho imediato ao trocar de tela) ---
+typedef struct {
+    uint16_t r, g, b, c, lux;
+    const char *nome_da_cor;
+    bool cintilacao_valida;              // Já há um bloco do ADC analisado
+    cintilacao_resultado_t cintilacao;
+} amostra_t;
+
+// --- LATÊNCIA BOTÃO → PIXEL ---
+typedef struct {
+    uint32_t eventos;
+    uint32_t ultima_us;
+    uint32_t max_us;
+    uint64_t soma_us;
+} latencia_botoes_t;
 
 // Variáveis Globais
-volatile int estado_display = 0;           // 0 = RGB, 1 = Normalizado, 2 = Lux
-volatile uint32_t ultimo_tempo_clique = 0; // Debounce dos botões
-
-// Função de interrupção dos botões
-void tratar_interrupcao_gpio(uint gpio, uint32_t events) {
-    uint32_t tempo_atual = to_ms_since_boot(get_absolute_time());
-    if (tempo_atual - ultimo_tempo_clique < 250) return;
-    ultimo_tempo_clique = tempo_atual;
-
-    if (gpio == BOTAO_B_PIN) {
-        estado_display = (estado_display + 1) % 3; // Próxima tela
-    } else if (gpio == BOTAO_A_PIN) {
-        estado_display = (estado_display - 1 + 3) % 3; // Tela anterior
-    }
-}
+int estado_display = 0;                    // 0 = RGB, 1 = Normalizado, 2 = Lux, 3 = Histórico, 4 = Cintilação
+int tela_anterior = -1;                    // Última tela enviada ao display
+i2c_barramento_t barramento_sensores;      // Fila de transações do I2C0
+i2c_barramento_t barramento_display;       // Fila de transações do I2C1
+i2c_barramento_t barramento_luz_pio;       // Fila de transações do I2C feito no PIO
+i2c_barramento_t *barramento_luz = &barramento_sensores; // Barramento do BH1750
+historico_lux_t historico_lux;             // Colunas min/max do gráfico de Lux
+alarmes_lux_t alarmes_lux;                 // Janela e regras dos alarmes de luminosidade
+ssd1306_t display;
+amostra_t ultima_amostra = { .nome_da_cor = "---" };
+latencia_botoes_t latencia_botoes;
+bool historico_coluna_pendente = false;    // Coluna nova ainda não rolada para o display
+bool medicao_lux_em_andamento = false;     // BH1750 medindo (iniciada na inicialização ou em ler_sensores)
+absolute_time_t medicao_lux_pronta;        // Quando o resultado da medição pode ser lido
+bool cor_sem_integracao = false;           // GY-33 religado e ainda sem integração lida
+absolute_time_t cor_ligada_em;             // Quando o ADC do GY-33 foi religado
+
+void esperar_atendendo_eventos(uint32_t duracao_ms, bool reduzir_clock);
 
 // Inicializa o pino do buzzer para PWM
 void inicializar_buzzer() {
@@ -61,18 +120,18 @@ void inicializar_buzzer() {
 void tocar_nota(uint frequencia, uint duracao_ms) {
     if (frequencia == 0) {
         pwm_set_gpio_level(BUZZER_PIN, 0);
-        sleep_ms(duracao_ms);
+        esperar_atendendo_eventos(duracao_ms, false);
         return;
     }
     uint num_slice = pwm_gpio_to_slice_num(BUZZER_PIN);
-    uint32_t clock_sistema = 125000000;
+    uint32_t clock_sistema = clock_get_hz(clk_sys); // Muda quando o modo de baixo consumo escala o clock
     uint32_t divisor16 = clock_sistema / frequencia / 4096 + (clock_sistema % (frequencia * 4096) != 0);
     if (divisor16 / 16 == 0) divisor16 = 16;
     uint32_t limite_wrap = clock_sistema * 16 / divisor16 / frequencia - 1;
     pwm_set_clkdiv_int_frac(num_slice, divisor16 / 16, divisor16 & 0xF);
     pwm_set_wrap(num_slice, limite_wrap);
     pwm_set_gpio_level(BUZZER_PIN, limite_wrap / 2);
-    sleep_ms(duracao_ms);
+    esperar_atendendo_eventos(duracao_ms, false); // clk_sys fixo: a nota depende dele
     pwm_set_gpio_level(BUZZER_PIN, 0);
 }
 
@@ -86,14 +145,19 @@ void tocar_alerta_limite_lux() {
     tocar_nota(3500, 400); 
 }
 
+// Variação brusca ou desvio da média: dois bipes curtos, distintos do alerta de limite
+void tocar_alerta_variacao_lux() {
+    tocar_nota(2500, 80); tocar_nota(0, 60); tocar_nota(2500, 80);
+}
+
 // Alerta sonoro para cada cor detectada
 void tocar_alerta_cor(const char *nome_da_cor) {
     if (strcmp(nome_da_cor, "Vermelho") == 0) {
-        tocar_nota(1500, 100); sleep_ms(50); tocar_nota(1500, 100);
+        tocar_nota(1500, 100); tocar_nota(0, 50); tocar_nota(1500, 100);
     } else if (strcmp(nome_da_cor, "Laranja") == 0) {
         tocar_nota(1200, 200);
     } else if (strcmp(nome_da_cor, "Amarelo") == 0) {
-        tocar_nota(1000, 75); sleep_ms(50); tocar_nota(1000, 75);
+        tocar_nota(1000, 75); tocar_nota(0, 50); tocar_nota(1000, 75);
     }
     // Outras cores podem ser adicionadas se necessário
 }
@@ -116,108 +180,501 @@ void desenhar_tela_lux(ssd1306_t *display, uint16_t lux) {
     ssd1306_draw_string(display, str_lux, 15, 25, false);
 
     // Verifica os limites e define a mensagem de status
-    if (lux < LIMITE_LUZ_INFERIOR) {
+    if (lux < parametros.lux_min) {
         sprintf(str_status, "Status: MUITO BAIXO!");
-    } else if (lux > LIMITE_LUZ_SUPERIOR) {
+    } else if (lux > parametros.lux_max) {
         sprintf(str_status, "Status: MUITO ALTO!");
     } else {
-        sprintf(str_status, "Status: OK (20-100)");
+        // A tabela de parâmetros limita os dois a 0-65535: cabem em 5 dígitos cada
+        snprintf(str_status, sizeof(str_status), "Status: OK (%u-%u)",
+                 (uint16_t)parametros.lux_min, (uint16_t)parametros.lux_max);
     }
     ssd1306_draw_string(display, str_status, 10, 45, false);
 }
 
+// Desenha a tela de cintilação (percentual, índice e frequência dominante)
+void desenhar_tela_cintilacao(ssd1306_t *display, const amostra_t *a) {
+    char linha[32];
+    ssd1306_fill(display, false);
+    ssd1306_draw_string(display, "--- Cintilação ---", 5, 0, false);
+    if (!a->cintilacao_valida) {
+        ssd1306_draw_string(display, "Aguardando ADC...", 10, 30, false);
+        return;
+    }
+    const cintilacao_resultado_t *f = &a->cintilacao;
+    snprintf(linha, sizeof(linha), "Percentual: %u.%u%%", f->percentual_x10 / 10, f->percentual_x10 % 10);
+    ssd1306_draw_string(display, linha, 2, 16, false);
+    snprintf(linha, sizeof(linha), "Indice: %u.%03u", f->indice_x1000 / 1000, f->indice_x1000 % 1000);
+    ssd1306_draw_string(display, linha, 2, 28, false);
+    if (f->frequencia_hz) {
+        snprintf(linha, sizeof(linha), "Frequência: %u Hz", f->frequencia_hz);
+    } else {
+        snprintf(linha, sizeof(linha), "Frequência: -");
+    }
+    ssd1306_draw_string(display, linha, 2, 40, false);
+    snprintf(linha, sizeof(linha), "Nível ADC: %u", f->media);
+    ssd1306_draw_string(display, linha, 2, 52, false);
+}
+
+
+// Converte Lux na linha do gráfico (HISTORICO_ESCALA_LUX no topo, 0 na última linha)
+uint8_t lux_para_y(uint16_t lux) {
+    const uint8_t altura = SSD1306_HEIGHT - HISTORICO_Y_TOPO;
+    if (lux > HISTORICO_ESCALA_LUX) lux = HISTORICO_ESCALA_LUX;
+    return SSD1306_HEIGHT - 1 - (uint32_t)lux * (altura - 1) / HISTORICO_ESCALA_LUX;
+}
+
+// Desenha uma coluna do gráfico: barra do mínimo ao máximo e limites pontilhados
+void desenhar_coluna_historico(ssd1306_t *display, uint8_t x, const coluna_lux_t *coluna, uint32_t numero_coluna) {
+    ssd1306_vline(display, x, HISTORICO_Y_TOPO, SSD1306_HEIGHT - 1, false);
+    if (numero_coluna % 4 == 0) { // O pontilhado acompanha a coluna ao rolar
+        ssd1306_pixel(display, x, lux_para_y(parametros.lux_min), true);
+        ssd1306_pixel(display, x, lux_para_y(parametros.lux_max), true);
+    }
+    if (coluna) ssd1306_vline(display, x, lux_para_y(coluna->max), lux_para_y(coluna->min), true);
+}
+
+// Cabeçalho fixo (páginas 0-1) da tela de histórico
+void desenhar_cabecalho_historico(ssd1306_t *display, uint16_t lux, const char *nome_da_cor) {
+    char str_lux[24];
+    ssd1306_rect(display, 0, 0, SSD1306_WIDTH, HISTORICO_Y_TOPO, false, true);
+    sprintf(str_lux, "Lux: %d", lux);
+    ssd1306_draw_string(display, str_lux, 0, 0, false);
+    ssd1306_draw_string(display, nome_da_cor, 72, 0, false);
+    ssd1306_hline(display, 0, SSD1306_WIDTH - 1, HISTORICO_Y_TOPO - 2, true);
+}
+
+// Tela de histórico: redesenho completo só ao entrar na tela; depois, a cada coluna
+// nova, uma rolagem por hardware mais o envio da coluna da direita
+void atualizar_tela_historico(ssd1306_t *display, uint16_t lux, const char *nome_da_cor, bool nova_coluna, bool redesenhar) {
+    const uint8_t ultima_pagina = SSD1306_HEIGHT / 8 - 1;
+    desenhar_cabecalho_historico(display, lux, nome_da_cor);
+
+    if (redesenhar) {
+        // Colunas mais recentes alinhadas à direita
+        uint8_t n = historico_lux.quantidade;
+        for (uint8_t x = 0; x < SSD1306_WIDTH; ++x) {
+            int i = x - (SSD1306_WIDTH - n);
+            uint32_t numero = historico_lux.total_colunas - (SSD1306_WIDTH - x);
+            desenhar_coluna_historico(display, x, i >= 0 ? historico_lux_coluna(&historico_lux, i) : NULL, numero);
+        }
+        ssd1306_send_data(display);
+        return;
+    }
+
+    ssd1306_send_region(display, 0, HISTORICO_PAGINA_INICIAL - 1, 0, SSD1306_WIDTH - 1);
+    if (nova_coluna) {
+        ssd1306_scroll_column_left(display, HISTORICO_PAGINA_INICIAL, ultima_pagina);
+        desenhar_coluna_historico(display, SSD1306_WIDTH - 1,
+                                  historico_lux_coluna(&historico_lux, historico_lux.quantidade - 1),
+                                  historico_lux.total_colunas - 1);
+        ssd1306_send_region(display, HISTORICO_PAGINA_INICIAL, ultima_pagina, SSD1306_WIDTH - 1, SSD1306_WIDTH - 1);
+    }
+}
+
+// Desenha a tela pedida com os dados da amostra e envia ao display
+void desenhar_tela(int tela, const amostra_t *a) {
+    switch (tela) {
+    case 0:
+        desenhar_tela_rgb(&display, a->r, a->g, a->b, a->nome_da_cor);
+        break;
+    case 1:
+        desenhar_tela_normalizada(&display, a->r, a->g, a->b, a->nome_da_cor);
+        break;
+    case 2:
+        // Chamada da função de LUZ atualizada
+        desenhar_tela_lux(&display, a->lux);
+        break;
+    case TELA_HISTORICO:
+        // Faz o próprio envio, incremental
+        atualizar_tela_historico(&display, a->lux, a->nome_da_cor, historico_coluna_pendente, tela != tela_anterior);
+        historico_coluna_pendente = false;
+        break;
+    case TELA_CINTILACAO:
+        desenhar_tela_cintilacao(&display, a);
+        break;
+    }
+    if (tela != TELA_HISTORICO) ssd1306_send_data(&display);
+    tela_anterior = tela;
+}
+
+// Aplica as pressões da fila e redesenha na hora a nova tela com a última amostra
+void atender_botoes() {
+    evento_botao_t evento;
+    bool trocou = false;
+    uint32_t primeira_borda_us = 0;
+    while (botoes_proximo_evento(&evento)) {
+        if (evento.gpio == BOTAO_B_PIN) {
+            estado_display = (estado_display + 1) % NUM_TELAS; // Próxima tela
+        } else if (evento.gpio == BOTAO_A_PIN) {
+            estado_display = (estado_display - 1 + NUM_TELAS) % NUM_TELAS; // Tela anterior
+        }
+        if (!trocou) primeira_borda_us = evento.instante_us;
+        trocou = true;
+    }
+    if (!trocou) return;
+
+    marca_etapa_t marca = saude_etapa(ETAPA_BOTOES, SAUDE_BARRAMENTO_DISPLAY);
+    desenhar_tela(estado_display, &ultima_amostra);
+    saude_retomar(marca);
+
+    // Latência da borda do botão até o último byte da tela sair no I2C
+    uint32_t latencia = time_us_32() - primeira_borda_us;
+    latencia_botoes.eventos++;
+    latencia_botoes.ultima_us = latencia;
+    latencia_botoes.soma_us += latencia;
+    if (latencia > latencia_botoes.max_us) latencia_botoes.max_us = latencia;
+}
+
+// Espera sem atrasar a troca de tela: cada pressão interrompe a espera, é atendida e a espera segue.
+// O console é lido, o espelho atualizado e o watchdog alimentado ao fim de cada trecho
+// (no máximo SAUDE_FATIA_ESPERA_MS, ou ESPELHO_INTERVALO_MS com o espelho ligado).
+void esperar_atendendo_eventos(uint32_t duracao_ms, bool reduzir_clock) {
+    absolute_time_t fim = make_timeout_time_ms(duracao_ms);
+    atender_botoes();
+    console_atender();
+    espelho_atender();
+    int64_t restante_us;
+    while ((restante_us = absolute_time_diff_us(get_absolute_time(), fim)) > 0) {
+        int64_t fatia_us = (espelho_ligado() ? ESPELHO_INTERVALO_MS : SAUDE_FATIA_ESPERA_MS) * 1000;
+        if (restante_us > fatia_us) restante_us = fatia_us;
+        if (reduzir_clock) {
+            energia_ocioso_ms((restante_us + 999) / 1000);
+        } else {
+            best_effort_wfe_or_timeout(make_timeout_time_us(restante_us));
+        }
+        saude_alimentar();
+        atender_botoes();
+        console_atender();
+        espelho_atender();
+    }
+}
+
+// Barramento do BH1750 para a foto do watchdog
+barramento_etapa_t barramento_etapa_luz() {
+    return barramento_luz == &barramento_sensores ? SAUDE_BARRAMENTO_SENSORES : SAUDE_BARRAMENTO_LUZ_PIO;
+}
+
+// Inicia a medição do BH1750; o resultado fica pronto em BH1750_TEMPO_MEDICAO_MS
+void iniciar_medicao_lux() {
+    medicao_lux_em_andamento = bh1750_start_measurement(barramento_luz);
+    medicao_lux_pronta = make_timeout_time_ms(BH1750_TEMPO_MEDICAO_MS);
+}
+
+// Espera o que falta da medição atendendo os botões; false se ela não foi iniciada
+bool aguardar_medicao_lux(bool reduzir_clock) {
+    if (!medicao_lux_em_andamento) return false;
+    medicao_lux_em_andamento = false;
+    int64_t restante_us = absolute_time_diff_us(get_absolute_time(), medicao_lux_pronta);
+    if (restante_us > 0) esperar_atendendo_eventos((restante_us + 999) / 1000, reduzir_clock);
+    return true;
+}
 
-// ... (Função obter_grb_pelo_nome permanece a mesma) ...
-uint32_t obter_grb_pelo_nome(const char *nome_da_cor, uint16_t lux);
+// Marca o GY-33 como recém-ligado: a próxima leitura espera a primeira integração
+void religou_sensor_cor() {
+    cor_sem_integracao = true;
+    cor_ligada_em = get_absolute_time();
+}
 
+// Espera a primeira integração do GY-33 religado: o tempo nominal ((256 - ATIME) x
+// 2,4 ms) que a medição do BH1750 não cobriu e, depois dele, o AVALID de ciclo em
+// ciclo do ADC (o oscilador tem tolerância), por no máximo mais uma integração.
+// Se já passaram duas integrações (o caso do ATIME padrão), não lê o STATUS
+void aguardar_integracao_cor(bool reduzir_clock) {
+    if (!cor_sem_integracao) return;
+    cor_sem_integracao = false;
+    uint32_t integracao_us = (256 - parametros.gy33_atime) * 2400u;
+    absolute_time_t nominal = delayed_by_us(cor_ligada_em, integracao_us);
+    absolute_time_t limite = delayed_by_us(nominal, integracao_us);
+    if (time_reached(limite)) return;
+
+    saude_etapa(ETAPA_SENSOR_COR, SAUDE_BARRAMENTO_SENSORES);
+    int64_t restante_us;
+    while ((restante_us = absolute_time_diff_us(get_absolute_time(), nominal)) > 0 ||
+           (!gy33_integracao_pronta(&barramento_sensores) && !time_reached(limite))) {
+        esperar_atendendo_eventos(restante_us > 0 ? (restante_us + 999) / 1000 : 3, reduzir_clock);
+    }
+    saude_etapa(ETAPA_SENSOR_LUX, barramento_etapa_luz());
+}
+
+// Lê os dois sensores; no modo de baixo consumo eles só ficam ligados durante a leitura.
+// A medição do BH1750 (~200 ms) é aguardada atendendo os botões e, se a integração
+// do GY-33 religado for mais longa, o que falta dela também. Uma medição iniciada na
+// inicialização é aproveitada. As duas leituras são enfileiradas antes de aguardar
+// qualquer uma: no I2C0 a fila as põe em sequência, com o BH1750 no PIO
+// (SENSOR_LUZ_NO_PIO) elas ocupam os fios ao mesmo tempo.
+void ler_sensores(uint16_t *r, uint16_t *g, uint16_t *b, uint16_t *c, uint16_t *lux) {
+    bool baixo_consumo = energia_modo_baixo_consumo();
+    if (baixo_consumo && !medicao_lux_em_andamento) {
+        saude_etapa(ETAPA_SENSOR_COR, SAUDE_BARRAMENTO_SENSORES);
+        gy33_power_up(&barramento_sensores);
+        religou_sensor_cor();
+        saude_etapa(ETAPA_SENSOR_LUX, barramento_etapa_luz());
+        bh1750_power_on(barramento_luz);
+    }
+    saude_etapa(ETAPA_SENSOR_LUX, barramento_etapa_luz());
+    if (!medicao_lux_em_andamento) iniciar_medicao_lux();
+    bool medida = aguardar_medicao_lux(baixo_consumo);
+    aguardar_integracao_cor(baixo_consumo);
+
+    bh1750_leitura_t leitura_lux;
+    gy33_leitura_t leitura_cor;
+    if (medida) bh1750_begin_read_result(barramento_luz, &leitura_lux);
+    gy33_iniciar_leitura_cor(&barramento_sensores, &leitura_cor);
+    *lux = medida ? bh1750_end_read_result(&leitura_lux) : 0;
+    saude_etapa(ETAPA_SENSOR_COR, SAUDE_BARRAMENTO_SENSORES);
+    gy33_concluir_leitura_cor(&leitura_cor, r, g, b, c);
+
+    if (baixo_consumo) {
+        bh1750_power_down(barramento_luz);
+        gy33_power_down(&barramento_sensores);
+    }
+}
+
+// Avisa quem depende do clk_sys: o PIO da matriz e o do I2C (se o BH1750 estiver nele)
+void mudanca_clock(bool antes, uint32_t clk_sys_hz) {
+    i2c_barramento_mudanca_clock(barramento_luz, antes, clk_sys_hz);
+    compositor_mudanca_clock(antes, clk_sys_hz);
+}
+
+// Imprime o ciclo de trabalho e o tempo ativo por amostra para comparar os modos
+void imprimir_relatorio_energia() {
+    energia_estatisticas_t e = energia_obter_estatisticas();
+    uint64_t total_us = e.tempo_ativo_us + e.tempo_ocioso_us;
+    if (total_us == 0 || e.amostras == 0) return;
+    printf("Energia [%s]: ativo %.1f%%, %llu us ativos/amostra, %lu despertares por botao\n",
+           energia_modo_baixo_consumo() ? "baixo consumo" : "normal",
+           100.0 * e.tempo_ativo_us / total_us,
+           (unsigned long long)(e.tempo_ativo_us / e.amostras),
+           (unsigned long)e.despertares_botao);
+}
+
+// Imprime a temporização dos quadros da matriz de LEDs
+void imprimir_relatorio_matriz() {
+    compositor_estatisticas_t m = compositor_obter_estatisticas();
+    printf("Matriz: %lu quadros, %lu perdidos, composicao %lu us (max %lu), intervalo %lu-%lu us\n",
+           (unsigned long)m.quadros_enviados, (unsigned long)m.quadros_perdidos,
+           (unsigned long)m.composicao_ultima_us, (unsigned long)m.composicao_max_us,
+           (unsigned long)m.intervalo_min_us, (unsigned long)m.intervalo_max_us);
+}
+
+// Repassa ao hardware os parâmetros alterados pelo console
+void aplicar_parametros() {
+    i2c_barramento_limitar_baudrate(&barramento_sensores, parametros.i2c_sensores_khz * 1000);
+    i2c_barramento_limitar_baudrate(&barramento_display, parametros.i2c_display_khz * 1000);
+    i2c_barramento_limitar_baudrate(&barramento_luz_pio, parametros.i2c_sensores_khz * 1000);
+    gy33_set_integration(&barramento_sensores, parametros.gy33_atime, parametros.gy33_ganho);
+}
+
+// Imprime a latência entre a borda do botão e a tela nova no display
+void imprimir_relatorio_botoes() {
+    if (latencia_botoes.eventos == 0) return;
+    printf("Botoes: %lu trocas, latencia ultima %lu us, media %lu us, max %lu us, %lu perdidos\n",
+           (unsigned long)latencia_botoes.eventos, (unsigned long)latencia_botoes.ultima_us,
+           (unsigned long)(latencia_botoes.soma_us / latencia_botoes.eventos),
+           (unsigned long)latencia_botoes.max_us, (unsigned long)botoes_eventos_perdidos());
+}
+
+// Imprime a distribuição do tempo de trabalho por iteração e os prazos perdidos
+void imprimir_relatorio_saude() {
+    const saude_estatisticas_t *s = saude_estatisticas();
+    const histograma_t *h = &s->trabalho_us;
+    printf("Laco: %lu iteracoes, trabalho p50 %lu us, p90 %lu us, p99 %lu us, max %lu us, %lu acima de %d ms\n",
+           (unsigned long)s->iteracoes,
+           (unsigned long)histograma_percentil(h, 0.50f), (unsigned long)histograma_percentil(h, 0.90f),
+           (unsigned long)histograma_percentil(h, 0.99f), (unsigned long)h->maximo,
+           (unsigned long)s->prazos_perdidos, SAUDE_PRAZO_ITERACAO_MS);
+}
+
+void imprimir_relatorio_alarmes() {
+    const janela_lux_t *j = &alarmes_lux.janela;
+    printf("Alarmes lux: baixo %lu, alto %lu, variacao %lu, desvio %lu; janela media %.1f dp %.1f min %u max %u, %.1f lux/s\n",
+           (unsigned long)alarmes_lux.disparos[0], (unsigned long)alarmes_lux.disparos[1],
+           (unsigned long)alarmes_lux.disparos[2], (unsigned long)alarmes_lux.disparos[3],
+           janela_lux_media(j), janela_lux_desvio(j), janela_lux_minimo(j), janela_lux_maximo(j),
+           janela_lux_inclinacao(j));
+}
+
+// Informa onde o laço estava quando o watchdog reiniciou a placa
+void imprimir_reinicio_watchdog() {
+    foto_falha_t foto = saude_foto_reinicio();
+    if (!foto.valida) return;
+    const char *barramentos[] = { "-", "I2C0 (sensores)", "I2C1 (display)", "PIO (sensor de luz)" };
+    printf("REINICIO PELO WATCHDOG: etapa '%s', barramento %s, iteracao %lu, t = %lu us\n",
+           saude_nome_etapa(foto.etapa), foto.barramento <= SAUDE_BARRAMENTO_LUZ_PIO ? barramentos[foto.barramento] : "?",
+           (unsigned long)foto.iteracao, (unsigned long)foto.instante_us);
+}
+
+// Analisa o último bloco do ADC; repete com o seguinte se o DMA voltou ao buffer durante a análise
+bool analisar_cintilacao(cintilacao_resultado_t *resultado) {
+    for (int tentativa = 0; tentativa < 2; tentativa++) {
+        const uint16_t *bloco;
+        uint32_t numero = captura_adc_ultimo_bloco(&bloco);
+        if (numero == 0) return false;
+        cintilacao_analisar(bloco, CAPTURA_ADC_AMOSTRAS, CAPTURA_ADC_TAXA_HZ, resultado);
+        if (captura_adc_sequencia() == numero) return true;
+    }
+    return false;
+}
+
+// Espera o terminal só se houver um computador na USB. Sem enumeração em
+// BOOT_ENUMERACAO_USB_MS (placa na bateria ou num carregador) segue direto.
+void esperar_host_usb() {
+    absolute_time_t limite = make_timeout_time_ms(BOOT_ENUMERACAO_USB_MS);
+    while (!tud_mounted() && !time_reached(limite)) sleep_ms(1);
+    if (!tud_mounted()) return;
+    limite = make_timeout_time_ms(BOOT_ESPERA_TERMINAL_MS);
+    while (!stdio_usb_connected() && !time_reached(limite)) sleep_ms(1);
+}
 
 // Função Principal
 int main() {
+    // Relógio dos periféricos independente do clk_sys (antes de UART e I2C)
+    energia_init();
+    energia_definir_modo_baixo_consumo(MODO_BAIXO_CONSUMO_PADRAO);
+    parametros_init(); // Valores gravados pelo console ou os padrões
+
     // Inicialização da comunicação serial
     stdio_init_all();
-    sleep_ms(2000);
-
-    // ... (Toda a inicialização de hardware (I2C, botões) permanece a mesma) ...
-    i2c_init(I2C0_PORT, 100 * 1000);
-    gpio_set_function(I2C0_SDA_PIN, GPIO_FUNC_I2C);
-    gpio_set_function(I2C0_SCL_PIN, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C0_SDA_PIN);
-    gpio_pull_up(I2C0_SCL_PIN);
-    i2c_init(I2C1_PORT, 400 * 1000);
-    gpio_set_function(I2C1_SDA_PIN, GPIO_FUNC_I2C);
-    gpio_set_function(I2C1_SCL_PIN, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C1_SDA_PIN);
-    gpio_pull_up(I2C1_SCL_PIN);
-    gpio_init(BOTAO_A_PIN);
-    gpio_set_dir(BOTAO_A_PIN, GPIO_IN);
-    gpio_pull_up(BOTAO_A_PIN);
-    gpio_init(BOTAO_B_PIN);
-    gpio_set_dir(BOTAO_B_PIN, GPIO_IN);
-    gpio_pull_up(BOTAO_B_PIN);
-    gpio_set_irq_enabled_with_callback(BOTAO_A_PIN, GPIO_IRQ_EDGE_FALL, true, &tratar_interrupcao_gpio);
-    gpio_set_irq_enabled_with_callback(BOTAO_B_PIN, GPIO_IRQ_EDGE_FALL, true, &tratar_interrupcao_gpio);
-
-    // Inicialização dos Módulos
-    gy33_init(I2C0_PORT);
-    ssd1306_t display;
-    ssd1306_init(&display, SSD1306_WIDTH, SSD1306_HEIGHT, false, SSD1306_I2C_ADDR, I2C1_PORT);
-    ssd1306_config(&display);
-    inicializar_matriz_led();
-    inicializar_buzzer();
-    bh1750_power_on(I2C0_PORT);
+    if (!BOOT_RAPIDO) sleep_ms(2000);
+    saude_init(); // Watchdog ligado daqui em diante
+
+    // Barramentos I2C (cada driver pede a própria velocidade por transação)
+    i2c_barramento_init(&barramento_sensores, I2C0_PORT, I2C0_SDA_PIN, I2C0_SCL_PIN, 100 * 1000);
+    i2c_barramento_init(&barramento_display, I2C1_PORT, I2C1_SDA_PIN, I2C1_SCL_PIN, 400 * 1000);
+    if (SENSOR_LUZ_NO_PIO && i2c_barramento_init_pio(&barramento_luz_pio, PIO_I2C_BLOCO, PIO_I2C_SDA_PIN, 100 * 1000)) {
+        barramento_luz = &barramento_luz_pio;
+    }
 
-    // Tela de boas-vindas
+    // Sensores primeiro: as integrações do GY-33 e do BH1750 correm durante o resto da inicialização
+    uint32_t t_sensores = time_us_32();
+    gy33_init(&barramento_sensores);
+    religou_sensor_cor();
+    parametros_registrar_aplicacao(aplicar_parametros);
+    aplicar_parametros();
+    bh1750_power_on(barramento_luz);
+    iniciar_medicao_lux();
+
+    // Display (inicialização numa transação só) e tela de boas-vindas
+    uint32_t t_display = time_us_32();
+    ssd1306_init(&display, SSD1306_WIDTH, SSD1306_HEIGHT, false, SSD1306_I2C_ADDR, &barramento_display);
+    ssd1306_config(&display);
+    espelho_init(&display);
     ssd1306_fill(&display, false);
     ssd1306_draw_string(&display, "Iniciando...", 25, 25, false);
     ssd1306_send_data(&display);
-    sleep_ms(1500);
+
+    uint32_t t_perifericos = time_us_32();
+    const uint8_t pinos_botoes[] = { BOTAO_A_PIN, BOTAO_B_PIN };
+    botoes_init(pinos_botoes, 2, energia_acordar); // Cada pressão encerra a espera ociosa na hora
+    inicializar_matriz_led();
+    energia_registrar_mudanca_clock(mudanca_clock);
+    inicializar_buzzer();
+    captura_adc_init();
+    historico_lux_init(&historico_lux, HISTORICO_AMOSTRAS_POR_COLUNA);
+    alarmes_lux_init(&alarmes_lux, ALARMES_LUX_JANELA_PADRAO);
+
+    uint32_t t_usb = time_us_32();
+    if (BOOT_RAPIDO) {
+        esperar_host_usb();
+    } else {
+        sleep_ms(1500);
+    }
+    uint32_t t_fim = time_us_32();
+
+    imprimir_reinicio_watchdog();
+    printf("Parametros: %s (digite help)\n", parametros_carregados_da_flash() ? "gravados na flash" : "padrao");
+    if (SENSOR_LUZ_NO_PIO) {
+        printf("Sensor de luz: %s\n", barramento_luz == &barramento_luz_pio ? "I2C no PIO (GPIO 2/3)" : "I2C0 (PIO sem SM livre)");
+    }
+    printf("Boot: sensores %lu us, display %lu us, perifericos %lu us, USB %lu us (%lu ms desde o reset)\n",
+           (unsigned long)(t_display - t_sensores), (unsigned long)(t_perifericos - t_display),
+           (unsigned long)(t_usb - t_perifericos), (unsigned long)(t_fim - t_usb), (unsigned long)(t_fim / 1000));
+    bool primeira_amostra = true;
 
     // Loop Infinito
     while (1) {
+        saude_inicio_iteracao();
+
         // --- Leitura dos Sensores ---
-        uint16_t r, g, b, c;
-        gy33_read_color(I2C0_PORT, &r, &g, &b, &c);
-        const char *nome_da_cor = identificar_cor(r, g, b, c);
-        uint16_t lux = bh1750_read_measurement(I2C0_PORT);
+        uint16_t r, g, b, c, lux;
+        ler_sensores(&r, &g, &b, &c, &lux);
+        amostra_sensores_t amostra = { r, g, b, c, lux };
+        trace_amostras_registrar(&amostra);
+
+        // Mesmo pipeline da ferramenta de replay (tools/replay)
+        saude_etapa(ETAPA_CLASSIFICACAO, SAUDE_SEM_BARRAMENTO);
+        config_classificador_t config;
+        decisao_cor_t decisao;
+        parametros_config_classificador(&config);
+        classificador_processar(&amostra, &config, &decisao);
+        const char *nome_da_cor = decisao.cor;
+        if (primeira_amostra) {
+            primeira_amostra = false;
+            printf("Primeira amostra: %lu ms desde o reset\n", (unsigned long)(time_us_32() / 1000));
+        }
+        if (historico_lux_adicionar(&historico_lux, lux)) historico_coluna_pendente = true;
+        ultima_amostra = (amostra_t){ r, g, b, c, lux, nome_da_cor, ultima_amostra.cintilacao_valida, ultima_amostra.cintilacao };
+
+        saude_etapa(ETAPA_CINTILACAO, SAUDE_SEM_BARRAMENTO);
+        cintilacao_resultado_t cintilacao;
+        if (analisar_cintilacao(&cintilacao)) {
+            ultima_amostra.cintilacao = cintilacao;
+            ultima_amostra.cintilacao_valida = true;
+        }
 
         printf("Lux = %d\n", lux);
+        if (ultima_amostra.cintilacao_valida) {
+            const cintilacao_resultado_t *f = &ultima_amostra.cintilacao;
+            printf("Cintilacao = %u.%u%%, indice %u.%03u, %u Hz, nivel %u\n",
+                   f->percentual_x10 / 10, f->percentual_x10 % 10, f->indice_x1000 / 1000,
+                   f->indice_x1000 % 1000, f->frequencia_hz, f->media);
+        }
 
         // --- Lógica de Atuação ---
 
         // 1. Atualiza a matriz de LEDs
-        uint32_t cor_da_matriz = obter_grb_pelo_nome(nome_da_cor, lux);
-        for (int i = 0; i < NUM_PIXELS; ++i) {
-            pio_sm_put_blocking(pio0, 0, cor_da_matriz << 8u);
-        }
-
-        // 2. LÓGICA DE ALERTA SONORO ATUALIZADA
-        // Verifica em qual tela o usuário está para decidir qual alerta tocar
-        if (estado_display == 2) { // Se estiver na tela de LUZ
-            // Verifica se a luminosidade está fora dos limites
-            if (lux < LIMITE_LUZ_INFERIOR || lux > LIMITE_LUZ_SUPERIOR) {
-                tocar_alerta_limite_lux(); // Toca o som "ensurdecedor"
+        saude_etapa(ETAPA_MATRIZ, SAUDE_SEM_BARRAMENTO);
+        compositor_definir_base(decisao.grb); // Enviada no próximo tick do compositor
+
+        // 2. Alarmes de luz (em qualquer tela) e som da cor nas telas de COR
+        saude_etapa(ETAPA_ALERTA, SAUDE_SEM_BARRAMENTO);
+        config_alarmes_lux_t config_alarmes;
+        parametros_config_alarmes(&config_alarmes);
+        uint8_t disparados = alarmes_lux_atualizar(&alarmes_lux, &config_alarmes, lux, to_ms_since_boot(get_absolute_time()));
+        for (uint8_t k = 0; k < NUM_REGRAS_ALARME_LUX; k++) {
+            if (disparados & (1u << k)) {
+                printf("Alarme: %s (lux %u, media %.1f, %.1f lux/s)\n", alarmes_lux_nome(1u << k), lux,
+                       janela_lux_media(&alarmes_lux.janela), janela_lux_inclinacao(&alarmes_lux.janela));
             }
-        } else { // Se estiver nas telas de COR (RGB ou Normalizada)
+        }
+        if (disparados & (ALARME_LUX_BAIXO | ALARME_LUX_ALTO)) {
+            tocar_alerta_limite_lux(); // Toca o som "ensurdecedor" uma vez por saída da faixa
+        } else if (disparados) {
+            tocar_alerta_variacao_lux();
+        }
+        if (estado_display == 0 || estado_display == 1) { // Se estiver nas telas de COR (RGB ou Normalizada)
             tocar_alerta_cor(nome_da_cor); // Toca o som da cor correspondente
         }
 
         // 3. Desenha a tela correta no display
-        switch (estado_display) {
-        case 0:
-            desenhar_tela_rgb(&display, r, g, b, nome_da_cor);
-            break;
-        case 1:
-            desenhar_tela_normalizada(&display, r, g, b, nome_da_cor);
-            break;
-        case 2:
-            // Chamada da função de LUZ atualizada
-            desenhar_tela_lux(&display, lux);
-            break;
+        saude_etapa(ETAPA_DISPLAY, SAUDE_BARRAMENTO_DISPLAY);
+        desenhar_tela(estado_display, &ultima_amostra);
+
+        saude_etapa(ETAPA_RELATORIO, SAUDE_SEM_BARRAMENTO);
+        energia_registrar_amostra();
+        if (energia_obter_estatisticas().amostras % RELATORIO_ENERGIA_AMOSTRAS == 0) {
+            imprimir_relatorio_energia();
+            imprimir_relatorio_matriz();
+            imprimir_relatorio_botoes();
+            imprimir_relatorio_saude();
+            imprimir_relatorio_alarmes();
         }
-        ssd1306_send_data(&display);
+        saude_fim_iteracao();
 
-        // Pausa para evitar som contínuo e sobrecarga
-        sleep_ms(300);
+        // Pausa para evitar som contínuo e sobrecarga (com clock reduzido no modo de baixo consumo)
+        saude_etapa(ETAPA_OCIOSO, SAUDE_SEM_BARRAMENTO);
+        esperar_atendendo_eventos(parametros.intervalo_ms, true);
     }
 }
 
@@ -266,22 +723,3 @@ void desenhar_tela_normalizada(ssd1306_t *display, uint16_t r, uint16_t g, uint1
     ssd1306_draw_string(display, str_gn, 5, 45, false);
     ssd1306_draw_string(display, str_bn, 5, 55, false);
 }
-
-uint32_t obter_grb_pelo_nome(const char *nome_da_cor, uint16_t lux) {
-    int DIVISOR_DE_BRILHO;
-    if (lux <= 50) DIVISOR_DE_BRILHO = 1;
-    else if (lux <= 300) DIVISOR_DE_BRILHO = 3 + ((lux - 51) * 3) / 249;
-    else if (lux <= 1000) DIVISOR_DE_BRILHO = 7 + ((lux - 301) * 2) / 699;
-    else DIVISOR_DE_BRILHO = 10;
-    // Removi o printf daqui para não poluir o console
-    int numero_de_cores = 12;
-    for (int i = 0; i < numero_de_cores; i++) {
-        if (strcmp(nome_da_cor, PALETA_CORES[i].nome) == 0) {
-            uint8_t r = PALETA_CORES[i].r / DIVISOR_DE_BRILHO;
-            uint8_t g = PALETA_CORES[i].g / DIVISOR_DE_BRILHO;
-            uint8_t b = PALETA_CORES[i].b / DIVISOR_DE_BRILHO;
-            return GRB(r, g, b);
-        }
-    }
-    return 0; // COR_OFF
-}
\ No newline at end of file
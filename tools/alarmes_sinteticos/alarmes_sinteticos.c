@@ -0,0 +1,151 @@
+/* Passa sequências sintéticas de lux por alarmes_lux_atualizar() e confere
+ * os disparos de cada regra; antes, compara as estatísticas da janela
+ * deslizante com uma referência recalculada do zero a cada amostra.
+ *
+ * Uso: alarmes_sinteticos
+ *
+ * Cada caso imprime os disparos esperados e obtidos; o código de saída é 1
+ * se algum divergir ou se as estatísticas saírem da tolerância. */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "alarmes_lux.h"
+
+#define INTERVALO_MS 300                    // O padrão de intervalo_ms
+#define N_ESTATISTICAS 100000
+#define MAX_AMOSTRAS 400
+
+typedef enum { CONSTANTE, DEGRAU, RAMPA, PICO, OSCILA_NO_LIMITE, PISCA } forma_t;
+
+typedef struct {
+    const char *nome;
+    forma_t forma;
+    double nivel, alvo;                     // Antes e depois da mudança
+    int inicio, duracao;                    // Em amostras
+    double ruido;                           // Pico do ruído uniforme
+    int amostras;
+    uint32_t esperados[NUM_REGRAS_ALARME_LUX];  // Baixo, alto, variação, desvio
+} caso_t;
+
+static const caso_t casos[] = {
+    { "Estável com ruído",          CONSTANTE,        60,   60,   0,   0, 3, 300, {0, 0, 0, 0} },
+    { "Luz apaga (degrau)",         DEGRAU,          300,    5, 100,   0, 2, 200, {1, 1, 1, 1} },
+    { "Rampa lenta dentro da faixa", RAMPA,           30,   90, 50, 200, 1, 300, {0, 0, 0, 0} },
+    { "Rampa rápida dentro da faixa", RAMPA,          25,   95, 50,   4, 1, 150, {0, 0, 1, 1} },
+    { "Pico isolado",               PICO,             50,   90, 80,   1, 1, 150, {0, 0, 0, 1} },
+    { "Ruído sobre lux_max",        OSCILA_NO_LIMITE, 100,  100, 20, 200, 1, 250, {0, 1, 0, 0} },
+    { "Pisca a cada 2 s",           PISCA,            60,   10, 30,   7, 0, 300, {8, 0, 0, 1} },
+};
+
+static const config_alarmes_lux_t config = {
+    .lux_min = 20,
+    .lux_max = 100,
+    .histerese_lux = 2,
+    .taxa_max_lux_s = 15.0f,
+    .desvio_z = 4.0f,
+    .desvio_min_lux = 5.0f,
+    .espera_ms = 10000,
+};
+
+// --- Funções Internas ---
+
+static double ruido(double pico) {
+    return pico * (2.0 * rand() / RAND_MAX - 1.0);
+}
+
+static double valor(const caso_t *c, int i) {
+    switch (c->forma) {
+    case DEGRAU:
+        return i < c->inicio ? c->nivel : c->alvo;
+    case RAMPA:
+        if (i < c->inicio) return c->nivel;
+        if (i >= c->inicio + c->duracao) return c->alvo;
+        return c->nivel + (c->alvo - c->nivel) * (i - c->inicio) / c->duracao;
+    case PICO:
+        return i >= c->inicio && i < c->inicio + c->duracao ? c->alvo : c->nivel;
+    case PISCA:
+        // Apaga por uma amostra a cada `duracao` amostras
+        return i >= c->inicio && (i - c->inicio) % c->duracao == 0 ? c->alvo : c->nivel;
+    default:
+        return c->nivel;
+    }
+}
+
+// Janela recalculada do zero contra os acumuladores O(1)
+static int verificar_estatisticas(void) {
+    static uint16_t valores[N_ESTATISTICAS];
+    static uint32_t instantes[N_ESTATISTICAS];
+    const int tamanho = ALARMES_LUX_JANELA_PADRAO;
+    janela_lux_t j;
+    janela_lux_init(&j, tamanho);
+    uint32_t t = 0xFFFF0000u;               // Passa pela volta do contador de ms
+    double pior_media = 0, pior_desvio = 0, pior_inclinacao = 0;
+    int erros_extremos = 0;
+    for (int i = 0; i < N_ESTATISTICAS; i++) {
+        valores[i] = (uint16_t)(rand() % 4 ? 200 + rand() % 50 : rand() % 65536);
+        instantes[i] = t;
+        t += INTERVALO_MS + rand() % 200;   // Iterações com botão ou alerta demoram mais
+        janela_lux_adicionar(&j, valores[i], instantes[i]);
+
+        int inicio = i + 1 > tamanho ? i + 1 - tamanho : 0;
+        int n = i + 1 - inicio;
+        double soma = 0, mt = 0;
+        uint16_t minimo = UINT16_MAX, maximo = 0;
+        for (int k = inicio; k <= i; k++) {
+            soma += valores[k];
+            mt += (double)(int32_t)(instantes[k] - instantes[inicio]);
+            if (valores[k] < minimo) minimo = valores[k];
+            if (valores[k] > maximo) maximo = valores[k];
+        }
+        double media = soma / n;
+        mt /= n;
+        double m2 = 0, sxy = 0, sxx = 0;
+        for (int k = inicio; k <= i; k++) {
+            double dt = (double)(int32_t)(instantes[k] - instantes[inicio]) - mt;
+            m2 += (valores[k] - media) * (valores[k] - media);
+            sxy += dt * (valores[k] - media);
+            sxx += dt * dt;
+        }
+        double desvio = n > 1 ? sqrt(m2 / (n - 1)) : 0;
+        double inclinacao = n > 1 ? sxy / sxx * 1000.0 : 0;
+
+        double e;
+        if ((e = fabs(janela_lux_media(&j) - media) / (fabs(media) + 1)) > pior_media) pior_media = e;
+        if ((e = fabs(janela_lux_desvio(&j) - desvio) / (desvio + 1)) > pior_desvio) pior_desvio = e;
+        if ((e = fabs(janela_lux_inclinacao(&j) - inclinacao) / (fabs(inclinacao) + 1)) > pior_inclinacao) {
+            pior_inclinacao = e;
+        }
+        if (janela_lux_minimo(&j) != minimo || janela_lux_maximo(&j) != maximo) erros_extremos++;
+    }
+    int ok = pior_media < 1e-4 && pior_desvio < 1e-3 && pior_inclinacao < 1e-3 && erros_extremos == 0;
+    printf("%-28s erro relativo: media %.1e, desvio %.1e, inclinacao %.1e; min/max errados %d  %s\n",
+           "Janela x referência", pior_media, pior_desvio, pior_inclinacao, erros_extremos, ok ? "ok" : "FALHOU");
+    return ok;
+}
+
+static int executar(const caso_t *c) {
+    alarmes_lux_t a;
+    alarmes_lux_init(&a, ALARMES_LUX_JANELA_PADRAO);
+    for (int i = 0; i < c->amostras && i < MAX_AMOSTRAS; i++) {
+        double v = valor(c, i) + ruido(c->ruido);
+        alarmes_lux_atualizar(&a, &config, (uint16_t)(v < 0 ? 0 : v + 0.5), (uint32_t)i * INTERVALO_MS);
+    }
+    int ok = 1;
+    for (int k = 0; k < NUM_REGRAS_ALARME_LUX; k++) ok &= a.disparos[k] == c->esperados[k];
+    printf("%-28s esperado %lu/%lu/%lu/%lu  obtido %lu/%lu/%lu/%lu  %s\n", c->nome,
+           (unsigned long)c->esperados[0], (unsigned long)c->esperados[1], (unsigned long)c->esperados[2],
+           (unsigned long)c->esperados[3], (unsigned long)a.disparos[0], (unsigned long)a.disparos[1],
+           (unsigned long)a.disparos[2], (unsigned long)a.disparos[3], ok ? "ok" : "FALHOU");
+    return ok;
+}
+
+// --- Programa ---
+
+int main(void) {
+    srand(1);
+    int ok = verificar_estatisticas();
+    printf("Disparos por regra: baixo/alto/variacao/desvio\n");
+    for (size_t i = 0; i < sizeof(casos) / sizeof(casos[0]); i++) ok &= executar(&casos[i]);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,625 @@
+/* Bench do pipeline completo: o firmware de verdade (main.c e lib/) roda no
+ * computador sobre a placa simulada de sim/, com relógio virtual, sensores,
+ * barramentos I2C, DMA, PIO e PWM simulados, em cenários reproduzíveis.
+ *
+ * Uso:
+ *   bench [-c cenario] [-d segundos] [-j saida.json] [-l dir_logs] [-e firmware.elf]
+ *   bench --comparar <base.json> <novo.json> [-t tolerancia_%]
+ *   bench --listar
+ *
+ * Cada cenário roda num processo próprio (o firmware não tem como ser
+ * reiniciado) por -d segundos virtuais, padrão 60. As métricas:
+ *   - amostras_por_s e período entre amostras, em tempo virtual;
+ *   - tempo de trabalho por iteração e de cada etapa do laço (saude_etapa)
+ *     por amostra, em percentis, no tempo virtual (esperas por sensores e
+ *     barramentos) e em ns reais do computador (host.*);
+ *   - trabalho de CPU por amostra, total e de cada etapa, em blocos básicos
+ *     do firmware executados (cpu.*, contados com -fsanitize-coverage);
+ *   - bytes, transações e ocupação de cada barramento I2C por amostra;
+ *   - quadros perdidos da matriz, latência botão → tela, resets do watchdog;
+ *   - footprint: flash e RAM do firmware compilado para o computador ou,
+ *     com -e, do .elf do RP2040 (arm-none-eabi-size).
+ * As métricas em .info. descrevem o comportamento (alarmes, notas) e não
+ * entram na comparação. -l grava a saída do firmware de cada cenário.
+ *
+ * --comparar aponta as métricas que pioraram além da tolerância (2%) e sai
+ * com 1 se houver alguma ou se alguma sumiu. Só entram no veredito as
+ * métricas determinísticas: tempo virtual, cpu.*, barramentos e footprint.
+ * As host.* variam de uma rodada para outra na mesma máquina (a mediana de
+ * cinco rodadas ainda chega a dobrar) e aparecem só como relatório. Chaves
+ * terminadas em _por_s melhoram para cima; as demais, para baixo.
+ *
+ * Limitação: o relógio virtual só anda enquanto o firmware espera, então o
+ * cálculo (classificação, composição da matriz, formatação do display) custa
+ * 0 us nas métricas de tempo virtual e uma regressão de CPU não aparece nelas.
+ * Quem a pega são as cpu.*, que contam blocos e não ciclos: um bloco mais
+ * caro (divisão, float, acesso lento à memória) não pesa mais que um barato,
+ * e o código do SDK (sim/) fica de fora. O custo real no RP2040 só com a
+ * placa. */
+
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "cenarios.h"
+#include "saude.h"
+#include "energia.h"
+#include "alarmes_lux.h"
+#include "matriz_compositor.h"
+#include "hardware/clocks.h"
+
+#define DURACAO_PADRAO_S    60
+#define LIMITE_HOST_S       300      // Um cenário travado é encerrado depois disso
+#define MAX_METRICAS        1024
+#define TAM_CHAVE           96       // Chave emitida pelo cenário
+#define TAM_NOME_CENARIO    32       // Prefixo que o pai põe na chave
+#define TOLERANCIA_PADRAO   2.0
+
+typedef struct {
+    char chave[TAM_NOME_CENARIO + TAM_CHAVE];
+    double valor;
+} metrica_t;
+
+/* ---------- Medição dentro do processo do cenário ---------- */
+typedef struct {
+    etapa_laco_t etapa;              // Etapa em curso e desde quando
+    uint64_t desde_us, desde_ns;
+    uint64_t soma_us[NUM_ETAPAS];    // Acumulado de cada etapa na iteração em curso
+    uint64_t soma_ns[NUM_ETAPAS];
+    uint64_t soma_blocos[NUM_ETAPAS];
+    uint64_t blocos[NUM_ETAPAS];     // Total das iterações fechadas
+    uint64_t desde_blocos;
+    bool visitada[NUM_ETAPAS];
+    histograma_t etapa_us[NUM_ETAPAS];
+    histograma_t etapa_ns[NUM_ETAPAS];
+    histograma_t trabalho_us, trabalho_ns, periodo_us;
+    histograma_t latencia_botao_us;
+    uint64_t inicio_iteracao_us, inicio_iteracao_ns;
+    bool iterando;
+    uint32_t amostras;
+    uint64_t boot_us;
+    uint64_t host_inicio_ns;
+    uint32_t pressoes_atendidas;     // Índice em sim_contadores.pressoes_us
+} medicao_t;
+
+int firmware_main(void);             // main() de main.c, renomeada na compilação
+extern alarmes_lux_t alarmes_lux;    // Global de main.c
+
+marca_etapa_t __real_saude_etapa(etapa_laco_t etapa, barramento_etapa_t barramento);
+void __real_saude_retomar(marca_etapa_t marca);
+void __real_saude_inicio_iteracao(void);
+void __real_saude_fim_iteracao(void);
+
+static medicao_t med;
+static uint64_t blocos_executados;   // Blocos básicos do firmware desde o início do processo
+static uint64_t duracao_atual_us;
+static FILE *saida_metricas;
+
+static metrica_t metricas[MAX_METRICAS];
+static int num_metricas;
+
+// --- Funções Internas ---
+
+// O compilador a chama no começo de cada bloco básico do firmware (-fsanitize-coverage=trace-pc)
+void __sanitizer_cov_trace_pc(void) {
+    blocos_executados++;
+}
+
+static uint64_t agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static uint32_t saturar_u32(uint64_t v) {
+    return v > UINT32_MAX ? UINT32_MAX : (uint32_t)v;
+}
+
+// Fecha o trecho da etapa em curso e passa para a próxima
+static void trocar_etapa(etapa_laco_t etapa) {
+    uint64_t us = sim_agora_us(), ns = agora_ns();
+    med.soma_us[med.etapa] += us - med.desde_us;
+    med.soma_ns[med.etapa] += ns - med.desde_ns;
+    med.soma_blocos[med.etapa] += blocos_executados - med.desde_blocos;
+    med.visitada[med.etapa] = true;
+    med.etapa = etapa;
+    med.desde_us = us;
+    med.desde_ns = ns;
+    med.desde_blocos = blocos_executados;
+}
+
+// Uma amostra por etapa visitada desde o início da iteração anterior
+static void fechar_iteracao(void) {
+    trocar_etapa(med.etapa);
+    for (int e = 0; e < NUM_ETAPAS; e++) {
+        if (!med.visitada[e]) continue;
+        if (e == ETAPA_INICIO) {
+            med.boot_us += med.soma_us[e];
+        } else {
+            histograma_adicionar(&med.etapa_us[e], saturar_u32(med.soma_us[e]));
+            histograma_adicionar(&med.etapa_ns[e], saturar_u32(med.soma_ns[e]));
+            med.blocos[e] += med.soma_blocos[e];
+        }
+        med.soma_us[e] = med.soma_ns[e] = med.soma_blocos[e] = 0;
+        med.visitada[e] = false;
+    }
+}
+
+// Pressões de botão já atendidas quando a tela nova termina de sair no I2C
+static void registrar_latencia_botoes(void) {
+    uint64_t agora = sim_agora_us();
+    bool primeira = true;
+    while (med.pressoes_atendidas < sim_contadores.pressoes) {
+        uint64_t pressao = sim_contadores.pressoes_us[med.pressoes_atendidas];
+        if (primeira) histograma_adicionar(&med.latencia_botao_us, saturar_u32(agora - pressao));
+        primeira = false;
+        med.pressoes_atendidas++;
+    }
+}
+
+// --- Etapas do laço: saude.c continua recebendo as chamadas (--wrap no link) ---
+// Os histogramas do bench usam o histograma_adicionar() do firmware, contado nos
+// blocos: cada wrapper devolve o contador ao valor da entrada antes de seguir
+
+marca_etapa_t __wrap_saude_etapa(etapa_laco_t etapa, barramento_etapa_t barramento) {
+    if (etapa != med.etapa) trocar_etapa(etapa);
+    return __real_saude_etapa(etapa, barramento);
+}
+
+void __wrap_saude_retomar(marca_etapa_t marca) {
+    uint64_t blocos = blocos_executados;
+    if (med.etapa == ETAPA_BOTOES) registrar_latencia_botoes();
+    if (marca.etapa != med.etapa) trocar_etapa(marca.etapa);
+    blocos_executados = blocos;
+    __real_saude_retomar(marca);
+}
+
+void __wrap_saude_inicio_iteracao(void) {
+    uint64_t us = sim_agora_us(), blocos = blocos_executados;
+    fechar_iteracao();
+    if (med.iterando) histograma_adicionar(&med.periodo_us, saturar_u32(us - med.inicio_iteracao_us));
+    med.iterando = true;
+    med.inicio_iteracao_us = us;
+    med.inicio_iteracao_ns = agora_ns();
+    blocos_executados = blocos;
+    __real_saude_inicio_iteracao();
+}
+
+void __wrap_saude_fim_iteracao(void) {
+    uint64_t blocos = blocos_executados;
+    histograma_adicionar(&med.trabalho_us, saturar_u32(sim_agora_us() - med.inicio_iteracao_us));
+    histograma_adicionar(&med.trabalho_ns, saturar_u32(agora_ns() - med.inicio_iteracao_ns));
+    med.amostras++;
+    blocos_executados = blocos;
+    __real_saude_fim_iteracao();
+}
+
+// --- Métricas do cenário (processo filho → pai, uma por linha) ---
+
+static void emitir(const char *chave, double valor) {
+    fprintf(saida_metricas, "%s %.9g\n", chave, valor);
+}
+
+static void emitir_percentis(const char *prefixo, const histograma_t *h, const char *unidade, bool completo) {
+    // Prefixo e unidade limitados para a chave caber em TAM_CHAVE sem cortar o sufixo
+    char chave[TAM_CHAVE];
+    if (h->total == 0) return;
+    snprintf(chave, sizeof(chave), "%.80s.p50_%.8s", prefixo, unidade);
+    emitir(chave, histograma_percentil(h, 0.50f));
+    if (completo) {
+        snprintf(chave, sizeof(chave), "%.80s.p90_%.8s", prefixo, unidade);
+        emitir(chave, histograma_percentil(h, 0.90f));
+    }
+    snprintf(chave, sizeof(chave), "%.80s.p99_%.8s", prefixo, unidade);
+    emitir(chave, histograma_percentil(h, 0.99f));
+    if (completo) {
+        snprintf(chave, sizeof(chave), "%.80s.max_%.8s", prefixo, unidade);
+        emitir(chave, h->maximo);
+    }
+}
+
+// "sensor de cor" → "sensor_de_cor" (a leitura das métricas separa por espaço)
+static void nome_chave(char *destino, size_t tamanho, const char *nome) {
+    snprintf(destino, tamanho, "%s", nome);
+    for (char *p = destino; *p; p++) {
+        if (*p == ' ') *p = '_';
+    }
+}
+
+static void emitir_resultados(void) {
+    static const char *const barramentos[SIM_NUM_BARRAMENTOS] = { "i2c0", "i2c1", "pio" };
+    char chave[TAM_CHAVE], nome[32];
+    double segundos = duracao_atual_us / 1e6;
+    double host_s = (agora_ns() - med.host_inicio_ns) / 1e9;
+    uint32_t n = med.amostras ? med.amostras : 1;
+    uint64_t blocos_total = 0;
+
+    emitir("amostras_por_s", med.amostras / segundos);
+    emitir("host.amostras_por_s", med.amostras / host_s);
+    emitir("boot_ms", med.boot_us / 1000.0);
+    emitir_percentis("periodo", &med.periodo_us, "us", false);
+    emitir_percentis("trabalho", &med.trabalho_us, "us", true);
+    emitir_percentis("host.trabalho", &med.trabalho_ns, "ns", false);
+    for (int e = ETAPA_INICIO + 1; e < NUM_ETAPAS; e++) {
+        nome_chave(nome, sizeof(nome), saude_nome_etapa(e));
+        snprintf(chave, sizeof(chave), "etapa.%s", nome);
+        emitir_percentis(chave, &med.etapa_us[e], "us", true);
+        snprintf(chave, sizeof(chave), "host.etapa.%s", nome);
+        emitir_percentis(chave, &med.etapa_ns[e], "ns", false);
+        if (med.etapa_us[e].total == 0) continue;
+        snprintf(chave, sizeof(chave), "cpu.etapa.%s.blocos_por_amostra", nome);
+        emitir(chave, (double)med.blocos[e] / n);
+        blocos_total += med.blocos[e];
+    }
+    emitir("cpu.blocos_por_amostra", (double)blocos_total / n);
+
+    for (int b = 0; b < SIM_NUM_BARRAMENTOS; b++) {
+        const sim_contadores_i2c_t *c = &sim_contadores.i2c[b];
+        if (c->transacoes == 0 && c->fila_cheia == 0) continue;
+        snprintf(chave, sizeof(chave), "i2c.%s.bytes_por_amostra", barramentos[b]);
+        emitir(chave, (double)c->bytes / n);
+        snprintf(chave, sizeof(chave), "i2c.%s.transacoes_por_amostra", barramentos[b]);
+        emitir(chave, (double)c->transacoes / n);
+        snprintf(chave, sizeof(chave), "i2c.%s.ocupacao_pct", barramentos[b]);
+        emitir(chave, 100.0 * c->ocupado_us / duracao_atual_us);
+        snprintf(chave, sizeof(chave), "i2c.%s.nacks", barramentos[b]);
+        emitir(chave, c->nacks);
+        snprintf(chave, sizeof(chave), "i2c.%s.fila_cheia", barramentos[b]);
+        emitir(chave, c->fila_cheia);
+    }
+
+    compositor_estatisticas_t m = compositor_obter_estatisticas();
+    emitir("matriz.quadros_por_s", sim_contadores.quadros_ws2812 / segundos);
+    emitir("matriz.quadros_perdidos", m.quadros_perdidos);
+    if (med.latencia_botao_us.total > 0) {
+        emitir("botoes.latencia_p50_us", histograma_percentil(&med.latencia_botao_us, 0.50f));
+        emitir("botoes.latencia_max_us", med.latencia_botao_us.maximo);
+        emitir("botoes.nao_atendidas", sim_contadores.pressoes - med.pressoes_atendidas);
+    }
+
+    energia_estatisticas_t en = energia_obter_estatisticas();
+    uint64_t total_us = en.tempo_ativo_us + en.tempo_ocioso_us;
+    emitir("energia.ativo_pct", total_us ? 100.0 * en.tempo_ativo_us / total_us : 0);
+    emitir("prazos_perdidos", saude_estatisticas()->prazos_perdidos);
+    emitir("watchdog_resets", sim_contadores.resets_watchdog);
+    emitir("sensores.lux_repetidos", sim_contadores.lux_repetidos);
+    emitir("sensores.cor_sem_integracao", sim_contadores.cor_sem_integracao);
+
+    emitir("info.amostras", med.amostras);
+    for (int k = 0; k < NUM_REGRAS_ALARME_LUX; k++) {
+        nome_chave(nome, sizeof(nome), alarmes_lux_nome(1u << k));
+        snprintf(chave, sizeof(chave), "info.alarmes.%s", nome);
+        emitir(chave, alarmes_lux.disparos[k]);
+    }
+    emitir("info.buzzer.notas", sim_contadores.notas_buzzer);
+    emitir("info.buzzer.ligado_ms", sim_contadores.buzzer_ligado_us / 1000.0);
+    emitir("info.clock.reduzido_pct", 100.0 * sim_contadores.clock_reduzido_us / duracao_atual_us);
+    emitir("info.adc.blocos", sim_contadores.blocos_adc);
+}
+
+// Chamada pelo relógio virtual no fim do cenário, de dentro do firmware
+static void terminar_cenario(void) {
+    sim_perifericos_fechar();
+    emitir_resultados();
+    fclose(saida_metricas);
+    _exit(0);
+}
+
+// --- Execução dos cenários ---
+
+static void executar_no_filho(const cenario_t *c, uint64_t duracao_us, int fd_metricas, const char *dir_logs) {
+    char caminho[512];
+    int fd_log;
+    if (dir_logs) {
+        snprintf(caminho, sizeof(caminho), "%s/%s.log", dir_logs, c->nome);
+        fd_log = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    } else {
+        fd_log = open("/dev/null", O_WRONLY);
+    }
+    if (fd_log < 0) {
+        perror(dir_logs ? caminho : "/dev/null");
+        _exit(2);
+    }
+    dup2(fd_log, STDOUT_FILENO);   // printf do firmware
+    close(fd_log);
+    saida_metricas = fdopen(fd_metricas, "w");
+    alarm(LIMITE_HOST_S);
+
+    duracao_atual_us = duracao_us;
+    memset(&med, 0, sizeof(med));
+    sim_init(c->estimulo, duracao_us, terminar_cenario);
+    if (c->agendar) c->agendar(duracao_us);
+    med.host_inicio_ns = med.desde_ns = agora_ns();
+    med.desde_blocos = blocos_executados;
+    firmware_main();
+    fprintf(stderr, "%s: firmware_main retornou\n", c->nome);
+    _exit(2);
+}
+
+static void adicionar_metrica(const char *prefixo, const char *chave, double valor) {
+    if (num_metricas >= MAX_METRICAS) return;
+    snprintf(metricas[num_metricas].chave, sizeof(metricas[num_metricas].chave), "%.31s%s%.95s",
+             prefixo, *prefixo ? "." : "", chave);
+    metricas[num_metricas].valor = valor;
+    num_metricas++;
+}
+
+static bool rodar_cenario(const cenario_t *c, uint64_t duracao_us, const char *dir_logs) {
+    int canal[2];
+    if (pipe(canal) != 0) {
+        perror("pipe");
+        return false;
+    }
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return false;
+    }
+    if (pid == 0) {
+        close(canal[0]);
+        executar_no_filho(c, duracao_us, canal[1], dir_logs);
+    }
+    close(canal[1]);
+
+    printf("== %s: %s\n", c->nome, c->descricao);
+    FILE *entrada = fdopen(canal[0], "r");
+    char chave[TAM_CHAVE];
+    double valor;
+    int recebidas = 0;
+    while (fscanf(entrada, "%95s %lf", chave, &valor) == 2) {
+        adicionar_metrica(c->nome, chave, valor);
+        printf("   %-40s %14.6g\n", chave, valor);
+        recebidas++;
+    }
+    fclose(entrada);
+
+    int status;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || recebidas == 0) {
+        fprintf(stderr, "%s: cenario falhou (%s %d)\n", c->nome,
+                WIFSIGNALED(status) ? "sinal" : "saida", WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status));
+        return false;
+    }
+    return true;
+}
+
+// --- Footprint ---
+
+// Flash = text + data (valores iniciais), RAM = data + bss, no formato Berkeley do size
+static bool medir_footprint(const char *elf, const char **origem) {
+    char comando[600], linha[512];
+    if (elf) {
+        snprintf(comando, sizeof(comando), "arm-none-eabi-size '%s' 2>/dev/null", elf);
+        *origem = "rp2040";
+    } else {
+        snprintf(comando, sizeof(comando), "size -t '%s' 2>/dev/null", BENCH_FIRMWARE_HOST);
+        *origem = "host";
+    }
+    FILE *p = popen(comando, "r");
+    if (!p) return false;
+    unsigned long text = 0, data = 0, bss = 0;
+    bool achou = false;
+    while (fgets(linha, sizeof(linha), p)) {
+        unsigned long t, d, b;
+        if (sscanf(linha, "%lu %lu %lu", &t, &d, &b) != 3) continue;
+        // Num arquivo .a a última linha é a dos totais
+        text = t;
+        data = d;
+        bss = b;
+        achou = true;
+    }
+    pclose(p);
+    if (!achou) return false;
+    adicionar_metrica("", "footprint.flash_bytes", text + data);
+    adicionar_metrica("", "footprint.ram_bytes", data + bss);
+    printf("== footprint (%s): flash %lu bytes, RAM %lu bytes\n", *origem, text + data, data + bss);
+    return true;
+}
+
+// --- JSON ---
+
+static bool gravar_json(const char *caminho, const char *origem, uint32_t duracao_s) {
+    FILE *f = fopen(caminho, "w");
+    if (!f) {
+        perror(caminho);
+        return false;
+    }
+    fprintf(f, "{\n  \"versao\": 1,\n  \"duracao_s\": %u,\n  \"footprint_origem\": \"%s\",\n  \"metricas\": {\n",
+            duracao_s, origem ? origem : "");
+    for (int i = 0; i < num_metricas; i++) {
+        fprintf(f, "    \"%s\": %.9g%s\n", metricas[i].chave, metricas[i].valor, i + 1 < num_metricas ? "," : "");
+    }
+    fprintf(f, "  }\n}\n");
+    fclose(f);
+    return true;
+}
+
+// Lê o JSON gravado por gravar_json(): só os campos de texto e o objeto "metricas"
+static int ler_json(const char *caminho, metrica_t *destino, int maximo, char *origem, size_t tam_origem) {
+    FILE *f = fopen(caminho, "r");
+    if (!f) {
+        perror(caminho);
+        return -1;
+    }
+    static char texto[1 << 20];
+    size_t n = fread(texto, 1, sizeof(texto) - 1, f);
+    fclose(f);
+    texto[n] = '\0';
+
+    origem[0] = '\0';
+    char *p = strstr(texto, "\"footprint_origem\"");
+    if (p && (p = strchr(p + 18, '"'))) {
+        char *fim = strchr(p + 1, '"');
+        if (fim && (size_t)(fim - p - 1) < tam_origem) {
+            memcpy(origem, p + 1, fim - p - 1);
+            origem[fim - p - 1] = '\0';
+        }
+    }
+
+    p = strstr(texto, "\"metricas\"");
+    if (!p || !(p = strchr(p, '{'))) {
+        fprintf(stderr, "%s: sem o objeto \"metricas\"\n", caminho);
+        return -1;
+    }
+    int total = 0;
+    while (total < maximo && (p = strchr(p, '"'))) {
+        char *fim = strchr(p + 1, '"');
+        if (!fim || (size_t)(fim - p - 1) >= sizeof(destino[total].chave)) break;
+        memcpy(destino[total].chave, p + 1, fim - p - 1);
+        destino[total].chave[fim - p - 1] = '\0';
+        p = strchr(fim, ':');
+        if (!p) break;
+        char *depois;
+        destino[total].valor = strtod(p + 1, &depois);
+        if (depois == p + 1) break;
+        total++;
+        p = depois;
+    }
+    return total;
+}
+
+// --- Comparação ---
+
+static const metrica_t *buscar(const metrica_t *m, int n, const char *chave) {
+    for (int i = 0; i < n; i++) {
+        if (strcmp(m[i].chave, chave) == 0) return &m[i];
+    }
+    return NULL;
+}
+
+// Tempo real do computador: muda com a carga da máquina, não entra no veredito
+static bool so_relatorio(const char *chave) {
+    return strncmp(chave, "host.", 5) == 0 || strstr(chave, ".host.") != NULL;
+}
+
+static int comparar(const char *caminho_base, const char *caminho_novo, double tolerancia) {
+    static metrica_t base[MAX_METRICAS], novo[MAX_METRICAS];
+    char origem_base[32], origem_novo[32];
+    int nb = ler_json(caminho_base, base, MAX_METRICAS, origem_base, sizeof(origem_base));
+    int nn = ler_json(caminho_novo, novo, MAX_METRICAS, origem_novo, sizeof(origem_novo));
+    if (nb < 0 || nn < 0) return 2;
+    bool footprint_comparavel = strcmp(origem_base, origem_novo) == 0;
+    if (!footprint_comparavel) {
+        printf("footprint medido em alvos diferentes (%s x %s): ignorado\n", origem_base, origem_novo);
+    }
+
+    int regressoes = 0, melhoras = 0, ausentes = 0;
+    printf("%-52s %14s %14s %9s\n", "metrica", "base", "novo", "variacao");
+    for (int i = 0; i < nb; i++) {
+        const metrica_t *b = &base[i];
+        if (strstr(b->chave, ".info.")) continue;
+        if (!footprint_comparavel && strncmp(b->chave, "footprint.", 10) == 0) continue;
+        const metrica_t *n = buscar(novo, nn, b->chave);
+        bool relatorio = so_relatorio(b->chave);
+        if (!n) {
+            printf("%-52s %14.6g %14s\n", b->chave, b->valor, "ausente");
+            if (!relatorio) ausentes++;
+            continue;
+        }
+        if (n->valor == b->valor) continue;
+
+        bool maior_melhor = strstr(b->chave, "_por_s") != NULL;
+        double piora = maior_melhor ? b->valor - n->valor : n->valor - b->valor;
+        double limite = fabs(b->valor) * tolerancia / 100.0;
+        const char *marca = "";
+        if (relatorio) {
+            marca = "  (host)";
+        } else if (piora > limite) {
+            marca = "  REGRESSAO";
+            regressoes++;
+        } else if (-piora > limite) {
+            marca = "  melhora";
+            melhoras++;
+        }
+        double variacao = b->valor != 0 ? 100.0 * (n->valor - b->valor) / fabs(b->valor) : INFINITY;
+        printf("%-52s %14.6g %14.6g %+8.1f%%%s\n", b->chave, b->valor, n->valor, variacao, marca);
+    }
+    for (int i = 0; i < nn; i++) {
+        if (!buscar(base, nb, novo[i].chave) && !strstr(novo[i].chave, ".info.")) {
+            printf("%-52s %14s %14.6g  nova\n", novo[i].chave, "-", novo[i].valor);
+        }
+    }
+    printf("%d regressoes, %d melhoras, %d ausentes (tolerancia %.1f%%; host.* so no relatorio)\n",
+           regressoes, melhoras, ausentes, tolerancia);
+    return regressoes || ausentes ? 1 : 0;
+}
+
+// --- Programa ---
+
+static void uso(void) {
+    fprintf(stderr,
+            "uso: bench [-c cenario] [-d segundos] [-j saida.json] [-l dir_logs] [-e firmware.elf]\n"
+            "     bench --comparar <base.json> <novo.json> [-t tolerancia_%%]\n"
+            "     bench --listar\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 4 && strcmp(argv[1], "--comparar") == 0) {
+        double tolerancia = TOLERANCIA_PADRAO;
+        for (int i = 4; i < argc; i++) {
+            if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+                tolerancia = strtod(argv[++i], NULL);
+            } else {
+                uso();
+                return 2;
+            }
+        }
+        return comparar(argv[2], argv[3], tolerancia);
+    }
+    if (argc == 2 && strcmp(argv[1], "--listar") == 0) {
+        for (size_t i = 0; i < num_cenarios; i++) printf("%-20s %s\n", cenarios[i].nome, cenarios[i].descricao);
+        return 0;
+    }
+
+    const char *nome_cenario = NULL, *json = NULL, *dir_logs = NULL, *elf = NULL;
+    long duracao_s = DURACAO_PADRAO_S;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            nome_cenario = argv[++i];
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            duracao_s = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            json = argv[++i];
+        } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+            dir_logs = argv[++i];
+        } else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+            elf = argv[++i];
+        } else {
+            uso();
+            return 2;
+        }
+    }
+    if (duracao_s < 1 || duracao_s > 3600) {
+        fprintf(stderr, "erro: duracao de 1 a 3600 s\n");
+        return 2;
+    }
+    if (nome_cenario && !cenario_buscar(nome_cenario)) {
+        fprintf(stderr, "erro: cenario desconhecido (use --listar)\n");
+        return 2;
+    }
+    if (dir_logs && mkdir(dir_logs, 0777) != 0 && errno != EEXIST) {
+        perror(dir_logs);
+        return 2;
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < num_cenarios; i++) {
+        if (nome_cenario && strcmp(cenarios[i].nome, nome_cenario) != 0) continue;
+        ok = rodar_cenario(&cenarios[i], duracao_s * 1000000ull, dir_logs) && ok;
+    }
+    const char *origem = NULL;
+    if (!medir_footprint(elf, &origem)) {
+        fprintf(stderr, "aviso: footprint indisponivel (%s)\n", elf ? "arm-none-eabi-size" : "size");
+    }
+    if (json && !gravar_json(json, origem, (uint32_t)duracao_s)) return 2;
+    return ok ? 0 : 2;
+}
@@ -0,0 +1,73 @@
+#include "cenarios.h"
+#include <string.h>
+
+#define BOTAO_B_GPIO          6       // O mesmo de main.c: próxima tela
+#define BOTAO_PERIODO_MS      2000
+#define BOTAO_DURACAO_MS      120
+#define TROCA_COR_MS          450     // Mais rápido que uma amostra: cada leitura vê outra cor
+#define LIMITES_PERIODO_MS    12000   // Rampa de lux que sobe e desce atravessando lux_min e lux_max
+#define LIMITES_LUX_MIN       5.0f
+#define LIMITES_LUX_MAX       160.0f
+
+// Contagens por ms com ganho 1x; o canal C soma os outros três com 10% a mais
+static sim_estimulo_t luz(float r, float g, float b, float lux, float fotodiodo, float cintilacao, float hz) {
+    return (sim_estimulo_t){ r, g, b, (r + g + b) * 1.1f, lux, fotodiodo, cintilacao, hz };
+}
+
+// --- Luz estável: lâmpada LED branca dentro dos limites ---
+
+static sim_estimulo_t estimulo_estavel(uint64_t t_us) {
+    return luz(9, 10, 8, 60, 1800, 0.08f, 100);
+}
+
+// --- Troca rápida de cor: seis cores em sequência e trocas de tela pelo botão B ---
+
+static sim_estimulo_t estimulo_troca_rapida(uint64_t t_us) {
+    static const float cores[][3] = {
+        { 16, 5, 7 },       // Vermelho
+        { 16, 9, 3 },       // Laranja
+        { 6, 6, 1.5f },     // Amarelo
+        { 4, 12, 5 },       // Verde
+        { 3, 6, 14 },       // Azul
+        { 10, 10, 10 },     // Branco
+    };
+    uint32_t i = (uint32_t)(t_us / (TROCA_COR_MS * 1000ull)) % 6;
+    return luz(cores[i][0], cores[i][1], cores[i][2], 45 + 8 * i, 1500, 0.05f, 120);
+}
+
+static void agendar_botoes(uint64_t duracao_us) {
+    for (uint64_t t = BOTAO_PERIODO_MS * 1000ull; t < duracao_us; t += BOTAO_PERIODO_MS * 1000ull) {
+        sim_pressionar_botao(BOTAO_B_GPIO, t, BOTAO_DURACAO_MS);
+    }
+}
+
+// --- Cruza limites: lux em rampa triangular de 5 a 160 ---
+
+static sim_estimulo_t estimulo_limites(uint64_t t_us) {
+    float fase = (float)(t_us % (LIMITES_PERIODO_MS * 1000ull)) / (LIMITES_PERIODO_MS * 1000.0f);
+    float subida = fase < 0.5f ? 2 * fase : 2 * (1 - fase);
+    float lux = LIMITES_LUX_MIN + (LIMITES_LUX_MAX - LIMITES_LUX_MIN) * subida;
+    float k = lux / 60;
+    return luz(9 * k, 10 * k, 8 * k, lux, 30 * lux, 0.3f, 100);
+}
+
+// --- Sensor saturado: luz direta acima do fundo de escala dos três sensores ---
+
+static sim_estimulo_t estimulo_saturado(uint64_t t_us) {
+    return luz(3000, 3000, 3000, 80000, 4500, 0, 100);
+}
+
+const cenario_t cenarios[] = {
+    { "luz_estavel", "Branco a 60 lux, cintilacao de 8% a 100 Hz", estimulo_estavel, NULL },
+    { "troca_rapida_cor", "Seis cores a cada 450 ms e botao B a cada 2 s", estimulo_troca_rapida, agendar_botoes },
+    { "cruza_limites", "Rampa de 5 a 160 lux em 12 s, cintilacao de 30%", estimulo_limites, NULL },
+    { "sensor_saturado", "GY-33, BH1750 e ADC acima do fundo de escala", estimulo_saturado, NULL },
+};
+const size_t num_cenarios = sizeof(cenarios) / sizeof(cenarios[0]);
+
+const cenario_t *cenario_buscar(const char *nome) {
+    for (size_t i = 0; i < num_cenarios; i++) {
+        if (strcmp(cenarios[i].nome, nome) == 0) return &cenarios[i];
+    }
+    return NULL;
+}
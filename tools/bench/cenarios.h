@@ -0,0 +1,24 @@
+#ifndef CENARIOS_H
+#define CENARIOS_H
+
+#include <stddef.h>
+#include "sim/sim.h"
+
+/* ---------- Cenários reproduzíveis do bench ----------
+ * Cada um define o que os sensores veem ao longo do tempo e, se for o
+ * caso, os botões pressionados. Mudar um cenário muda as métricas dele:
+ * gere uma nova referência (--json) antes de comparar. */
+
+typedef struct {
+    const char *nome;
+    const char *descricao;
+    sim_funcao_estimulo_t estimulo;
+    void (*agendar)(uint64_t duracao_us);   // Eventos externos (botões), ou NULL
+} cenario_t;
+
+extern const cenario_t cenarios[];
+extern const size_t num_cenarios;
+
+const cenario_t *cenario_buscar(const char *nome);
+
+#endif // CENARIOS_H
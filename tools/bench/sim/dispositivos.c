@@ -0,0 +1,226 @@
+/* Modelos dos dispositivos I2C da placa: GY-33 (TCS34725), BH1750 e SSD1306.
+ * Só o comportamento que os drivers usam: registradores do TCS34725 com
+ * integração, saturação e o AINT (só APERS = 0: todo ciclo), medição contínua
+ * do BH1750 e um display que aceita qualquer escrita. As leituras seguem o
+ * estímulo do cenário no instante da transação (ou do fim da integração em
+ * curso). Com sim_dispositivos_mux(), o GY-33 da placa dá lugar a um TCA9548A
+ * com um TCS34725 em cada canal pedido. */
+
+#include <string.h>
+#include "sim.h"
+
+#define GY33_ENDERECO      0x29
+#define BH1750_ENDERECO    0x23
+#define SSD1306_ENDERECO   0x3C
+#define TCA9548A_ENDERECO  0x70
+#define TCA_CANAIS         8
+
+#define TCS_AUTO_INCREMENTO 0x20
+#define TCS_FUNCAO_ESPECIAL 0x60    // Tipo de comando: função especial no campo de endereço
+#define TCS_LIMPAR_AINT    0x06
+#define TCS_ENABLE         0x00
+#define TCS_ATIME          0x01
+#define TCS_PERS           0x0C
+#define TCS_CONTROL        0x0F
+#define TCS_ID             0x12
+#define TCS_STATUS         0x13
+#define TCS_CDATA          0x14     // C, R, G, B: 16 bits cada, LSB primeiro
+#define TCS_PON_AEN        0x03
+#define TCS_AIEN           0x10
+#define TCS_AVALID         0x01
+#define TCS_AINT           0x10
+#define TCS_CICLO_US       2400     // Cada passo do ATIME
+
+#define BH1750_MEDICAO_US  120000   // Alta resolução: 120 ms típicos
+#define BH1750_CONTAGENS_POR_LUX 1.2f
+
+typedef struct {
+    uint8_t reg[32];
+    uint8_t ponteiro;
+    bool integrando;
+    uint64_t inicio_us;          // Começo da primeira integração depois de PON+AEN
+    uint64_t ciclo_lido;         // Integração já convertida em contagens (0 = nenhuma)
+    uint64_t ciclo_entregue;     // Integração da última leitura de CDATA
+    uint32_t ciclos_entregues;   // Leituras de CDATA que pegaram uma integração nova
+    bool aint;
+    float oscilador;             // Duração real de um ciclo do ADC / nominal
+    uint16_t canais[4];          // C, R, G, B da última integração completa
+} tcs34725_t;
+
+typedef struct {
+    bool ligado, medindo;
+    uint64_t inicio_us;
+    uint64_t medicao_lida;
+    uint16_t valor;
+} bh1750_t;
+
+static tcs34725_t tcs_placa;
+static tcs34725_t tcs_mux[TCA_CANAIS];
+static uint8_t mux_povoados;     // Bit i: há um TCS34725 no canal i (0 = sem multiplexador)
+static uint8_t mux_selecao;
+static bh1750_t bh;
+
+// --- GY-33 (TCS34725) ---
+
+static uint16_t saturar(float contagens, uint32_t maximo) {
+    if (contagens < 0) return 0;
+    return contagens > maximo ? maximo : (uint16_t)contagens;
+}
+
+// Converte a última integração completa, se houver uma nova desde a leitura anterior
+static void tcs_atualizar(tcs34725_t *tcs) {
+    uint32_t passos = 256 - tcs->reg[TCS_ATIME];
+    uint64_t integracao_us = (uint64_t)(passos * TCS_CICLO_US * tcs->oscilador);
+    if (!tcs->integrando) return;
+    uint64_t ciclo = (sim_agora_us() - tcs->inicio_us) / integracao_us;
+    if (ciclo == 0 || ciclo == tcs->ciclo_lido) return;
+    tcs->ciclo_lido = ciclo;
+    if ((tcs->reg[TCS_ENABLE] & TCS_AIEN) && (tcs->reg[TCS_PERS] & 0x0F) == 0) tcs->aint = true;
+
+    static const float ganhos[4] = { 1, 4, 16, 60 };
+    sim_estimulo_t e = sim_estimulo(tcs->inicio_us + ciclo * integracao_us);
+    float escala = integracao_us / 1000.0f * ganhos[tcs->reg[TCS_CONTROL] & 3];
+    uint32_t maximo = passos * 1024 > 65535 ? 65535 : passos * 1024;
+    tcs->canais[0] = saturar(e.c * escala, maximo);
+    tcs->canais[1] = saturar(e.r * escala, maximo);
+    tcs->canais[2] = saturar(e.g * escala, maximo);
+    tcs->canais[3] = saturar(e.b * escala, maximo);
+}
+
+static void tcs_escrever(tcs34725_t *tcs, uint8_t reg, uint8_t valor) {
+    if (reg == TCS_ENABLE) {
+        bool liga = (valor & TCS_PON_AEN) == TCS_PON_AEN;
+        if (liga && !tcs->integrando) {
+            tcs->inicio_us = sim_agora_us();
+            tcs->ciclo_lido = tcs->ciclo_entregue = 0;
+        }
+        tcs->integrando = liga;
+    }
+    tcs->reg[reg] = valor;
+}
+
+static uint8_t tcs_ler(tcs34725_t *tcs, uint8_t reg) {
+    if (reg == TCS_ID) return 0x44;
+    tcs_atualizar(tcs);
+    if (reg == TCS_STATUS) return (tcs->ciclo_lido > 0 ? TCS_AVALID : 0) | (tcs->aint ? TCS_AINT : 0);
+    if (reg >= TCS_CDATA && reg < TCS_CDATA + 8) {
+        if (reg == TCS_CDATA) {
+            if (tcs->ciclo_lido == 0) sim_contadores.cor_sem_integracao++;
+            else if (tcs->ciclo_lido != tcs->ciclo_entregue) tcs->ciclos_entregues++;
+            tcs->ciclo_entregue = tcs->ciclo_lido;
+        }
+        uint16_t canal = tcs->canais[(reg - TCS_CDATA) / 2];
+        return (reg & 1) ? canal >> 8 : canal & 0xFF;
+    }
+    return tcs->reg[reg];
+}
+
+static void tcs_transacao(tcs34725_t *tcs, const uint8_t *escrita, uint16_t tam_escrita,
+                          uint8_t *leitura, uint16_t tam_leitura) {
+    bool incrementar = true;
+    if (tam_escrita > 0) {
+        if ((escrita[0] & 0x60) == TCS_FUNCAO_ESPECIAL) {
+            if ((escrita[0] & 0x1F) == TCS_LIMPAR_AINT) tcs->aint = false;
+            return;
+        }
+        tcs->ponteiro = escrita[0] & 0x1F;
+        incrementar = (escrita[0] & 0x60) == TCS_AUTO_INCREMENTO;
+        for (uint16_t i = 1; i < tam_escrita; i++) {
+            tcs_escrever(tcs, tcs->ponteiro, escrita[i]);
+            if (incrementar) tcs->ponteiro = (tcs->ponteiro + 1) & 0x1F;
+        }
+    }
+    for (uint16_t i = 0; i < tam_leitura; i++) {
+        leitura[i] = tcs_ler(tcs, tcs->ponteiro);
+        if (incrementar) tcs->ponteiro = (tcs->ponteiro + 1) & 0x1F;
+    }
+}
+
+// Sensor que responde em 0x29: o da placa ou o do canal selecionado no multiplexador
+static tcs34725_t *tcs_no_endereco(void) {
+    if (!mux_povoados) return &tcs_placa;
+    uint8_t respondem = mux_selecao & mux_povoados;
+    if (!respondem) return NULL;
+    return &tcs_mux[__builtin_ctz(respondem)];
+}
+
+// --- BH1750 ---
+
+static void bh_transacao(const uint8_t *escrita, uint16_t tam_escrita, uint8_t *leitura, uint16_t tam_leitura) {
+    for (uint16_t i = 0; i < tam_escrita; i++) {
+        uint8_t cmd = escrita[i];
+        if (cmd == 0x00) {
+            bh.ligado = bh.medindo = false;
+        } else if (cmd == 0x01) {
+            bh.ligado = true;
+        } else if (cmd == 0x07) {
+            bh.valor = 0;
+        } else if (bh.ligado && (cmd & 0xF0) == 0x10) {  // Modos contínuos
+            bh.medindo = true;
+            bh.inicio_us = sim_agora_us();
+            bh.medicao_lida = 0;
+        }
+    }
+    if (tam_leitura == 0) return;
+
+    uint64_t medicao = bh.medindo ? (sim_agora_us() - bh.inicio_us) / BH1750_MEDICAO_US : 0;
+    if (medicao > 0 && medicao != bh.medicao_lida) {
+        float lux = sim_estimulo(bh.inicio_us + medicao * BH1750_MEDICAO_US).lux;
+        bh.valor = saturar(lux * BH1750_CONTAGENS_POR_LUX + 0.5f, 65535);
+        bh.medicao_lida = medicao;
+    } else {
+        sim_contadores.lux_repetidos++;
+    }
+    leitura[0] = bh.valor >> 8;
+    if (tam_leitura > 1) leitura[1] = bh.valor & 0xFF;
+    for (uint16_t i = 2; i < tam_leitura; i++) leitura[i] = 0xFF;
+}
+
+// --- Interface com o barramento ---
+
+static void tcs_iniciar(tcs34725_t *tcs, float oscilador) {
+    memset(tcs, 0, sizeof(*tcs));
+    tcs->reg[TCS_ATIME] = 0xFF;
+    tcs->oscilador = oscilador;
+}
+
+void sim_dispositivos_init(void) {
+    tcs_iniciar(&tcs_placa, 1.0f);
+    mux_povoados = mux_selecao = 0;
+    memset(&bh, 0, sizeof(bh));
+}
+
+void sim_dispositivos_mux(uint8_t canais, const float oscilador[8]) {
+    mux_povoados = canais;
+    mux_selecao = 0;
+    for (int i = 0; i < TCA_CANAIS; i++) tcs_iniciar(&tcs_mux[i], oscilador ? oscilador[i] : 1.0f);
+}
+
+uint32_t sim_dispositivos_ciclos_entregues(uint8_t canal) {
+    return tcs_mux[canal].ciclos_entregues;
+}
+
+bool sim_dispositivo_presente(uint8_t endereco) {
+    if (endereco == TCA9548A_ENDERECO) return mux_povoados != 0;
+    if (endereco == GY33_ENDERECO) return tcs_no_endereco() != NULL;
+    return endereco == BH1750_ENDERECO || endereco == SSD1306_ENDERECO;
+}
+
+void sim_dispositivo_transacao(uint8_t endereco, const uint8_t *escrita, uint16_t tam_escrita,
+                               uint8_t *leitura, uint16_t tam_leitura) {
+    switch (endereco) {
+    case GY33_ENDERECO:
+        tcs_transacao(tcs_no_endereco(), escrita, tam_escrita, leitura, tam_leitura);
+        break;
+    case BH1750_ENDERECO:
+        bh_transacao(escrita, tam_escrita, leitura, tam_leitura);
+        break;
+    case TCA9548A_ENDERECO:      // Um byte escrito é a máscara de canais; a leitura a devolve
+        if (tam_escrita) mux_selecao = escrita[tam_escrita - 1];
+        if (tam_leitura) memset(leitura, mux_selecao, tam_leitura);
+        break;
+    default:                     // SSD1306: só recebe
+        if (tam_leitura) memset(leitura, 0, tam_leitura);
+        break;
+    }
+}
@@ -0,0 +1,18 @@
+#ifndef SIM_HARDWARE_CLOCKS_H
+#define SIM_HARDWARE_CLOCKS_H
+
+#include "pico/stdlib.h"
+
+enum clock_index { clk_gpout0, clk_gpout1, clk_gpout2, clk_gpout3, clk_ref, clk_sys, clk_peri, clk_usb, clk_adc, clk_rtc, CLK_COUNT };
+
+#define CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX 1
+#define CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS 0
+#define CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB 1
+#define CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB 2
+#define USB_CLK_KHZ 48000
+#define SYS_CLK_KHZ 125000
+
+uint32_t clock_get_hz(enum clock_index clk);
+bool clock_configure(enum clock_index clk, uint32_t src, uint32_t auxsrc, uint32_t src_freq, uint32_t freq);
+
+#endif // SIM_HARDWARE_CLOCKS_H
@@ -0,0 +1,12 @@
+/* Só os tipos: as transações passam pelo i2c_barramento simulado (sim/i2c_simulado.c) */
+#ifndef SIM_HARDWARE_I2C_H
+#define SIM_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+typedef struct i2c_inst { uint8_t indice; } i2c_inst_t;
+extern i2c_inst_t i2c0_inst, i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+#endif // SIM_HARDWARE_I2C_H
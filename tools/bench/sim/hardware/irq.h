@@ -0,0 +1,18 @@
+#ifndef SIM_HARDWARE_IRQ_H
+#define SIM_HARDWARE_IRQ_H
+
+#include "pico/stdlib.h"
+
+typedef void (*irq_handler_t)(void);
+
+enum { TIMER_IRQ_0 = 0, PIO0_IRQ_0 = 7, PIO0_IRQ_1 = 8, PIO1_IRQ_0 = 9, PIO1_IRQ_1 = 10, DMA_IRQ_0 = 11,
+       DMA_IRQ_1 = 12, IO_IRQ_BANK0 = 13, I2C0_IRQ = 23, I2C1_IRQ = 24, NUM_IRQS = 32 };
+#define PICO_DEFAULT_IRQ_PRIORITY 0x80
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority);
+void irq_set_enabled(uint num, bool enabled);
+void irq_set_priority(uint num, uint8_t priority);
+
+#endif // SIM_HARDWARE_IRQ_H
@@ -0,0 +1,37 @@
+#ifndef SIM_HARDWARE_PIO_H
+#define SIM_HARDWARE_PIO_H
+
+#include "pico/stdlib.h"
+
+typedef struct { volatile uint32_t ctrl, fstat, fdebug, flevel, txf[4], rxf[4]; } pio_hw_t;
+typedef pio_hw_t *PIO;
+extern pio_hw_t pio0_hw_, pio1_hw_;
+#define pio0 (&pio0_hw_)
+#define pio1 (&pio1_hw_)
+
+typedef struct { uint32_t clkdiv, execctrl, shiftctrl, pinctrl; } pio_sm_config;
+struct pio_program { const uint16_t *instructions; uint8_t length; int8_t origin; uint8_t pio_version; };
+typedef struct pio_program pio_program_t;
+enum pio_fifo_join { PIO_FIFO_JOIN_NONE, PIO_FIFO_JOIN_TX, PIO_FIFO_JOIN_RX };
+
+uint pio_add_program(PIO pio, const pio_program_t *program);
+void pio_sm_claim(PIO pio, uint sm);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_gpio_init(PIO pio, uint pin);
+pio_sm_config pio_get_default_sm_config(void);
+void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap);
+void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs);
+void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base);
+void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count);
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold);
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join);
+void sm_config_set_clkdiv(pio_sm_config *c, float div);
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out);
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div);
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx);
+
+#endif // SIM_HARDWARE_PIO_H
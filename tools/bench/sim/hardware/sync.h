@@ -0,0 +1,13 @@
+#ifndef SIM_HARDWARE_SYNC_H
+#define SIM_HARDWARE_SYNC_H
+
+#include "pico/stdlib.h"
+
+// O tempo virtual só anda nas esperas: nada interrompe uma seção crítica
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t status) { (void)status; }
+#define __wfe() do {} while (0)
+#define __wfi() do {} while (0)
+#define __sev() do {} while (0)
+
+#endif // SIM_HARDWARE_SYNC_H
@@ -0,0 +1,14 @@
+#ifndef SIM_HARDWARE_WATCHDOG_H
+#define SIM_HARDWARE_WATCHDOG_H
+
+#include "pico/stdlib.h"
+
+typedef struct { volatile uint32_t ctrl, load, reason, scratch[8], tick; } watchdog_hw_t;
+extern watchdog_hw_t *watchdog_hw;
+
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug);
+void watchdog_update(void);
+bool watchdog_caused_reboot(void);
+bool watchdog_enable_caused_reboot(void);
+
+#endif // SIM_HARDWARE_WATCHDOG_H
@@ -0,0 +1,157 @@
+/* i2c_barramento.h sobre barramentos simulados (substitui lib/i2c_barramento.c no bench).
+ *
+ * Os registradores do bloco I2C e as instruções do PIO não são emulados: cada
+ * transação ocupa o barramento pelo tempo dos seus bits na velocidade pedida
+ * (9 por byte, mais START, RESTART e STOP), em fila, e o dispositivo responde
+ * quando ela termina. Fila, limites de velocidade, status e callbacks seguem
+ * o contrato de i2c_barramento.h, que é o que os drivers enxergam. */
+
+#include <string.h>
+#include "sim.h"
+#include "i2c_barramento.h"
+
+#define SOBRECARGA_US 4              // Preparo da transação e interrupção final
+#define MAX_PENDENTES (SIM_NUM_BARRAMENTOS * I2C_FILA_TAM)
+
+typedef struct {
+    bool ativo;
+    i2c_barramento_t *bar;
+    i2c_transacao_t *transacao;
+    sim_barramento_t indice;
+    uint32_t bytes;
+} pendente_t;
+
+i2c_inst_t i2c0_inst = { 0 }, i2c1_inst = { 1 };
+
+static uint64_t livre_em[SIM_NUM_BARRAMENTOS];
+static pendente_t pendentes[MAX_PENDENTES];
+
+// --- Funções Internas ---
+
+static sim_barramento_t indice_barramento(const i2c_barramento_t *bar) {
+    if (bar->i2c == NULL) return SIM_I2C_PIO;
+    return bar->i2c == i2c1 ? SIM_I2C1 : SIM_I2C0;
+}
+
+static void concluir(void *dados) {
+    pendente_t *p = dados;
+    i2c_transacao_t *t = p->transacao;
+    sim_contadores_i2c_t *cont = &sim_contadores.i2c[p->indice];
+    p->ativo = false;
+
+    if (sim_dispositivo_presente(t->endereco)) {
+        sim_dispositivo_transacao(t->endereco, t->escrita, t->tam_escrita, t->leitura, t->tam_leitura);
+        t->status = I2C_TRANSACAO_OK;
+        p->bar->total_ok++;
+    } else {
+        t->status = I2C_TRANSACAO_NACK;
+        p->bar->total_nack++;
+        cont->nacks++;
+    }
+    cont->bytes += p->bytes;
+    cont->transacoes++;
+    p->bar->ocupados--;
+    if (p->bar->ocupados == 0) p->bar->atual = NULL;
+    if (t->callback) t->callback(t);
+}
+
+// --- Funções Públicas ---
+
+void sim_i2c_init(void) {
+    memset(livre_em, 0, sizeof(livre_em));
+    memset(pendentes, 0, sizeof(pendentes));
+}
+
+void i2c_barramento_init(i2c_barramento_t *bar, i2c_inst_t *i2c, uint sda_pin, uint scl_pin, uint32_t baudrate) {
+    *bar = (i2c_barramento_t){
+        .i2c = i2c,
+        .sda_pin = sda_pin,
+        .scl_pin = scl_pin,
+        .baudrate_padrao = baudrate,
+        .baudrate_atual = baudrate,
+    };
+}
+
+bool i2c_barramento_init_pio(i2c_barramento_t *bar, PIO pio, uint sda_pin, uint32_t baudrate) {
+    i2c_barramento_init(bar, NULL, sda_pin, sda_pin + 1, baudrate);
+    bar->pio = pio;
+    return true;
+}
+
+bool i2c_barramento_enfileirar(i2c_barramento_t *bar, i2c_transacao_t *transacao) {
+    sim_barramento_t k = indice_barramento(bar);
+    pendente_t *p = NULL;
+    for (int i = 0; i < MAX_PENDENTES && !p; i++) {
+        if (!pendentes[i].ativo) p = &pendentes[i];
+    }
+    if (bar->ocupados >= I2C_FILA_TAM || !p) {
+        transacao->status = I2C_TRANSACAO_FILA_CHEIA;
+        sim_contadores.i2c[k].fila_cheia++;
+        return false;
+    }
+
+    uint32_t baudrate = transacao->baudrate ? transacao->baudrate : bar->baudrate_padrao;
+    if (bar->baudrate_maximo && baudrate > bar->baudrate_maximo) baudrate = bar->baudrate_maximo;
+    bar->baudrate_atual = baudrate;
+
+    // Sem resposta ao endereço a transação para no primeiro byte
+    uint32_t bytes = 1;
+    if (sim_dispositivo_presente(transacao->endereco)) {
+        bytes = transacao->tam_escrita + transacao->tam_leitura + 1;
+        if (transacao->tam_escrita && transacao->tam_leitura) bytes++;  // Endereço de novo depois do RESTART
+    }
+    uint32_t bits = 9 * bytes + 2;
+    uint64_t duracao = SOBRECARGA_US + (bits * 1000000ull + baudrate - 1) / baudrate;
+    uint64_t inicio = livre_em[k] > sim_agora_us() ? livre_em[k] : sim_agora_us();
+    livre_em[k] = inicio + duracao;
+    sim_contadores.i2c[k].ocupado_us += duracao;
+
+    *p = (pendente_t){ .ativo = true, .bar = bar, .transacao = transacao, .indice = k, .bytes = bytes };
+    transacao->status = I2C_TRANSACAO_PENDENTE;
+    bar->ocupados++;
+    if (!bar->atual) bar->atual = transacao;
+    sim_agendar(livre_em[k], concluir, p);
+    return true;
+}
+
+i2c_status_t i2c_barramento_aguardar(const i2c_transacao_t *transacao) {
+    while (transacao->status == I2C_TRANSACAO_PENDENTE && sim_avancar_um(UINT64_MAX)) {
+    }
+    return transacao->status;
+}
+
+i2c_status_t i2c_barramento_transferir(i2c_barramento_t *bar, uint8_t endereco, uint32_t baudrate,
+                                       const uint8_t *escrita, uint16_t tam_escrita,
+                                       uint8_t *leitura, uint16_t tam_leitura) {
+    i2c_transacao_t t = {
+        .endereco = endereco,
+        .escrita = escrita,
+        .tam_escrita = tam_escrita,
+        .leitura = leitura,
+        .tam_leitura = tam_leitura,
+        .baudrate = baudrate,
+    };
+    if (!i2c_barramento_enfileirar(bar, &t)) return t.status;
+    return i2c_barramento_aguardar(&t);
+}
+
+void i2c_barramento_limitar_baudrate(i2c_barramento_t *bar, uint32_t baudrate_maximo) {
+    bar->baudrate_maximo = baudrate_maximo;
+}
+
+bool i2c_barramento_ocupado(const i2c_barramento_t *bar) {
+    return bar->ocupados > 0;
+}
+
+void i2c_barramento_recuperar(i2c_barramento_t *bar) {
+    bar->total_recuperacoes++;
+}
+
+void i2c_barramento_mudanca_clock(i2c_barramento_t *bar, bool antes, uint32_t clk_sys_hz) {
+    if (antes) {
+        while (i2c_barramento_ocupado(bar) && sim_avancar_um(UINT64_MAX)) {
+        }
+    } else {
+        bar->clk_sys_hz = clk_sys_hz;
+    }
+}
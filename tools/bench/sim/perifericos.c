@@ -0,0 +1,434 @@
+/* GPIO, PWM, clocks, flash, ADC, DMA e PIO da placa simulada */
+
+#include <math.h>
+#include <string.h>
+#include "sim.h"
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/flash.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "hardware/pwm.h"
+
+#define NUM_GPIOS         30
+#define NUM_SLICES        8
+#define ADC_CLK_HZ        48000000.0
+#define ADC_RUIDO         6          // Pico do ruído somado a cada amostra do fotodiodo
+#define WS2812_BITS       24         // Por pixel (RGB)
+#define WS2812_BAUD       800000
+
+typedef struct {
+    dma_channel_config config;
+    bool reservado;
+    volatile void *escrita;
+    const volatile void *leitura;
+    uint32_t quantidade;
+    bool ocupado;
+    uint64_t fim_us;
+    bool irq1_habilitada, irq1_pendente;
+    uint32_t geracao;            // Descarta a conclusão de uma transferência abortada
+} canal_dma_t;
+
+typedef struct {
+    uint8_t div_int, div_frac;
+    uint16_t wrap;
+} slice_pwm_t;
+
+uint8_t sim_flash[PICO_FLASH_SIZE_BYTES];
+pio_hw_t pio0_hw_, pio1_hw_;
+static adc_hw_t adc_simulado;
+adc_hw_t *adc_hw = &adc_simulado;
+
+static bool nivel[NUM_GPIOS];
+static uint32_t irq_gpio[NUM_GPIOS];
+static gpio_irq_callback_t callback_gpio;
+static slice_pwm_t slices[NUM_SLICES];
+static bool tocando[NUM_GPIOS];
+static uint64_t inicio_nota[NUM_GPIOS];
+static uint32_t clocks[CLK_COUNT];
+static uint64_t inicio_clock_reduzido;
+static canal_dma_t canais[NUM_DMA_CHANNELS];
+static uint8_t maquinas_reservadas[2];   // Bit por máquina de estados de pio0 e pio1
+static float adc_taxa_hz;
+static uint32_t ruido;
+
+// --- GPIO e botões ---
+
+void gpio_init(uint gpio) {
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+}
+
+void gpio_pull_up(uint gpio) {
+}
+
+void gpio_disable_pulls(uint gpio) {
+}
+
+void gpio_set_oeover(uint gpio, uint value) {
+}
+
+void gpio_put(uint gpio, bool value) {
+    if (gpio < NUM_GPIOS) nivel[gpio] = value;
+}
+
+bool gpio_get(uint gpio) {
+    return gpio < NUM_GPIOS && nivel[gpio];
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled) {
+    if (gpio >= NUM_GPIOS) return;
+    irq_gpio[gpio] = enabled ? irq_gpio[gpio] | events : irq_gpio[gpio] & ~events;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t events, bool enabled, gpio_irq_callback_t callback) {
+    gpio_set_irq_enabled(gpio, events, enabled);
+    callback_gpio = callback;
+}
+
+static void mudar_nivel(uint gpio, bool alto) {
+    if (nivel[gpio] == alto) return;
+    nivel[gpio] = alto;
+    uint32_t borda = alto ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+    if ((irq_gpio[gpio] & borda) && callback_gpio) callback_gpio(gpio, borda);
+}
+
+static void soltar(void *dados) {
+    mudar_nivel((uint)(uintptr_t)dados, true);
+}
+
+static void apertar(void *dados) {
+    if (sim_contadores.pressoes < SIM_MAX_PRESSOES) {
+        sim_contadores.pressoes_us[sim_contadores.pressoes++] = sim_agora_us();
+    }
+    mudar_nivel((uint)(uintptr_t)dados, false);
+}
+
+void sim_pressionar_botao(unsigned gpio, uint64_t quando_us, uint32_t duracao_ms) {
+    if (gpio >= NUM_GPIOS) return;
+    sim_agendar(quando_us, apertar, (void *)(uintptr_t)gpio);
+    sim_agendar(quando_us + duracao_ms * 1000ull, soltar, (void *)(uintptr_t)gpio);
+}
+
+// --- PWM (buzzer): notas e tempo ligado ---
+
+pwm_config pwm_get_default_config(void) {
+    return (pwm_config){ .div = 1 << 4, .top = 0xFFFF };
+}
+
+void pwm_init(uint slice_num, pwm_config *c, bool start) {
+    slices[slice_num & 7] = (slice_pwm_t){ .div_int = c->div >> 4, .div_frac = c->div & 0xF, .wrap = c->top };
+}
+
+void pwm_set_clkdiv_int_frac(uint slice_num, uint8_t integer, uint8_t fract) {
+    slices[slice_num & 7].div_int = integer;
+    slices[slice_num & 7].div_frac = fract;
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {
+    slices[slice_num & 7].wrap = wrap;
+}
+
+void pwm_set_enabled(uint slice_num, bool enabled) {
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level) {
+    if (gpio >= NUM_GPIOS) return;
+    if (level > 0 && !tocando[gpio]) {
+        tocando[gpio] = true;
+        inicio_nota[gpio] = sim_agora_us();
+        sim_contadores.notas_buzzer++;
+    } else if (level == 0 && tocando[gpio]) {
+        tocando[gpio] = false;
+        sim_contadores.buzzer_ligado_us += sim_agora_us() - inicio_nota[gpio];
+    }
+}
+
+// --- Clocks ---
+
+uint32_t clock_get_hz(enum clock_index clk) {
+    return clocks[clk];
+}
+
+bool clock_configure(enum clock_index clk, uint32_t src, uint32_t auxsrc, uint32_t src_freq, uint32_t freq) {
+    if (clk == clk_sys && freq != clocks[clk_sys]) {
+        sim_contadores.mudancas_clock++;
+        bool reduzido = clocks[clk_sys] < SYS_CLK_KHZ * 1000;
+        if (freq < SYS_CLK_KHZ * 1000 && !reduzido) {
+            inicio_clock_reduzido = sim_agora_us();
+        } else if (freq >= SYS_CLK_KHZ * 1000 && reduzido) {
+            sim_contadores.clock_reduzido_us += sim_agora_us() - inicio_clock_reduzido;
+        }
+    }
+    clocks[clk] = freq;
+    return true;
+}
+
+// --- Flash ---
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    memset(&sim_flash[flash_offs], 0xFF, count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    for (size_t i = 0; i < count; i++) sim_flash[flash_offs + i] &= data[i];
+}
+
+// --- ADC: o fotodiodo segue o estímulo do cenário ---
+
+void adc_init(void) {
+}
+
+void adc_gpio_init(uint gpio) {
+}
+
+void adc_select_input(uint input) {
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+}
+
+void adc_set_clkdiv(float clkdiv) {
+    adc_taxa_hz = ADC_CLK_HZ / (1.0 + clkdiv);
+}
+
+void adc_run(bool run) {
+}
+
+static uint16_t amostra_fotodiodo(uint64_t t_us) {
+    sim_estimulo_t e = sim_estimulo(t_us);
+    ruido = ruido * 1103515245u + 12345u;     // Determinístico: o mesmo sinal a cada execução
+    float t = t_us * 1e-6f;
+    float v = e.fotodiodo * (1.0f + e.cintilacao * sinf(2.0f * (float)M_PI * e.cintilacao_hz * t));
+    v += (float)((int32_t)((ruido >> 16) % (2 * ADC_RUIDO + 1)) - ADC_RUIDO);
+    if (v < 0) v = 0;
+    if (v > 4095) v = 4095;
+    return (uint16_t)v;
+}
+
+// --- DMA: ADC em ping-pong e quadros da matriz para o PIO ---
+
+static void iniciar_canal(uint ch);
+
+static void concluir_canal(void *dados) {
+    uintptr_t v = (uintptr_t)dados;
+    uint ch = v & 0xFF;
+    canal_dma_t *c = &canais[ch];
+    if (!c->ocupado || c->geracao != (v >> 8)) return;
+
+    if (c->config.dreq == DREQ_ADC) {
+        volatile uint16_t *destino = c->escrita;
+        uint64_t inicio = c->fim_us - (uint64_t)(c->quantidade * 1e6 / adc_taxa_hz);
+        for (uint32_t i = 0; i < c->quantidade; i++) {
+            destino[i] = amostra_fotodiodo(inicio + (uint64_t)(i * 1e6 / adc_taxa_hz));
+        }
+        sim_contadores.blocos_adc++;
+    } else if (c->config.dreq != DREQ_FORCE) {
+        sim_contadores.quadros_ws2812++;
+    }
+    c->ocupado = false;
+    if (c->config.encadear != ch) iniciar_canal(c->config.encadear);
+    if (c->irq1_habilitada) {
+        c->irq1_pendente = true;
+        sim_disparar_irq(DMA_IRQ_1);
+    }
+}
+
+static void iniciar_canal(uint ch) {
+    canal_dma_t *c = &canais[ch];
+    uint64_t duracao_us = 0;
+    if (c->config.dreq == DREQ_ADC) {
+        duracao_us = (uint64_t)(c->quantidade * 1e6 / adc_taxa_hz);
+    } else if (c->config.dreq != DREQ_FORCE) {
+        duracao_us = (uint64_t)c->quantidade * WS2812_BITS * 1000000ull / WS2812_BAUD;
+    }
+    c->ocupado = true;
+    c->geracao++;
+    c->fim_us = sim_agora_us() + duracao_us;
+    sim_agendar(c->fim_us, concluir_canal, (void *)(uintptr_t)(ch | (c->geracao << 8)));
+}
+
+int dma_claim_unused_channel(bool required) {
+    for (uint ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        if (!canais[ch].reservado) {
+            canais[ch].reservado = true;
+            return ch;
+        }
+    }
+    return -1;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    return (dma_channel_config){ .tamanho = DMA_SIZE_32, .incremento_leitura = true, .dreq = DREQ_FORCE, .encadear = channel };
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->tamanho = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->incremento_leitura = incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->incremento_escrita = incr;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->dreq = dreq;
+}
+
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {
+    c->encadear = chain_to;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    canal_dma_t *c = &canais[channel];
+    c->config = *config;
+    c->escrita = write_addr;
+    c->leitura = read_addr;
+    c->quantidade = transfer_count;
+    if (trigger) iniciar_canal(channel);
+}
+
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger) {
+    canais[channel].escrita = write_addr;
+    if (trigger) iniciar_canal(channel);
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {
+    canais[channel].leitura = read_addr;
+    canais[channel].quantidade = transfer_count;
+    iniciar_canal(channel);
+}
+
+void dma_channel_start(uint channel) {
+    iniciar_canal(channel);
+}
+
+bool dma_channel_is_busy(uint channel) {
+    return canais[channel].ocupado;
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel) {
+    while (canais[channel].ocupado && sim_avancar_um(UINT64_MAX)) {
+    }
+}
+
+void dma_channel_set_irq1_enabled(uint channel, bool enabled) {
+    canais[channel].irq1_habilitada = enabled;
+}
+
+bool dma_channel_get_irq1_status(uint channel) {
+    return canais[channel].irq1_pendente;
+}
+
+void dma_channel_acknowledge_irq1(uint channel) {
+    canais[channel].irq1_pendente = false;
+}
+
+// --- PIO: só o que a matriz configura; os bits saem pelo DMA acima ---
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    return 0;
+}
+
+void pio_sm_claim(PIO pio, uint sm) {
+    maquinas_reservadas[pio == pio1] |= 1u << sm;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    for (uint sm = 0; sm < 4; sm++) {
+        if (!(maquinas_reservadas[pio == pio1] & (1u << sm))) {
+            pio_sm_claim(pio, sm);
+            return sm;
+        }
+    }
+    return -1;
+}
+
+void pio_gpio_init(PIO pio, uint pin) {
+}
+
+pio_sm_config pio_get_default_sm_config(void) {
+    return (pio_sm_config){ 0 };
+}
+
+void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) {
+}
+
+void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs) {
+}
+
+void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base) {
+}
+
+void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count) {
+}
+
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {
+}
+
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) {
+}
+
+void sm_config_set_clkdiv(pio_sm_config *c, float div) {
+}
+
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
+    return PICO_OK;
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+}
+
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {
+}
+
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div) {
+}
+
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm) {
+    return true;
+}
+
+// A FIFO não é simulada: o firmware envia os quadros por DMA
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    return (pio == pio0 ? DREQ_PIO0_TX0 : DREQ_PIO1_TX0) + sm;
+}
+
+// --- Estado inicial e final ---
+
+void sim_perifericos_fechar(void) {
+    for (int i = 0; i < NUM_GPIOS; i++) {
+        if (tocando[i]) pwm_set_gpio_level(i, 0);
+    }
+    if (clocks[clk_sys] < SYS_CLK_KHZ * 1000) {
+        sim_contadores.clock_reduzido_us += sim_agora_us() - inicio_clock_reduzido;
+        inicio_clock_reduzido = sim_agora_us();
+    }
+}
+
+void sim_perifericos_init(void) {
+    memset(sim_flash, 0xFF, sizeof(sim_flash));   // Sem parâmetros gravados: valem os padrões
+    for (int i = 0; i < NUM_GPIOS; i++) nivel[i] = true;  // Botões soltos (pull-up)
+    memset(canais, 0, sizeof(canais));
+    memset(maquinas_reservadas, 0, sizeof(maquinas_reservadas));
+    clocks[clk_ref] = 12000000;
+    clocks[clk_sys] = SYS_CLK_KHZ * 1000;
+    clocks[clk_peri] = SYS_CLK_KHZ * 1000;
+    clocks[clk_usb] = USB_CLK_KHZ * 1000;
+    clocks[clk_adc] = USB_CLK_KHZ * 1000;
+    adc_taxa_hz = ADC_CLK_HZ / 96;
+    ruido = 1;
+}
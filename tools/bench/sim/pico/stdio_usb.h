@@ -0,0 +1,8 @@
+#ifndef SIM_PICO_STDIO_USB_H
+#define SIM_PICO_STDIO_USB_H
+
+#include <stdbool.h>
+
+bool stdio_usb_connected(void);  // Sempre false: a placa simulada roda na bateria
+
+#endif // SIM_PICO_STDIO_USB_H
@@ -0,0 +1,100 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ---------- Placa simulada do bench ----------
+ * Relógio virtual: o tempo só anda quando o firmware espera (sleep, WFE,
+ * transação I2C, DMA) e salta direto para o próximo evento agendado
+ * (alarmes e timers, fim de transação, bloco do ADC, borda de botão). O
+ * código do firmware não consome tempo virtual; o custo dele é medido à
+ * parte, em tempo real do computador. */
+
+#define SIM_MAX_EVENTOS 64
+#define SIM_MAX_PRESSOES 512
+
+typedef void (*sim_acao_t)(void *dados);
+
+/* ---------- Estímulo visto pelos sensores num instante ---------- */
+typedef struct {
+    float r, g, b, c;            // Contagens do TCS34725 por ms de integração com ganho 1x
+    float lux;                   // Iluminância no BH1750
+    float fotodiodo;             // Nível médio no ADC (0-4095)
+    float cintilacao;            // Profundidade da modulação (0-1)
+    float cintilacao_hz;
+} sim_estimulo_t;
+
+typedef sim_estimulo_t (*sim_funcao_estimulo_t)(uint64_t t_us);
+
+/* ---------- Contadores dos periféricos ---------- */
+typedef enum { SIM_I2C0 = 0, SIM_I2C1, SIM_I2C_PIO, SIM_NUM_BARRAMENTOS } sim_barramento_t;
+
+typedef struct {
+    uint64_t bytes;              // Nos fios, endereços incluídos
+    uint32_t transacoes;
+    uint32_t nacks;
+    uint32_t fila_cheia;
+    uint64_t ocupado_us;
+} sim_contadores_i2c_t;
+
+typedef struct {
+    sim_contadores_i2c_t i2c[SIM_NUM_BARRAMENTOS];
+    uint32_t blocos_adc;
+    uint32_t quadros_ws2812;
+    uint32_t notas_buzzer;
+    uint64_t buzzer_ligado_us;
+    uint32_t mudancas_clock;
+    uint64_t clock_reduzido_us;  // Tempo com clk_sys abaixo do nominal
+    uint32_t resets_watchdog;    // Prazo do watchdog estourado (a simulação segue)
+    uint32_t lux_repetidos;      // Leituras do BH1750 antes de uma medição nova
+    uint32_t cor_sem_integracao; // Leituras do GY-33 antes da primeira integração
+    uint32_t pressoes;           // Bordas de descida dos botões, com o instante de cada uma
+    uint64_t pressoes_us[SIM_MAX_PRESSOES];
+} sim_contadores_t;
+
+extern sim_contadores_t sim_contadores;
+
+// Prepara a placa: flash apagada, pinos em repouso, relógio em zero. `ao_terminar`
+// é chamada (e não deve retornar) quando o relógio chega a `duracao_us`.
+void sim_init(sim_funcao_estimulo_t estimulo, uint64_t duracao_us, void (*ao_terminar)(void));
+
+uint64_t sim_agora_us(void);
+sim_estimulo_t sim_estimulo(uint64_t t_us);
+
+// Agenda `acao` para o instante `quando_us` (no passado: no próximo avanço)
+void sim_agendar(uint64_t quando_us, sim_acao_t acao, void *dados);
+
+// Executa os eventos até `limite_us` e deixa o relógio nele
+void sim_avancar_ate(uint64_t limite_us);
+
+// Executa só o próximo evento, se vier até `limite_us`; senão vai ao limite.
+// Retorna false se não havia evento algum para esperar.
+bool sim_avancar_um(uint64_t limite_us);
+
+// Chama os handlers registrados para a interrupção, se ela estiver habilitada
+void sim_disparar_irq(unsigned num);
+
+// Pressiona o botão em `quando_us` e solta `duracao_ms` depois (bordas e nível do pino)
+void sim_pressionar_botao(unsigned gpio, uint64_t quando_us, uint32_t duracao_ms);
+
+// Dispositivos no barramento I2C (sim/dispositivos.c); false = NACK
+bool sim_dispositivo_presente(uint8_t endereco);
+void sim_dispositivo_transacao(uint8_t endereco, const uint8_t *escrita, uint16_t tam_escrita,
+                               uint8_t *leitura, uint16_t tam_leitura);
+void sim_dispositivos_init(void);
+
+// Troca o GY-33 da placa por um TCA9548A (0x70) com um TCS34725 em cada canal
+// de `canais`; oscilador[i] é a duração real do ciclo do ADC sobre a nominal
+// (NULL = todos exatos). Vale até o próximo sim_init.
+void sim_dispositivos_mux(uint8_t canais, const float oscilador[8]);
+
+// Leituras de CDATA do sensor no canal que pegaram uma integração ainda não lida
+uint32_t sim_dispositivos_ciclos_entregues(uint8_t canal);
+
+// Início de cada arquivo da simulação
+void sim_perifericos_init(void);
+void sim_perifericos_fechar(void);   // Fecha a nota e o trecho de clock reduzido em curso
+void sim_i2c_init(void);
+
+#endif // SIM_H
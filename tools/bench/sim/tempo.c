@@ -0,0 +1,338 @@
+/* Relógio virtual, alarmes, timers, interrupções, watchdog e stdio da placa simulada */
+
+#include <string.h>
+#include "sim.h"
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "tusb.h"
+#include "hardware/irq.h"
+#include "hardware/watchdog.h"
+
+#define CONSULTAS_POR_US      1000  // Leituras do relógio sem esperar: 1 us de laço de espera ativa
+#define HANDLERS_POR_IRQ      4
+
+typedef enum { EVENTO_ACAO, EVENTO_ALARME, EVENTO_TIMER } tipo_evento_t;
+
+typedef struct {
+    bool ativo;
+    tipo_evento_t tipo;
+    uint64_t quando;
+    uint32_t ordem;              // Desempate entre eventos no mesmo instante
+    alarm_id_t id;
+    sim_acao_t acao;
+    void *dados;
+    alarm_callback_t alarme;
+    repeating_timer_t *timer;
+} evento_t;
+
+sim_contadores_t sim_contadores;
+
+static uint64_t agora;
+static uint64_t duracao;
+static void (*ao_terminar)(void);
+static sim_funcao_estimulo_t funcao_estimulo;
+static evento_t eventos[SIM_MAX_EVENTOS];
+static uint32_t proxima_ordem;
+static alarm_id_t ultimo_id;
+static uint32_t consultas;       // Leituras do relógio desde o último avanço
+static uint8_t profundidade;     // > 0 dentro de um evento (contexto de interrupção)
+
+static irq_handler_t handlers[NUM_IRQS][HANDLERS_POR_IRQ];
+static bool irq_habilitada[NUM_IRQS];
+
+static watchdog_hw_t watchdog_simulado;
+watchdog_hw_t *watchdog_hw = &watchdog_simulado;
+static uint32_t watchdog_prazo_us;
+static uint64_t watchdog_alimentado;
+
+// --- Funções Internas ---
+
+// Move o relógio; o fim do cenário e o prazo do watchdog são conferidos aqui
+static void definir_agora(uint64_t t) {
+    if (t <= agora) return;
+    if (t >= duracao) {
+        agora = duracao;
+        ao_terminar();
+    }
+    agora = t;
+    consultas = 0;
+    if (watchdog_prazo_us && agora - watchdog_alimentado > watchdog_prazo_us) {
+        sim_contadores.resets_watchdog++;
+        watchdog_alimentado = agora;
+    }
+}
+
+static evento_t *novo_evento(uint64_t quando) {
+    for (int i = 0; i < SIM_MAX_EVENTOS; i++) {
+        if (eventos[i].ativo) continue;
+        eventos[i] = (evento_t){ .ativo = true, .quando = quando, .ordem = proxima_ordem++ };
+        return &eventos[i];
+    }
+    return NULL;
+}
+
+static evento_t *proximo_evento(void) {
+    evento_t *proximo = NULL;
+    for (int i = 0; i < SIM_MAX_EVENTOS; i++) {
+        evento_t *e = &eventos[i];
+        if (!e->ativo) continue;
+        if (!proximo || e->quando < proximo->quando ||
+            (e->quando == proximo->quando && e->ordem < proximo->ordem)) {
+            proximo = e;
+        }
+    }
+    return proximo;
+}
+
+static evento_t *buscar_id(alarm_id_t id) {
+    for (int i = 0; i < SIM_MAX_EVENTOS; i++) {
+        if (eventos[i].ativo && eventos[i].id == id) return &eventos[i];
+    }
+    return NULL;
+}
+
+// Libera o evento antes de executá-lo: a ação pode agendar outros (ou a si mesma)
+static void executar(evento_t *e) {
+    evento_t copia = *e;
+    e->ativo = false;
+    definir_agora(copia.quando);
+    profundidade++;
+    switch (copia.tipo) {
+    case EVENTO_ACAO:
+        copia.acao(copia.dados);
+        break;
+    case EVENTO_ALARME: {
+        int64_t repetir = copia.alarme(copia.id, copia.dados);
+        if (repetir != 0) {
+            evento_t *r = novo_evento(repetir < 0 ? copia.quando - repetir : agora + repetir);
+            if (r) {
+                r->tipo = EVENTO_ALARME;
+                r->id = copia.id;
+                r->alarme = copia.alarme;
+                r->dados = copia.dados;
+            }
+        }
+        break;
+    }
+    case EVENTO_TIMER: {
+        repeating_timer_t *rt = copia.timer;
+        if (rt->callback(rt)) {
+            int64_t d = rt->delay_us;
+            evento_t *r = novo_evento(d < 0 ? copia.quando - d : agora + d);
+            if (r) {
+                r->tipo = EVENTO_TIMER;
+                r->id = copia.id;
+                r->timer = rt;
+            }
+        } else {
+            rt->alarm_id = 0;
+        }
+        break;
+    }
+    }
+    profundidade--;
+}
+
+// --- Interface com o bench e os periféricos ---
+
+void sim_init(sim_funcao_estimulo_t estimulo, uint64_t duracao_us, void (*terminar)(void)) {
+    memset(eventos, 0, sizeof(eventos));
+    memset(&sim_contadores, 0, sizeof(sim_contadores));
+    agora = 0;
+    duracao = duracao_us;
+    ao_terminar = terminar;
+    funcao_estimulo = estimulo;
+    sim_perifericos_init();
+    sim_i2c_init();
+    sim_dispositivos_init();
+}
+
+uint64_t sim_agora_us(void) {
+    return agora;
+}
+
+sim_estimulo_t sim_estimulo(uint64_t t_us) {
+    return funcao_estimulo(t_us);
+}
+
+void sim_agendar(uint64_t quando_us, sim_acao_t acao, void *dados) {
+    evento_t *e = novo_evento(quando_us < agora ? agora : quando_us);
+    if (!e) return;
+    e->tipo = EVENTO_ACAO;
+    e->acao = acao;
+    e->dados = dados;
+}
+
+void sim_avancar_ate(uint64_t limite_us) {
+    evento_t *e;
+    while ((e = proximo_evento()) && e->quando <= limite_us) executar(e);
+    definir_agora(limite_us);
+}
+
+bool sim_avancar_um(uint64_t limite_us) {
+    evento_t *e = proximo_evento();
+    if (e && e->quando <= limite_us) {
+        executar(e);
+        return true;
+    }
+    if (limite_us != UINT64_MAX) definir_agora(limite_us);
+    return e != NULL;
+}
+
+void sim_disparar_irq(unsigned num) {
+    if (num >= NUM_IRQS || !irq_habilitada[num]) return;
+    for (int i = 0; i < HANDLERS_POR_IRQ && handlers[num][i]; i++) handlers[num][i]();
+}
+
+// --- Tempo ---
+
+// Um laço que só consulta o relógio (espera ativa) também precisa ver o tempo passar
+static void contar_consulta(void) {
+    if (++consultas >= CONSULTAS_POR_US && profundidade == 0) sim_avancar_ate(agora + 1);
+}
+
+absolute_time_t get_absolute_time(void) {
+    contar_consulta();
+    return agora;
+}
+
+uint64_t time_us_64(void) {
+    contar_consulta();
+    return agora;
+}
+
+uint32_t time_us_32(void) {
+    contar_consulta();
+    return (uint32_t)agora;
+}
+
+void sleep_us(uint64_t us) {
+    sim_avancar_ate(agora + us);
+}
+
+void sleep_ms(uint32_t ms) {
+    sim_avancar_ate(agora + ms * 1000ull);
+}
+
+void sleep_until(absolute_time_t t) {
+    if (t > agora) sim_avancar_ate(t);
+}
+
+void busy_wait_us(uint64_t us) {
+    sim_avancar_ate(agora + us);
+}
+
+void busy_wait_us_32(uint32_t us) {
+    sim_avancar_ate(agora + us);
+}
+
+// Volta depois de um evento (uma interrupção acorda o WFE) ou no prazo
+bool best_effort_wfe_or_timeout(absolute_time_t t) {
+    if (agora >= t) return true;
+    sim_avancar_um(t);
+    return agora >= t;
+}
+
+// --- Alarmes e timers ---
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t cb, void *user_data, bool fire_if_past) {
+    evento_t *e = novo_evento(agora + us);
+    if (!e) return -1;
+    e->tipo = EVENTO_ALARME;
+    e->id = ++ultimo_id;
+    e->alarme = cb;
+    e->dados = user_data;
+    return e->id;
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t cb, void *user_data, bool fire_if_past) {
+    return add_alarm_in_us(ms * 1000ull, cb, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t id) {
+    evento_t *e = buscar_id(id);
+    if (!e) return false;
+    e->ativo = false;
+    return true;
+}
+
+// Período negativo conta de início a início; positivo, do fim do callback (igual aqui: o callback não gasta tempo)
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t cb, void *user_data, repeating_timer_t *out) {
+    evento_t *e = novo_evento(agora + (delay_us < 0 ? -delay_us : delay_us));
+    if (!e) return false;
+    *out = (repeating_timer_t){ .delay_us = delay_us, .user_data = user_data, .alarm_id = ++ultimo_id, .callback = cb };
+    e->tipo = EVENTO_TIMER;
+    e->id = out->alarm_id;
+    e->timer = out;
+    return true;
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t cb, void *user_data, repeating_timer_t *out) {
+    return add_repeating_timer_us(delay_ms * 1000ll, cb, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer) {
+    bool cancelado = timer->alarm_id && cancel_alarm(timer->alarm_id);
+    timer->alarm_id = 0;
+    return cancelado;
+}
+
+// --- Interrupções ---
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    if (num < NUM_IRQS) handlers[num][0] = handler;
+}
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    if (num >= NUM_IRQS) return;
+    for (int i = 0; i < HANDLERS_POR_IRQ; i++) {
+        if (!handlers[num][i]) {
+            handlers[num][i] = handler;
+            return;
+        }
+    }
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    if (num < NUM_IRQS) irq_habilitada[num] = enabled;
+}
+
+void irq_set_priority(uint num, uint8_t priority) {
+}
+
+// --- Watchdog ---
+
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug) {
+    watchdog_prazo_us = delay_ms * 1000;
+    watchdog_alimentado = agora;
+}
+
+void watchdog_update(void) {
+    watchdog_alimentado = agora;
+}
+
+bool watchdog_caused_reboot(void) {
+    return false;
+}
+
+bool watchdog_enable_caused_reboot(void) {
+    return false;
+}
+
+// --- stdio e USB: placa na bateria, sem terminal ---
+
+bool stdio_init_all(void) {
+    return true;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    return PICO_ERROR_TIMEOUT;
+}
+
+bool stdio_usb_connected(void) {
+    return false;
+}
+
+bool tud_mounted(void) {
+    return false;
+}
@@ -0,0 +1,8 @@
+#ifndef SIM_TUSB_H
+#define SIM_TUSB_H
+
+#include <stdbool.h>
+
+bool tud_mounted(void);  // Sempre false: nenhum computador enumera a USB
+
+#endif // SIM_TUSB_H
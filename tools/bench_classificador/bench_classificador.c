@@ -0,0 +1,115 @@
+/* Compara identificar_cor() (uma amostra por chamada) com
+ * identificar_cor_lote() (vetores SoA) sobre as mesmas amostras: primeiro
+ * confere que as decisões são idênticas, depois mede a vazão de cada uma.
+ *
+ * Uso: bench_classificador [amostras] [repeticoes]
+ *
+ * As amostras aleatórias são misturadas com casos de borda (canais zerados,
+ * total zero, razões R/G em cima dos limiares padrão). */
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "classificador_cor.h"
+
+typedef struct {
+    uint16_t *r, *g, *b, *c;
+    uint32_t n;
+} amostras_t;
+
+// --- Funções Internas ---
+
+static double agora_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// xorshift32: a mesma sequência em qualquer máquina
+static uint32_t aleatorio(uint32_t *estado) {
+    uint32_t x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *estado = x;
+}
+
+static void gerar(amostras_t *a) {
+    uint32_t estado = 0x12345678u;
+    for (uint32_t i = 0; i < a->n; i++) {
+        uint32_t sorteio = aleatorio(&estado);
+        uint16_t r = aleatorio(&estado) % 4096, g = aleatorio(&estado) % 4096;
+        uint16_t b = aleatorio(&estado) % 4096, c = aleatorio(&estado) % 8192;
+        switch (sorteio % 16) {
+            case 0: r = g = b = 0; break;                   // Total zero
+            case 1: g = 0; break;                           // R/G = 99
+            case 2: r = g = b = c / 3; break;               // Tons de cinza
+            case 3: g = (uint16_t)(r / 1.15f); break;       // Em cima de rg_vermelho
+            case 4: g = (uint16_t)(r / 0.85f); break;       // Em cima de rg_amarelo
+            case 5: c = aleatorio(&estado) % 100; break;    // Escuro/marrom
+            default: break;
+        }
+        a->r[i] = r; a->g[i] = g; a->b[i] = b; a->c[i] = c;
+    }
+}
+
+// --- Programa ---
+
+int main(int argc, char **argv) {
+    uint32_t n = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : 1000000;
+    int repeticoes = argc > 2 ? atoi(argv[2]) : 20;
+    if (n == 0 || repeticoes < 1) {
+        fprintf(stderr, "uso: bench_classificador [amostras] [repeticoes]\n");
+        return 2;
+    }
+
+    amostras_t a = { malloc(n * sizeof(uint16_t)), malloc(n * sizeof(uint16_t)),
+                     malloc(n * sizeof(uint16_t)), malloc(n * sizeof(uint16_t)), n };
+    const char **nomes = malloc(n * sizeof(*nomes));
+    uint8_t *ids = malloc(n);
+    if (!a.r || !a.g || !a.b || !a.c || !nomes || !ids) {
+        fprintf(stderr, "sem memoria\n");
+        return 2;
+    }
+    gerar(&a);
+    const limiares_cor_t lim = LIMIARES_COR_PADRAO;
+
+    // 1. Mesmas decisões
+    identificar_cor_lote(a.r, a.g, a.b, a.c, ids, n, &lim);
+    uint32_t diferentes = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        const char *escalar = identificar_cor(a.r[i], a.g[i], a.b[i], a.c[i], &lim);
+        if (strcmp(escalar, nome_cor_id(ids[i])) != 0) {
+            if (diferentes++ < 10) {
+                printf("diferente em %u (r=%u g=%u b=%u c=%u): escalar %s, lote %s\n",
+                       i, a.r[i], a.g[i], a.b[i], a.c[i], escalar, nome_cor_id(ids[i]));
+            }
+        }
+    }
+    printf("verificacao: %u de %u amostras diferentes\n", diferentes, n);
+
+    // 2. Vazão (melhor de N repetições)
+    double melhor_escalar = 1e30, melhor_lote = 1e30;
+    for (int rep = 0; rep < repeticoes; rep++) {
+        double t0 = agora_s();
+        for (uint32_t i = 0; i < n; i++) nomes[i] = identificar_cor(a.r[i], a.g[i], a.b[i], a.c[i], &lim);
+        double t1 = agora_s();
+        identificar_cor_lote(a.r, a.g, a.b, a.c, ids, n, &lim);
+        double t2 = agora_s();
+        if (t1 - t0 < melhor_escalar) melhor_escalar = t1 - t0;
+        if (t2 - t1 < melhor_lote) melhor_lote = t2 - t1;
+    }
+    // Usa as saídas para o compilador não descartar o laço escalar
+    uint32_t soma = 0;
+    for (uint32_t i = 0; i < n; i++) soma += (uint32_t)(uintptr_t)nomes[i] + ids[i];
+
+    printf("escalar: %8.2f ns/amostra  %7.1f M amostras/s\n", melhor_escalar * 1e9 / n, n / melhor_escalar * 1e-6);
+    printf("lote:    %8.2f ns/amostra  %7.1f M amostras/s\n", melhor_lote * 1e9 / n, n / melhor_lote * 1e-6);
+    printf("ganho:   %.1fx [%08X]\n", melhor_escalar / melhor_lote, soma);
+
+    free(a.r); free(a.g); free(a.b); free(a.c);
+    free(nomes); free(ids);
+    return diferentes ? 1 : 0;
+}
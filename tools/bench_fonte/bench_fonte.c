@@ -0,0 +1,229 @@
+/* Compara o renderizador de texto do SSD1306 baseado no atlas (fonte_atlas.h)
+ * com o anterior, que desenhava pixel a pixel a partir de font.h: primeiro
+ * confere que cada glifo sai igual no ram_buffer, depois mede glifos/ms de
+ * cada um nas strings que o firmware desenha.
+ *
+ * Uso: bench_fonte [repeticoes]
+ *
+ * A fonte nova é proporcional (sem as colunas vazias das bordas), então a
+ * verificação é glifo a glifo: o glifo novo é desenhado na coluna onde o
+ * antigo acende a primeira coluna, em todas as 8 posições verticais dentro
+ * da página. O código de saída é 1 se algum glifo divergir. */
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306.h"
+#include "font.h"
+
+#define LARGURA 128
+#define ALTURA 64
+#define X_GLIFO 10
+
+// Textos das telas do firmware, só com caracteres que o renderizador antigo conhecia
+static const char *const textos[] = {
+    "--- Luminosidade ---",
+    "Lux: 1234",
+    "Status: OK 20-100",
+    "--- Valores RGB ---",
+    "Cor: Vermelho",
+    "Alimento: Tomate",
+    "R: 4095 G: 2048 B: 512",
+    "- Normalizados % -",
+    "Indice: 0.025 100Hz",
+};
+#define NUM_TEXTOS (sizeof(textos) / sizeof(textos[0]))
+
+// --- Renderizador anterior (ssd1306.c antes do atlas) ---
+
+// O antigo lia os números pequenos de font[568], que desde a inclusão de '%' e '/'
+// cai dentro do glifo '/'; a referência usa o início real deles, que o atlas também usa
+#define INICIO_NUMEROS_PEQUENOS (72 * 8)
+
+static void antigo_draw_small_number(ssd1306_t *ssd, char c, uint8_t x, uint8_t y) {
+    if (c < '0' || c > '9') return;
+    uint16_t index = INICIO_NUMEROS_PEQUENOS + (c - '0') * 5;
+    for (uint8_t i = 0; i < 5; ++i) {
+        uint8_t line = font[index + i];
+        for (uint8_t j = 0; j < 5; ++j) {
+            if ((line >> (4 - j)) & 0x01) {
+                ssd1306_pixel(ssd, x + j, y + i, true);
+            }
+        }
+    }
+}
+
+static void antigo_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y, bool use_small_numbers) {
+    if (use_small_numbers && c >= '0' && c <= '9') {
+        antigo_draw_small_number(ssd, c, x, y);
+        return;
+    }
+
+    uint16_t index = 0;
+    bool rotate = false;
+    if (c >= '0' && c <= '9') {
+        index = (c - '0' + 1) * 8;
+    } else if (c >= 'A' && c <= 'Z') {
+        index = (c - 'A' + 11) * 8;
+    } else if (c >= 'a' && c <= 'z') {
+        index = (c - 'a' + 37) * 8;
+    } else if (c == ':') {
+        index = 64 * 8;
+        rotate = true;
+    } else if (c == '.') {
+        index = 65 * 8;
+        rotate = true;
+    } else if (c == '>') {
+        index = 66 * 8;
+        rotate = true;
+    } else if (c == '-') {
+        index = 67 * 8;
+        rotate = true;
+    } else if (c == 127) {
+        index = 68 * 8; // Símbolo Ohm
+    } else if (c == '!') {
+        index = 69 * 8;
+        rotate = true;
+    } else if (c == '%') {
+        index = 70 * 8;
+        rotate = true;
+    } else if (c == '/') {
+        index = 71 * 8;
+        rotate = true;
+    } else {
+        return; // Caractere não suportado
+    }
+
+    for (uint8_t i = 0; i < 8; ++i) {
+        uint8_t line = font[index + i];
+        for (uint8_t j = 0; j < 8; ++j) {
+            bool pixel_value = (line >> j) & 0x01;
+            ssd1306_pixel(ssd, x + (rotate ? (7 - j) : i), y + (rotate ? i : j), pixel_value);
+        }
+    }
+}
+
+static void antigo_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y, bool use_small_numbers) {
+    while (*str) {
+        char c = *str;
+        uint8_t char_width = (use_small_numbers && c >= '0' && c <= '9') ? 5 : 8;
+        if (x + char_width > ssd->width) {
+            x = 0;
+            y += 8;
+            if (y + 8 > ssd->height) break;
+        }
+        antigo_draw_char(ssd, c, x, y, use_small_numbers);
+        x += char_width;
+        str++;
+    }
+}
+
+// --- Funções Internas ---
+
+// O bench só desenha no buffer; nada vai para o barramento
+i2c_status_t i2c_barramento_transferir(i2c_barramento_t *bar, uint8_t endereco, uint32_t baudrate,
+                                       const uint8_t *escrita, uint16_t tam_escrita,
+                                       uint8_t *leitura, uint16_t tam_leitura) {
+    return I2C_TRANSACAO_OK;
+}
+
+static double agora_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void limpar(ssd1306_t *ssd) {
+    memset(ssd->ram_buffer + 1, 0, ssd->bufsize - 1);
+}
+
+// Primeira coluna acesa a partir de x (ou x, se o glifo for vazio)
+static uint8_t primeira_coluna(const ssd1306_t *ssd, uint8_t x) {
+    for (uint8_t col = x; col < x + 8; col++) {
+        for (uint8_t pagina = 0; pagina < ssd->pages; pagina++) {
+            if (ssd->ram_buffer[pagina * ssd->width + col + 1]) return col;
+        }
+    }
+    return x;
+}
+
+static int comparar_glifo(ssd1306_t *antigo, ssd1306_t *novo, char c, bool pequeno) {
+    int divergencias = 0;
+    for (uint8_t y = 0; y < 8; y++) {
+        limpar(antigo);
+        limpar(novo);
+        if (pequeno) {
+            antigo_draw_small_number(antigo, c, X_GLIFO, y);
+            ssd1306_draw_small_number(novo, c, X_GLIFO, y);
+        } else {
+            antigo_draw_char(antigo, c, X_GLIFO, y, false);
+            ssd1306_draw_char(novo, c, primeira_coluna(antigo, X_GLIFO), y, false);
+        }
+        if (memcmp(antigo->ram_buffer + 1, novo->ram_buffer + 1, antigo->bufsize - 1) != 0) {
+            if (divergencias++ == 0) printf("glifo %s0x%02X ('%c') diferente em y = %u\n",
+                                            pequeno ? "pequeno " : "", (uint8_t)c, c >= 32 && c < 127 ? c : '?', y);
+        }
+    }
+    return divergencias;
+}
+
+// Melhor tempo de N repetições desenhando todos os textos
+static double medir(ssd1306_t *ssd, void (*desenhar)(ssd1306_t *, const char *, uint8_t, uint8_t, bool),
+                    int repeticoes, int rodadas) {
+    double melhor = 1e30;
+    for (int rep = 0; rep < repeticoes; rep++) {
+        double t0 = agora_s();
+        for (int r = 0; r < rodadas; r++) {
+            for (size_t i = 0; i < NUM_TEXTOS; i++) desenhar(ssd, textos[i], 0, (uint8_t)((i % 8) * 8), false);
+        }
+        double t = agora_s() - t0;
+        if (t < melhor) melhor = t;
+    }
+    return melhor;
+}
+
+// --- Programa ---
+
+int main(int argc, char **argv) {
+    int repeticoes = argc > 1 ? atoi(argv[1]) : 20;
+    if (repeticoes < 1) {
+        fprintf(stderr, "uso: bench_fonte [repeticoes]\n");
+        return 2;
+    }
+    ssd1306_t antigo, novo;
+    ssd1306_init(&antigo, LARGURA, ALTURA, false, 0x3C, NULL);
+    ssd1306_init(&novo, LARGURA, ALTURA, false, 0x3C, NULL);
+
+    // 1. Mesmos pixels, glifo a glifo
+    static const char simbolos[] = ":.>-!%/\x7f";
+    int glifos = 0, divergentes = 0;
+    for (int c = 0; c < 128; c++) {
+        bool conhecido = (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+                         (c != 0 && strchr(simbolos, c) != NULL);
+        if (!conhecido) continue;
+        glifos++;
+        divergentes += comparar_glifo(&antigo, &novo, (char)c, false) > 0;
+    }
+    for (char c = '0'; c <= '9'; c++) {
+        glifos++;
+        divergentes += comparar_glifo(&antigo, &novo, c, true) > 0;
+    }
+    printf("verificacao: %d de %d glifos diferentes (8 alturas cada)\n", divergentes, glifos);
+
+    // 2. Vazão nas strings das telas
+    int rodadas = 2000;
+    size_t caracteres = 0;
+    for (size_t i = 0; i < NUM_TEXTOS; i++) caracteres += strlen(textos[i]);
+    double t_antigo = medir(&antigo, antigo_draw_string, repeticoes, rodadas);
+    double t_novo = medir(&novo, ssd1306_draw_string, repeticoes, rodadas);
+    double total = (double)caracteres * rodadas;
+    printf("antigo (pixel a pixel): %8.1f glifos/ms\n", total / (t_antigo * 1e3));
+    printf("atlas (por coluna):     %8.1f glifos/ms\n", total / (t_novo * 1e3));
+    printf("ganho:  %.1fx\n", t_antigo / t_novo);
+
+    free(antigo.ram_buffer);
+    free(novo.ram_buffer);
+    return divergentes ? 1 : 0;
+}
@@ -0,0 +1,97 @@
+/* Vários GY-33 atrás de um TCA9548A, na placa simulada de tools/bench: mede
+ * quantas amostras lib/gy33_grupo.c entrega por período de integração com
+ * N = 1, 2, 4 e 8 sensores, primeiro com os osciladores no valor nominal e
+ * depois com cada sensor um pouco mais rápido ou mais lento.
+ *
+ * Uso: bench_gy33_grupo [segundos]
+ *
+ * Cada amostra entregue precisa corresponder a uma integração que o sensor
+ * simulado ainda não tinha entregado: uma leitura que repete a anterior
+ * (o AVALID continua aceso depois da primeira integração) não pode contar.
+ * O código de saída é 1 se alguma configuração falhar. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim.h"
+#include "gy33_grupo.h"
+
+#define BAUDRATE_BARRAMENTO 400000
+#define PASSO_LACO_US       200     // Intervalo entre chamadas de gy33_grupo_servico no laço simulado
+
+// Duração real de um ciclo do ADC sobre a nominal, por canal
+static const float osciladores_exatos[8] = { 1, 1, 1, 1, 1, 1, 1, 1 };
+static const float osciladores_desviados[8] = { 1.04f, 0.97f, 1.02f, 0.99f, 1.03f, 0.98f, 1.01f, 1.04f };
+
+// --- Funções Internas ---
+
+static sim_estimulo_t estimulo_constante(uint64_t t_us) {
+    return (sim_estimulo_t){ .r = 40, .g = 35, .b = 25, .c = 110, .lux = 60 };
+}
+
+// A duração passada ao sim_init fica além do fim do laço; chegar nela é erro
+static void terminar(void) {
+    fprintf(stderr, "relogio virtual passou do fim previsto\n");
+    exit(2);
+}
+
+static bool medir(uint8_t n, const float osciladores[8], uint64_t duracao_us) {
+    sim_init(estimulo_constante, duracao_us + 10000000ull, terminar);
+    sim_dispositivos_mux((uint8_t)((1u << n) - 1), osciladores);
+
+    i2c_barramento_t bar;
+    gy33_grupo_t grupo;
+    i2c_barramento_init(&bar, i2c0, 0, 1, BAUDRATE_BARRAMENTO);
+    gy33_grupo_init(&grupo, &bar, TCA9548A_ENDERECO, 0);
+    for (uint8_t i = 0; i < n; i++) gy33_grupo_adicionar(&grupo, i, GY33_GANHO_4X);
+    gy33_grupo_iniciar(&grupo);
+
+    uint64_t inicio = sim_agora_us();
+    uint64_t ocupado_inicio = sim_contadores.i2c[SIM_I2C0].ocupado_us;
+    while (sim_agora_us() - inicio < duracao_us) {
+        gy33_grupo_servico(&grupo);
+        sleep_us(PASSO_LACO_US);
+    }
+    // A leitura em andamento também conta do lado do sensor: termina e filtra
+    do {
+        while (grupo.em_leitura >= 0) sleep_us(PASSO_LACO_US);
+        gy33_grupo_servico(&grupo);
+    } while (grupo.em_leitura >= 0);
+
+    bool ok = true;
+    uint32_t repetidas = 0, falhas = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        uint32_t entregues = sim_dispositivos_ciclos_entregues(i);
+        if (grupo.amostras[i] != entregues || grupo.amostras[i] == 0) {
+            printf("\n    sensor %u: %lu amostras para %lu integracoes novas lidas", i,
+                   (unsigned long)grupo.amostras[i], (unsigned long)entregues);
+            ok = false;
+        }
+        repetidas += grupo.repetidas[i];
+        falhas += grupo.falhas[i];
+    }
+
+    double periodos = (double)duracao_us / grupo.periodo_us;
+    double ocupacao = 100.0 * (sim_contadores.i2c[SIM_I2C0].ocupado_us - ocupado_inicio) / duracao_us;
+    printf("%s  N=%u  %5.2f amostras/periodo (%4.2f por sensor)  repetidas %3lu  falhas %lu  barramento %4.1f%%  %s\n",
+           osciladores == osciladores_exatos ? "nominal " : "desviado", n,
+           gy33_grupo_total_amostras(&grupo) / periodos, gy33_grupo_total_amostras(&grupo) / periodos / n,
+           (unsigned long)repetidas, (unsigned long)falhas, ocupacao, ok ? "ok" : "FALHOU");
+    return ok;
+}
+
+// --- Programa ---
+
+int main(int argc, char **argv) {
+    double segundos = argc > 1 ? atof(argv[1]) : 10.0;
+    if (segundos <= 0) {
+        fprintf(stderr, "uso: bench_gy33_grupo [segundos]\n");
+        return 2;
+    }
+    uint64_t duracao_us = (uint64_t)(segundos * 1e6);
+
+    static const uint8_t tamanhos[] = { 1, 2, 4, 8 };
+    int falhas = 0;
+    for (size_t k = 0; k < sizeof(tamanhos); k++) falhas += !medir(tamanhos[k], osciladores_exatos, duracao_us);
+    for (size_t k = 0; k < sizeof(tamanhos); k++) falhas += !medir(tamanhos[k], osciladores_desviados, duracao_us);
+    return falhas ? 1 : 0;
+}
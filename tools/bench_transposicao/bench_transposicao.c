@@ -0,0 +1,203 @@
+/* Custo por quadro de ws2812_paralelo_transpor() em painéis de vários
+ * tamanhos e números de pistas, ao lado da cópia GRB << 8 que a saída de uma
+ * fita só faz e do tempo que o quadro leva no fio. Antes de medir, confere a
+ * saída bit a bit contra o que o programa PIO põe em cada pino.
+ *
+ * A razão contra a cópia é grande (dezenas de vezes: a cópia é vetorizada e
+ * quase não custa nada); o que decide se a transposição atrapalha é a última
+ * coluna, a fração do tempo de fio que ela ocupa.
+ *
+ * Uso: bench_transposicao [repeticoes]
+ *
+ * O código de saída é 1 se algum bit divergir. */
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ws2812_paralelo.h"
+#include "matriz_led.h"
+#include "hardware/dma.h"
+
+#define PIXELS_POR_MEDICAO 2000000  // Pixels transpostos por repetição, em qualquer tamanho de painel
+
+typedef struct {
+    uint16_t largura, altura;
+    uint8_t pistas;
+    bool faixas;                     // false: mapa NULL (pista N recebe um bloco contíguo)
+} configuracao_t;
+
+static const configuracao_t configuracoes[] = {
+    { 16, 16, 1, true },
+    { 16, 16, 4, true },
+    { 16, 16, 4, false },
+    { 16, 16, 8, true },
+    { PAINEL_LARGURA, PAINEL_ALTURA, PAINEL_PISTAS, true },   // O painel padrão do firmware
+    { 32, 32, 8, true },
+    { 64, 32, 8, true },
+    { 64, 64, 8, true },
+    { 30, 10, 3, true },             // Faixas desiguais: a última pista fica mais curta
+};
+#define NUM_CONFIGURACOES (sizeof(configuracoes) / sizeof(configuracoes[0]))
+
+static volatile uint32_t sumidouro;  // Impede que o compilador descarte a cópia medida
+
+// --- SDK: só o que ws2812_paralelo.c referencia fora da transposição; o bench não chama ---
+
+pio_hw_t pio0_hw_, pio1_hw_;
+int pio_claim_unused_sm(PIO pio, bool required) { return 0; }
+uint pio_add_program(PIO pio, const pio_program_t *program) { return 0; }
+void pio_gpio_init(PIO pio, uint pin) {}
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {}
+pio_sm_config pio_get_default_sm_config(void) { return (pio_sm_config){ 0 }; }
+void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) {}
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {}
+void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count) {}
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) {}
+void sm_config_set_clkdiv(pio_sm_config *c, float div) {}
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) { return 0; }
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {}
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div) {}
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) { return 0; }
+uint32_t clock_get_hz(enum clock_index clk) { return 125000000; }
+int dma_claim_unused_channel(bool required) { return 0; }
+dma_channel_config dma_channel_get_default_config(uint channel) { return (dma_channel_config){ 0 }; }
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {}
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {}
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {}
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {}
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {}
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count) {}
+bool dma_channel_is_busy(uint channel) { return false; }
+void dma_channel_wait_for_finish_blocking(uint channel) {}
+
+// --- Funções Internas ---
+
+static double agora_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// xorshift32: a mesma sequência em qualquer máquina
+static uint32_t aleatorio(uint32_t *estado) {
+    uint32_t x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *estado = x;
+}
+
+// Refaz o que o programa PIO põe nos pinos: cada byte da palavra, do mais alto
+// para o mais baixo, é um tempo de bit e o bit N dele vai para a pista N.
+// Retorna quantos bits diferem do GRB esperado em cada pista.
+static int conferir_fio(const ws2812_paralelo_painel_t *painel, const uint32_t *quadro, const uint32_t *planos) {
+    int erros = 0;
+    for (uint16_t pos = 0; pos < painel->pixels_por_pista; pos++) {
+        for (int bit = 0; bit < 24; bit++) {
+            uint32_t palavra = planos[pos * 6 + bit / 4];
+            uint8_t plano = (uint8_t)(palavra >> (24 - 8 * (bit % 4)));
+            for (uint8_t pista = 0; pista < painel->num_pistas; pista++) {
+                uint32_t pixel = painel->mapa ? painel->mapa[pos * painel->num_pistas + pista]
+                                              : (uint32_t)pista * painel->pixels_por_pista + pos;
+                uint32_t esperado = pixel == WS2812_PARALELO_SEM_PIXEL ? 0 : (quadro[pixel] >> (23 - bit)) & 1u;
+                if (((plano >> pista) & 1u) != esperado) erros++;
+            }
+        }
+    }
+    return erros;
+}
+
+// Melhor tempo de N repetições, em µs por quadro
+static double medir_transposicao(const ws2812_paralelo_painel_t *painel, const uint32_t *quadro,
+                                 uint32_t *planos, int repeticoes, int rodadas) {
+    double melhor = 1e30;
+    for (int rep = 0; rep < repeticoes; rep++) {
+        double t0 = agora_s();
+        for (int r = 0; r < rodadas; r++) ws2812_paralelo_transpor(painel, quadro, planos);
+        double t = agora_s() - t0;
+        if (t < melhor) melhor = t;
+    }
+    sumidouro += planos[0];
+    return melhor * 1e6 / rodadas;
+}
+
+// O que tratar_tick faz com o quadro de uma fita só
+static double medir_copia(const uint32_t *quadro, uint32_t *destino, uint32_t pixels, int repeticoes, int rodadas) {
+    double melhor = 1e30;
+    for (int rep = 0; rep < repeticoes; rep++) {
+        double t0 = agora_s();
+        for (int r = 0; r < rodadas; r++) {
+            for (uint32_t i = 0; i < pixels; i++) destino[i] = quadro[i] << 8u;
+            sumidouro += destino[r % pixels];
+        }
+        double t = agora_s() - t0;
+        if (t < melhor) melhor = t;
+    }
+    return melhor * 1e6 / rodadas;
+}
+
+// --- Programa ---
+
+int main(int argc, char **argv) {
+    int repeticoes = argc > 1 ? atoi(argv[1]) : 10;
+    if (repeticoes < 1) {
+        fprintf(stderr, "uso: bench_transposicao [repeticoes]\n");
+        return 2;
+    }
+
+    int erros_total = 0;
+    printf("%-14s %-7s %9s %9s %7s %10s %8s\n", "painel", "mapa", "transp.", "copia", "razao", "fio", "do fio");
+    for (size_t k = 0; k < NUM_CONFIGURACOES; k++) {
+        const configuracao_t *cfg = &configuracoes[k];
+        uint32_t pixels = (uint32_t)cfg->largura * cfg->altura;
+        uint16_t linhas_por_faixa = (cfg->altura + cfg->pistas - 1) / cfg->pistas;
+        uint32_t posicoes = (uint32_t)linhas_por_faixa * cfg->largura * cfg->pistas;
+
+        ws2812_paralelo_painel_t painel;
+        uint16_t *mapa = malloc(posicoes * sizeof(uint16_t));
+        ws2812_paralelo_mapa_faixas(mapa, &painel, cfg->largura, cfg->altura, cfg->pistas);
+        if (!cfg->faixas) painel.mapa = NULL;
+
+        // Sem mapa, a pista N lê o bloco N inteiro, mesmo além do último pixel
+        uint32_t tam_quadro = cfg->faixas ? pixels : (uint32_t)painel.num_pistas * painel.pixels_por_pista;
+        uint32_t *quadro = malloc(tam_quadro * sizeof(uint32_t));
+        uint32_t *planos = malloc(WS2812_PARALELO_PALAVRAS(painel.pixels_por_pista) * sizeof(uint32_t));
+        uint32_t *copia = malloc(pixels * sizeof(uint32_t));
+
+        // 1. Mesmos bits no fio, em quadros aleatórios e nos extremos
+        uint32_t estado = 0x2545F491u + (uint32_t)k;
+        int erros = 0;
+        for (int q = 0; q < 20; q++) {
+            for (uint32_t i = 0; i < tam_quadro; i++) {
+                quadro[i] = q == 0 ? 0 : q == 1 ? 0xFFFFFFu : aleatorio(&estado) & 0xFFFFFFu;
+            }
+            memset(planos, 0xA5, WS2812_PARALELO_PALAVRAS(painel.pixels_por_pista) * sizeof(uint32_t));
+            ws2812_paralelo_transpor(&painel, quadro, planos);
+            erros += conferir_fio(&painel, quadro, planos);
+        }
+        erros_total += erros;
+
+        // 2. Custo por quadro
+        int rodadas = PIXELS_POR_MEDICAO / pixels;
+        if (rodadas < 10) rodadas = 10;
+        double t_transp = medir_transposicao(&painel, quadro, planos, repeticoes, rodadas);
+        double t_copia = medir_copia(quadro, copia, pixels, repeticoes, rodadas);
+        double fio_ms = painel.pixels_por_pista * 24 * 1000.0 / MATRIZ_FREQ_WS2812;
+
+        char nome[24];
+        snprintf(nome, sizeof(nome), "%ux%u/%u", cfg->largura, cfg->altura, cfg->pistas);
+        printf("%-14s %-7s %6.2f us %6.2f us %6.1fx %7.2f ms %7.3f%%", nome, cfg->faixas ? "faixas" : "blocos",
+               t_transp, t_copia, t_transp / t_copia, fio_ms, t_transp / (fio_ms * 10.0));
+        if (erros) printf("  FALHOU: %d bits diferentes", erros);
+        printf("\n");
+
+        free(mapa);
+        free(quadro);
+        free(planos);
+        free(copia);
+    }
+    return erros_total ? 1 : 0;
+}
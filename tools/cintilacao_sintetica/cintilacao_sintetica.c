@@ -0,0 +1,113 @@
+/* Passa formas de onda sintéticas por cintilacao_analisar() e compara com
+ * uma referência em double calculada sobre as amostras brutas.
+ *
+ * Uso: cintilacao_sintetica
+ *
+ * Cada caso imprime o esperado e o obtido; o código de saída é 1 se algum
+ * ficar fora da tolerância (percentual e índice) ou errar a frequência. */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "cintilacao.h"
+
+#define TAXA_HZ 20000                       // A mesma de CAPTURA_ADC_TAXA_HZ
+#define N CINTILACAO_MAX_AMOSTRAS
+#define TOL_PERCENTUAL_X10 5                // 0,5 ponto percentual
+#define TOL_INDICE_X1000 5
+#define PI 3.14159265358979
+
+typedef enum { SENO, RETIFICADA, PWM } forma_t;
+
+typedef struct {
+    const char *nome;
+    forma_t forma;
+    double frequencia_hz;                   // Da forma de onda (a retificada tem o dobro)
+    double media, amplitude;                // Em contagens do ADC
+    double ciclo;                           // PWM: fração ligada
+    double ruido;                           // Pico do ruído uniforme
+    uint16_t frequencia_esperada;           // 0: sem cintilação
+} caso_t;
+
+static const caso_t casos[] = {
+    { "Contínua com ruído",        SENO,       100, 2000,    0, 0,    8,    0 },
+    { "Seno 100 Hz, 25%",          SENO,       100, 2000,  500, 0,    4,  100 },
+    { "Seno 120 Hz, 10%",          SENO,       120, 2000,  200, 0,    4,  120 },
+    { "Seno 60 Hz, 5%, fraco",     SENO,        60,  400,   20, 0,    2,   60 },
+    { "Retificada 50 Hz (LED AC)", RETIFICADA,  50, 1000, 2000, 0,    4,  100 },
+    { "Retificada 60 Hz",          RETIFICADA,  60,  500, 3000, 0,    4,  120 },
+    { "PWM 1 kHz, 30%",            PWM,       1000,    0, 3000, 0.30, 4, 1000 },
+    { "PWM 500 Hz, 80%",           PWM,        500,  500, 3000, 0.80, 4,  500 },
+    { "PWM 200 Hz, 50%",           PWM,        200,    0, 4000, 0.50, 0,  200 },
+};
+
+// --- Funções Internas ---
+
+static uint32_t estado_ruido = 0x9E3779B9u;
+
+static double ruido(double pico) {
+    estado_ruido ^= estado_ruido << 13;
+    estado_ruido ^= estado_ruido >> 17;
+    estado_ruido ^= estado_ruido << 5;
+    return pico * ((estado_ruido / 4294967295.0) * 2 - 1);
+}
+
+static void gerar(const caso_t *c, uint16_t *amostras) {
+    for (int i = 0; i < N; i++) {
+        double t = (double)i / TAXA_HZ, v;
+        double fase = fmod(t * c->frequencia_hz, 1.0);
+        switch (c->forma) {
+            case SENO:       v = c->media + c->amplitude * sin(2 * PI * fase); break;
+            case RETIFICADA: v = c->media + c->amplitude * fabs(sin(2 * PI * fase)); break;
+            default:         v = c->media + (fase < c->ciclo ? c->amplitude : 0); break;
+        }
+        v += ruido(c->ruido);
+        amostras[i] = (uint16_t)(v < 0 ? 0 : v > 4095 ? 4095 : lround(v));
+    }
+}
+
+// Definições da IES sobre as amostras sem decimação
+static void referencia(const uint16_t *a, double *percentual, double *indice) {
+    double soma = 0, minimo = 4095, maximo = 0, acima = 0;
+    for (int i = 0; i < N; i++) {
+        soma += a[i];
+        if (a[i] < minimo) minimo = a[i];
+        if (a[i] > maximo) maximo = a[i];
+    }
+    double media = soma / N;
+    for (int i = 0; i < N; i++) {
+        if (a[i] > media) acima += a[i] - media;
+    }
+    *percentual = maximo + minimo > 0 ? 100.0 * (maximo - minimo) / (maximo + minimo) : 0;
+    *indice = soma > 0 ? acima / soma : 0;
+}
+
+// --- Programa ---
+
+int main(void) {
+    static uint16_t amostras[N];
+    int falhas = 0;
+    printf("%-27s %17s %17s %11s\n", "caso", "percentual", "indice", "frequencia");
+    printf("%-27s %17s %17s %11s\n", "", "esperado/obtido", "esperado/obtido", "esp./obt.");
+    for (size_t k = 0; k < sizeof(casos) / sizeof(casos[0]); k++) {
+        const caso_t *c = &casos[k];
+        gerar(c, amostras);
+        double percentual, indice;
+        referencia(amostras, &percentual, &indice);
+        cintilacao_resultado_t r;
+        cintilacao_analisar(amostras, N, TAXA_HZ, &r);
+
+        // Sem cintilação real o percentual é só ruído: confere apenas a ausência de frequência
+        int ok = r.frequencia_hz == c->frequencia_esperada;
+        if (c->frequencia_esperada != 0) {
+            ok &= abs((int)r.percentual_x10 - (int)lround(percentual * 10)) <= TOL_PERCENTUAL_X10;
+            ok &= abs((int)r.indice_x1000 - (int)lround(indice * 1000)) <= TOL_INDICE_X1000;
+        }
+        falhas += !ok;
+        printf("%-27s %7.1f%% /%5.1f%% %7.3f / %5.3f %5u / %4u %s\n", c->nome,
+               percentual, r.percentual_x10 / 10.0, indice, r.indice_x1000 / 1000.0,
+               c->frequencia_esperada, r.frequencia_hz, ok ? "ok" : "FALHOU");
+    }
+    printf("%d falha(s)\n", falhas);
+    return falhas ? 1 : 0;
+}
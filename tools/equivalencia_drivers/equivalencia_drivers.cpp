@@ -0,0 +1,412 @@
+/* Confere que os modelos C++17 de lib/Drivers_Cpp fazem o mesmo que os
+ * drivers em C que eles substituem, sem placa: as duas versões falam com um
+ * barramento falso que grava cada transação (endereço, velocidade, bytes
+ * escritos e quantos bytes lê) e responde às leituras com bytes sorteados
+ * a partir de uma semente, a mesma para os dois lados.
+ *
+ * Uso: equivalencia_drivers [sorteios]
+ *
+ * Compara o tráfego I2C de cada operação, o buffer e as colunas alteradas do
+ * SSD1306 depois de cada desenho sorteado, as leituras convertidas dos
+ * sensores e o mapa de LEDs da matriz. O código de saída é 1 se algo divergir. */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// O SDK simulado é C puro; os drivers em C e os modelos precisam das mesmas declarações
+extern "C" {
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+#include "matriz_compositor.h"
+}
+#include "i2c_barramento.h"
+#include "ssd1306.h"
+#include "gy33.h"
+#include "bh1750_light_sensor.h"
+#include "matriz_led.h"
+#include "ssd1306.hpp"
+#include "gy33.hpp"
+#include "bh1750.hpp"
+#include "matriz_ws2812.hpp"
+
+#define SSD1306_I2C_ADDR 0x3C   // O mesmo de main.c
+#define SORTEIOS_PADRAO  2000
+
+// --- Barramento falso ---
+
+struct TransacaoGravada {
+    uint8_t endereco;
+    uint32_t baudrate;
+    std::vector<uint8_t> escrita;
+    uint16_t tam_leitura;
+
+    bool operator==(const TransacaoGravada &outra) const {
+        return endereco == outra.endereco && baudrate == outra.baudrate && escrita == outra.escrita &&
+               tam_leitura == outra.tam_leitura;
+    }
+};
+
+static std::vector<TransacaoGravada> gravadas;
+static uint32_t estado_leitura;           // Semente dos bytes lidos
+static const uint8_t *resposta_fixa;      // Quando não é NULL, as leituras copiam daqui
+static int nack_na_transacao = -1;        // Índice em `gravadas` que recebe NACK
+
+// xorshift32: a mesma sequência em qualquer máquina
+static uint32_t aleatorio(uint32_t *estado) {
+    uint32_t x = *estado;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *estado = x;
+}
+
+static i2c_status_t executar(uint8_t endereco, uint32_t baudrate, const uint8_t *escrita, uint16_t tam_escrita,
+                             uint8_t *leitura, uint16_t tam_leitura) {
+    TransacaoGravada t{ endereco, baudrate, std::vector<uint8_t>(escrita, escrita + tam_escrita), tam_leitura };
+    bool nack = (int)gravadas.size() == nack_na_transacao;
+    gravadas.push_back(std::move(t));
+    if (nack) return I2C_TRANSACAO_NACK;
+    for (uint16_t i = 0; i < tam_leitura; i++) {
+        leitura[i] = resposta_fixa ? resposta_fixa[i] : (uint8_t)aleatorio(&estado_leitura);
+    }
+    return I2C_TRANSACAO_OK;
+}
+
+extern "C" {
+
+// A fila de lib/i2c_barramento.c tem teste próprio; aqui cada transação termina na hora
+i2c_status_t i2c_barramento_transferir(i2c_barramento_t *bar, uint8_t endereco, uint32_t baudrate,
+                                       const uint8_t *escrita, uint16_t tam_escrita,
+                                       uint8_t *leitura, uint16_t tam_leitura) {
+    return executar(endereco, baudrate, escrita, tam_escrita, leitura, tam_leitura);
+}
+
+bool i2c_barramento_enfileirar(i2c_barramento_t *bar, i2c_transacao_t *transacao) {
+    transacao->status = executar(transacao->endereco, transacao->baudrate, transacao->escrita,
+                                 transacao->tam_escrita, transacao->leitura, transacao->tam_leitura);
+    if (transacao->callback) transacao->callback(transacao);
+    return true;
+}
+
+i2c_status_t i2c_barramento_aguardar(const i2c_transacao_t *transacao) {
+    return transacao->status;
+}
+
+// --- SDK e compositor: só o que matriz_led.c referencia fora do mapa; o teste não chama ---
+
+pio_hw_t pio0_hw_, pio1_hw_;
+void sleep_us(uint64_t us) {}
+void sleep_ms(uint32_t ms) {}
+absolute_time_t get_absolute_time(void) { return 0; }
+uint pio_add_program(PIO pio, const pio_program_t *program) { return 0; }
+void pio_sm_claim(PIO pio, uint sm) {}
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div) {}
+void pio_gpio_init(PIO pio, uint pin) {}
+void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out) {}
+pio_sm_config pio_get_default_sm_config(void) { return pio_sm_config{}; }
+void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) {}
+void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs) {}
+void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base) {}
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {}
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) {}
+void sm_config_set_clkdiv(pio_sm_config *c, float div) {}
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) { return 0; }
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {}
+uint32_t clock_get_hz(enum clock_index clk) { return 125000000; }
+void compositor_init(uint fps) {}
+void compositor_definir_base(uint32_t cor) {}
+void compositor_definir_padrao(glifo5x5_t pad, uint32_t cor) {}
+void compositor_definir_digito(int numero, uint32_t cor) {}
+void compositor_definir_chuva(bool ativa, uint32_t cor) {}
+void compositor_limpar(void) {}
+
+}
+
+// --- Os dois lados ---
+
+i2c_barramento_t barramento;
+
+using Display = drivers::Ssd1306<drivers::DispositivoI2C<barramento, SSD1306_I2C_ADDR, 400000>, 128, 64>;
+using SensorCor = drivers::Gy33<drivers::DispositivoI2C<barramento, GY33_I2C_ADDR, GY33_I2C_BAUDRATE>>;
+using SensorLuz = drivers::Bh1750<drivers::DispositivoI2C<barramento, drivers::BH1750_ENDERECO,
+                                                          drivers::BH1750_BAUDRATE>>;
+using Matriz = drivers::MatrizWs2812<0, MATRIZ_SM, PINO_WS2812, NUM_LINHAS, NUM_COLUNAS,
+                                     MATRIZ_DE_CABECA_PARA_BAIXO, MATRIZ_SERPENTINA>;
+
+static ssd1306_t display_c;
+static Display display_cpp;
+static uint32_t sorteios = SORTEIOS_PADRAO;
+static int falhas_caso;
+
+#define CHECAR(cond) do { \
+        if (!(cond)) { \
+            printf("\n    linha %d: %s", __LINE__, #cond); \
+            falhas_caso++; \
+        } \
+    } while (0)
+
+// --- Funções Internas ---
+
+// Mostra a transação a partir do byte `inicio` da escrita
+static void imprimir_transacao(const char *lado, size_t i, size_t inicio, const std::vector<TransacaoGravada> &lista) {
+    if (i >= lista.size()) {
+        printf("\n      %-4s #%zu: (nenhuma)", lado, i);
+        return;
+    }
+    const TransacaoGravada &t = lista[i];
+    printf("\n      %-4s #%zu: 0x%02X %lu Hz, le %u, %zu bytes escritos, a partir do %zu:", lado, i, t.endereco,
+           (unsigned long)t.baudrate, t.tam_leitura, t.escrita.size(), inicio);
+    for (size_t k = inicio; k < t.escrita.size() && k < inicio + 12; k++) printf(" %02X", t.escrita[k]);
+}
+
+// Roda a operação nos dois lados com a mesma semente e compara o tráfego
+template <typename OperacaoC, typename OperacaoCpp>
+static bool mesmo_trafego(const char *operacao, uint32_t semente, OperacaoC &&lado_c, OperacaoCpp &&lado_cpp) {
+    gravadas.clear();
+    estado_leitura = semente;
+    lado_c();
+    std::vector<TransacaoGravada> trafego_c = std::move(gravadas);
+
+    gravadas.clear();
+    estado_leitura = semente;
+    lado_cpp();
+    if (trafego_c == gravadas && !trafego_c.empty()) return true;
+
+    printf("\n    %s: trafego diferente", operacao);
+    size_t i = 0;
+    while (i < trafego_c.size() && i < gravadas.size() && trafego_c[i] == gravadas[i]) i++;
+    size_t inicio = 0;
+    if (i < trafego_c.size() && i < gravadas.size()) {
+        const std::vector<uint8_t> &a = trafego_c[i].escrita, &b = gravadas[i].escrita;
+        while (inicio < a.size() && inicio < b.size() && a[inicio] == b[inicio]) inicio++;
+    }
+    imprimir_transacao("C", i, inicio, trafego_c);
+    imprimir_transacao("C++", i, inicio, gravadas);
+    falhas_caso++;
+    return false;
+}
+
+// Buffer e colunas alteradas iguais (consome as alterações dos dois lados)
+static bool displays_iguais() {
+    bool iguais = memcmp(display_c.ram_buffer + 1, display_cpp.quadro(), Display::tamanho_quadro) == 0;
+    for (uint8_t pagina = 0; pagina < Display::paginas; pagina++) {
+        uint8_t ini_c = 0, fim_c = 0, ini_cpp = 0, fim_cpp = 0;
+        bool alterada_c = ssd1306_take_dirty(&display_c, pagina, &ini_c, &fim_c);
+        bool alterada_cpp = display_cpp.pegar_alteracoes(pagina, ini_cpp, fim_cpp);
+        if (alterada_c != alterada_cpp || ini_c != ini_cpp || fim_c != fim_cpp) iguais = false;
+    }
+    return iguais;
+}
+
+// String UTF-8 sorteada: ASCII, Latin-1 em dois bytes, fora do Latin-1 e bytes soltos
+static void sortear_texto(uint32_t *estado, char *texto, size_t tamanho) {
+    size_t n = 0;
+    size_t caracteres = 1 + aleatorio(estado) % 24;
+    for (size_t i = 0; i < caracteres && n + 4 < tamanho; i++) {
+        uint32_t tipo = aleatorio(estado) % 20;
+        if (tipo < 12) {
+            texto[n++] = (char)(0x20 + aleatorio(estado) % 95);
+        } else if (tipo < 17) {
+            uint8_t c = (uint8_t)(0xA0 + aleatorio(estado) % 96);
+            texto[n++] = (char)(0xC0 | (c >> 6));
+            texto[n++] = (char)(0x80 | (c & 0x3F));
+        } else if (tipo < 19) {
+            texto[n++] = (char)0xE2;       // "€": três bytes, fora do Latin-1
+            texto[n++] = (char)0x82;
+            texto[n++] = (char)0xAC;
+        } else {
+            texto[n++] = (char)(0x80 + aleatorio(estado) % 64);
+        }
+    }
+    texto[n] = '\0';
+}
+
+// --- Casos ---
+
+static void caso_ssd1306_init() {
+    mesmo_trafego("init", 1, [] { ssd1306_config(&display_c); }, [] { display_cpp.init(); });
+}
+
+static void caso_ssd1306_desenhos() {
+    uint32_t estado = 0x6D2B79F5u;
+    uint32_t divergencias = 0, primeira = 0;
+    char texto[80];
+    for (uint32_t s = 0; s < sorteios; s++) {
+        bool valor = aleatorio(&estado) & 1;
+        uint8_t x = (uint8_t)(aleatorio(&estado) % 140), y = (uint8_t)(aleatorio(&estado) % 72);
+        bool pequenos = aleatorio(&estado) % 4 == 0;
+        switch (aleatorio(&estado) % 100) {
+        case 0:
+            ssd1306_fill(&display_c, valor);
+            display_cpp.preencher(valor);
+            break;
+        case 1 ... 30:
+            ssd1306_pixel(&display_c, x, y, valor);
+            display_cpp.pixel(x, y, valor);
+            break;
+        case 31 ... 45: {
+            uint8_t x1 = (uint8_t)(x + aleatorio(&estado) % 40);
+            ssd1306_hline(&display_c, x, x1, y, valor);
+            display_cpp.linha_h(x, x1, y, valor);
+            break;
+        }
+        case 46 ... 60: {
+            uint8_t y1 = (uint8_t)(y + aleatorio(&estado) % 30);
+            ssd1306_vline(&display_c, x, y, y1, valor);
+            display_cpp.linha_v(x, y, y1, valor);
+            break;
+        }
+        case 61 ... 80: {
+            char c = (char)aleatorio(&estado);
+            uint8_t largura_c = ssd1306_draw_char(&display_c, c, x, y, pequenos);
+            uint8_t largura_cpp = display_cpp.desenhar_caractere(c, x, y, pequenos);
+            if (largura_c != largura_cpp) divergencias += divergencias == 0 ? (primeira = s, 1) : 1;
+            break;
+        }
+        default:
+            sortear_texto(&estado, texto, sizeof(texto));
+            ssd1306_draw_string(&display_c, texto, x, y, pequenos);
+            display_cpp.desenhar_texto(texto, x, y, pequenos);
+            break;
+        }
+        if (!displays_iguais() && divergencias++ == 0) primeira = s;
+
+        // De tempos em tempos, o envio de uma região sorteada e do quadro inteiro
+        if (s % 100 == 99) {
+            uint8_t p0 = (uint8_t)(aleatorio(&estado) % 8), p1 = (uint8_t)(p0 + aleatorio(&estado) % (8 - p0));
+            uint8_t c0 = (uint8_t)(aleatorio(&estado) % 128), c1 = (uint8_t)(c0 + aleatorio(&estado) % (128 - c0));
+            mesmo_trafego("regiao", s, [&] { ssd1306_send_region(&display_c, p0, p1, c0, c1); },
+                          [&] { display_cpp.enviar_regiao(p0, p1, c0, c1); });
+            mesmo_trafego("quadro", s, [] { ssd1306_send_data(&display_c); }, [] { display_cpp.enviar(); });
+        }
+    }
+    if (divergencias) printf("\n    %lu de %lu sorteios divergiram (o primeiro foi o %lu)", (unsigned long)divergencias,
+                             (unsigned long)sorteios, (unsigned long)primeira);
+    CHECAR(divergencias == 0);
+}
+
+static void caso_gy33() {
+    mesmo_trafego("init", 1, [] { gy33_init(&barramento); }, [] { SensorCor::init(); });
+    mesmo_trafego("desligar", 1, [] { gy33_power_down(&barramento); }, [] { SensorCor::desligar(); });
+    mesmo_trafego("ligar", 1, [] { gy33_power_up(&barramento); }, [] { SensorCor::ligar(); });
+
+    uint16_t cor_c[4], cor_cpp[4];
+    bool ok_c = false, ok_cpp = false;
+    uint32_t diferentes = 0;
+    for (uint32_t s = 1; s <= sorteios; s++) {
+        mesmo_trafego("leitura", s, [&] { ok_c = gy33_read_color(&barramento, &cor_c[0], &cor_c[1], &cor_c[2], &cor_c[3]); },
+                      [&] { ok_cpp = SensorCor::ler(cor_cpp[0], cor_cpp[1], cor_cpp[2], cor_cpp[3]); });
+        if (!ok_c || !ok_cpp || memcmp(cor_c, cor_cpp, sizeof(cor_c)) != 0) diferentes++;
+    }
+    CHECAR(diferentes == 0);
+
+    // NACK: as duas falham e zeram as componentes
+    nack_na_transacao = 0;
+    mesmo_trafego("leitura com NACK", 1,
+                  [&] { ok_c = gy33_read_color(&barramento, &cor_c[0], &cor_c[1], &cor_c[2], &cor_c[3]); },
+                  [&] { ok_cpp = SensorCor::ler(cor_cpp[0], cor_cpp[1], cor_cpp[2], cor_cpp[3]); });
+    nack_na_transacao = -1;
+    CHECAR(!ok_c && !ok_cpp);
+    CHECAR(cor_c[0] == 0 && cor_c[3] == 0 && cor_cpp[0] == 0 && cor_cpp[3] == 0);
+}
+
+static void caso_bh1750() {
+    mesmo_trafego("ligar", 1, [] { bh1750_power_on(&barramento); }, [] { SensorLuz::ligar(); });
+    mesmo_trafego("desligar", 1, [] { bh1750_power_down(&barramento); }, [] { SensorLuz::desligar(); });
+    mesmo_trafego("medicao", 1, [] { bh1750_start_measurement(&barramento); }, [] { SensorLuz::iniciar_medicao(); });
+
+    // Todas as contagens possíveis: a divisão em double do C e a inteira do modelo
+    uint16_t lux_c = 0, lux_cpp = 0;
+    uint32_t diferentes = 0, primeira = 0;
+    for (uint32_t contagem = 0; contagem <= UINT16_MAX; contagem++) {
+        const uint8_t bytes[2] = { (uint8_t)(contagem >> 8), (uint8_t)contagem };
+        resposta_fixa = bytes;
+        bool trafego = mesmo_trafego("leitura", contagem, [&] { lux_c = bh1750_read_result(&barramento); },
+                                     [&] { lux_cpp = SensorLuz::ler_resultado(); });
+        if ((!trafego || lux_c != lux_cpp) && diferentes++ == 0) primeira = contagem;
+        if (!trafego) break;
+    }
+    resposta_fixa = NULL;
+    if (diferentes) printf("\n    %lu contagens convertem diferente (a primeira foi %lu)", (unsigned long)diferentes,
+                           (unsigned long)primeira);
+    CHECAR(diferentes == 0);
+
+    nack_na_transacao = 0;
+    mesmo_trafego("leitura com NACK", 1, [&] { lux_c = bh1750_read_result(&barramento); },
+                  [&] { lux_cpp = SensorLuz::ler_resultado(); });
+    nack_na_transacao = -1;
+    CHECAR(lux_c == 0 && lux_cpp == 0);
+}
+
+static void caso_matriz_mapa() {
+    for (uint8_t lin = 0; lin < NUM_LINHAS; lin++) {
+        for (uint8_t col = 0; col < NUM_COLUNAS; col++) {
+            CHECAR(Matriz::indice_fisico(lin, col) == MATRIZ_INDICE_FISICO(lin, col));
+        }
+    }
+    CHECAR(memcmp(Matriz::mapa_bits.data(), MATRIZ_MAPA_BITS, NUM_PIXELS) == 0);
+}
+
+// O modelo guarda as palavras já deslocadas para a FIFO (GRB << 8)
+static void caso_matriz_glifos() {
+    static uint32_t quadro_c[NUM_PIXELS];
+    Matriz matriz_cpp;
+    uint32_t estado = 0x9E3779B9u, diferentes = 0;
+    const glifo5x5_t fixos[] = { PAD_OK, PAD_EXC, PAD_X };
+    for (uint32_t s = 0; s < sorteios; s++) {
+        uint32_t cor = aleatorio(&estado) & 0xFFFFFFu;
+        if (s % 50 == 0) {
+            for (uint32_t &pixel : quadro_c) pixel = cor;
+            matriz_cpp.preencher(cor);
+        } else {
+            glifo5x5_t glifo = s < 10 ? padrao_numeros[s] : s < 13 ? fixos[s - 10] : aleatorio(&estado) & 0x1FFFFFFu;
+            matriz_pintar_glifo(quadro_c, glifo, cor);
+            matriz_cpp.pintar_glifo(glifo, cor);
+        }
+        for (int i = 0; i < NUM_PIXELS; i++) {
+            if (quadro_c[i] << 8u != matriz_cpp.quadro()[i]) {
+                diferentes++;
+                break;
+            }
+        }
+    }
+    CHECAR(diferentes == 0);
+}
+
+static const struct {
+    const char *nome;
+    void (*executar)();
+} casos[] = {
+    { "SSD1306: inicializacao",      caso_ssd1306_init },
+    { "SSD1306: desenhos sorteados", caso_ssd1306_desenhos },
+    { "GY-33",                       caso_gy33 },
+    { "BH1750",                      caso_bh1750 },
+    { "Matriz: mapa do fio",         caso_matriz_mapa },
+    { "Matriz: glifos sorteados",    caso_matriz_glifos },
+};
+
+// --- Programa ---
+
+int main(int argc, char **argv) {
+    long n = argc > 1 ? atol(argv[1]) : SORTEIOS_PADRAO;
+    if (n < 1) {
+        fprintf(stderr, "uso: equivalencia_drivers [sorteios]\n");
+        return 2;
+    }
+    sorteios = (uint32_t)n;
+    ssd1306_init(&display_c, 128, 64, false, SSD1306_I2C_ADDR, &barramento);
+
+    int falhas = 0;
+    for (size_t i = 0; i < sizeof(casos) / sizeof(casos[0]); i++) {
+        falhas_caso = 0;
+        printf("%-30s", casos[i].nome);
+        casos[i].executar();
+        printf(falhas_caso ? "\n    FALHOU\n" : "ok\n");
+        falhas += falhas_caso;
+    }
+    free(display_c.ram_buffer);
+    return falhas ? 1 : 0;
+}
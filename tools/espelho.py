@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""Visualizador do espelho do display e da matriz (lib/espelho.c).
+
+Lê as linhas "@espelho", "@d" e "@m" do log da placa, reconstrói o buffer
+do SSD1306 e o último quadro da matriz e os desenha no terminal (cores ANSI
+de 24 bits). As demais linhas do log aparecem embaixo.
+
+Uso:
+  python3 tools/espelho.py --porta /dev/ttyACM0     # liga o espelho e acompanha (requer pyserial)
+  python3 tools/espelho.py log.txt --pbm tela.pbm   # reconstrói a partir de um log gravado
+"""
+
+import argparse
+import sys
+import time
+
+LINHAS_DE_LOG = 6
+INTERVALO_DESENHO_S = 0.05
+
+
+def packbits_decodificar(dados):
+    saida = bytearray()
+    i = 0
+    while i < len(dados):
+        h = dados[i]
+        i += 1
+        if h < 128:                      # h + 1 bytes literais
+            saida += dados[i:i + h + 1]
+            i += h + 1
+        elif h != 128:                   # 257 - h cópias do próximo byte
+            saida += bytes([dados[i]]) * (257 - h)
+            i += 1
+    return bytes(saida)
+
+
+class Espelho:
+    def __init__(self):
+        self.largura, self.altura = 128, 64
+        self.linhas_matriz, self.colunas_matriz = 5, 5
+        self.gddram = bytearray(self.largura * self.altura // 8)
+        self.matriz = [0] * 25
+        self.log = []
+        self.sincronizado = False        # Só depois do cabeçalho o buffer é confiável
+        self.alterado = True
+        self.trechos = self.bytes_alterados = self.bytes_recebidos = self.quadros_matriz = 0
+
+    def processar(self, linha):
+        campos = linha.split()
+        if not campos:
+            return
+        if campos[0] == "@espelho":
+            self.largura, self.altura = int(campos[2]), int(campos[3])
+            self.linhas_matriz, self.colunas_matriz = int(campos[4]), int(campos[5])
+            self.gddram = bytearray(self.largura * self.altura // 8)
+            self.matriz = [0] * (self.linhas_matriz * self.colunas_matriz)
+            self.sincronizado = True
+        elif campos[0] == "@d" and len(campos) == 5:
+            pagina, coluna, n = int(campos[1]), int(campos[2]), int(campos[3])
+            comprimido = bytes.fromhex(campos[4])
+            dados = packbits_decodificar(comprimido)
+            if len(dados) != n:
+                self.log.append(f"(trecho corrompido: {len(dados)} bytes, esperados {n})")
+                return
+            inicio = pagina * self.largura + coluna
+            self.gddram[inicio:inicio + n] = dados
+            self.trechos += 1
+            self.bytes_alterados += n
+            self.bytes_recebidos += len(comprimido)
+        elif campos[0] == "@m":
+            self.matriz = [int(c, 16) for c in campos[1:]]
+            self.quadros_matriz += 1
+        elif not campos[0].startswith("@"):
+            self.log = (self.log + [linha])[-LINHAS_DE_LOG:]
+        else:
+            return
+        self.alterado = True
+
+    def pixel(self, x, y):
+        return (self.gddram[(y // 8) * self.largura + x] >> (y % 8)) & 1
+
+    def desenhar(self):
+        saida = ["\x1b[H"]
+        # Duas linhas de pixels por caractere: meia-célula de cima e de baixo
+        for y in range(0, self.altura, 2):
+            fila = []
+            for x in range(self.largura):
+                cima, baixo = self.pixel(x, y), self.pixel(x, y + 1)
+                fila.append(" ▀▄█"[cima | (baixo << 1)])
+            lin = y // 2                 # Matriz ao lado do display, um LED por caractere duplo
+            if lin < self.linhas_matriz:
+                fila.append("   ")
+                for col in range(self.colunas_matriz):
+                    grb = self.matriz[lin * self.colunas_matriz + col]
+                    g, r, b = (grb >> 16) & 0xFF, (grb >> 8) & 0xFF, grb & 0xFF
+                    fila.append(f"\x1b[38;2;{r};{g};{b}m██\x1b[0m")
+            saida.append("".join(fila) + "\x1b[K\n")
+        estado = "" if self.sincronizado else " (aguardando @espelho: buffer parcial)"
+        saida.append(f"trechos {self.trechos}, {self.bytes_alterados} bytes alterados, "
+                     f"{self.bytes_recebidos} comprimidos, {self.quadros_matriz} quadros da matriz{estado}\x1b[K\n")
+        for linha in self.log:
+            saida.append(linha[:self.largura + 20] + "\x1b[K\n")
+        saida.append("\x1b[J")
+        sys.stdout.write("".join(saida))
+        sys.stdout.flush()
+        self.alterado = False
+
+    def salvar_pbm(self, caminho):
+        with open(caminho, "w") as f:
+            f.write(f"P1\n{self.largura} {self.altura}\n")
+            for y in range(self.altura):
+                f.write(" ".join(str(self.pixel(x, y)) for x in range(self.largura)) + "\n")
+
+
+def linhas_da_porta(porta):
+    import serial  # pyserial
+    with serial.Serial(porta, 115200, timeout=0.05) as s:
+        s.write(b"espelho on\n")
+        pendente = b""
+        try:
+            while True:
+                pendente += s.read(4096)
+                *completas, pendente = pendente.split(b"\n")
+                for linha in completas:
+                    yield linha.decode("latin-1").rstrip("\r")
+                if not completas:
+                    yield None           # Sem dados: dá a chance de redesenhar
+        finally:
+            s.write(b"espelho off\n")
+
+
+def linhas_do_arquivo(caminho):
+    with open(caminho, encoding="latin-1") if caminho != "-" else sys.stdin as f:
+        for linha in f:
+            yield linha.rstrip("\r\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("log", nargs="?", default="-", help="log gravado (padrão: entrada padrão)")
+    ap.add_argument("--porta", help="porta serial da placa (ex.: /dev/ttyACM0)")
+    ap.add_argument("--pbm", help="ao terminar, grava o display reconstruído neste arquivo PBM")
+    ap.add_argument("--sem-tela", action="store_true", help="não desenha no terminal (só --pbm e estatísticas)")
+    args = ap.parse_args()
+
+    espelho = Espelho()
+    fonte = linhas_da_porta(args.porta) if args.porta else linhas_do_arquivo(args.log)
+    ultimo_desenho = 0.0
+    if not args.sem_tela:
+        sys.stdout.write("\x1b[2J")
+    try:
+        for linha in fonte:
+            if linha is not None:
+                espelho.processar(linha)
+            agora = time.monotonic()
+            if not args.sem_tela and espelho.alterado and agora - ultimo_desenho >= INTERVALO_DESENHO_S:
+                espelho.desenhar()
+                ultimo_desenho = agora
+    except KeyboardInterrupt:
+        pass
+    if not args.sem_tela:
+        espelho.desenhar()
+    else:
+        print(f"trechos {espelho.trechos}, {espelho.bytes_alterados} bytes alterados, "
+              f"{espelho.bytes_recebidos} comprimidos, {espelho.quadros_matriz} quadros da matriz")
+    if args.pbm:
+        espelho.salvar_pbm(args.pbm)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+"""Gera lib/Display_Bibliotecas/fonte_atlas.h a partir de font.h.
+
+Os glifos saem já no formato da GDDRAM do SSD1306 (um byte por coluna,
+bit 0 = linha de cima), com as colunas vazias das bordas removidas para
+formar uma fonte proporcional, e uma tabela de índice direto para os 256
+códigos Latin-1. Glifos que não existem em font.h (acentos, °, pontuação)
+são definidos abaixo como desenho ASCII ou compostos com um acento.
+
+Uso: python3 tools/gerar_fonte.py
+"""
+
+import os
+import re
+
+RAIZ = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+ORIGEM = os.path.join(RAIZ, "lib", "Display_Bibliotecas", "font.h")
+DESTINO = os.path.join(RAIZ, "lib", "Display_Bibliotecas", "fonte_atlas.h")
+
+LARGURA_ESPACO = 3
+
+# Ordem dos glifos de 8 bytes em font.h; os marcados com True estão gravados
+# em linhas (byte = linha, bit 7 = coluna da esquerda) em vez de colunas.
+LEGADO = (
+    [("\0", False)]
+    + [(c, False) for c in "0123456789"]
+    + [(c, False) for c in "ABCDEFGHIJKLMNOPQRSTUVWXYZ"]
+    + [(c, False) for c in "abcdefghijklmnopqrstuvwxyz"]
+    + [(" ", False), (":", True), (".", True), (">", True), ("-", True),
+       ("\x7f", False), ("!", True), ("%", True), ("/", True)]
+)
+
+# Glifos novos: 8 linhas, '#' = pixel aceso
+DESENHOS = {
+    "\xb0": [".#.", "#.#", ".#.", "...", "...", "...", "...", "..."],  # °
+    "(": ["..#", ".#.", "#..", "#..", "#..", ".#.", "..#", "..."],
+    ")": ["#..", ".#.", "..#", "..#", "..#", ".#.", "#..", "..."],
+    ",": ["..", "..", "..", "..", "..", ".#", ".#", "#."],
+    "+": ["...", "...", ".#.", "###", ".#.", "...", "...", "..."],
+    "=": ["...", "...", "###", "...", "###", "...", "...", "..."],
+    "?": [".##.", "#..#", "...#", "..#.", ".#..", "....", ".#..", "...."],
+    "<": ["...", "..#", ".#.", "#..", ".#.", "..#", "...", "..."],
+    "_": ["....", "....", "....", "....", "....", "....", "####", "...."],
+    "'": ["#", "#", ".", ".", ".", ".", ".", "."],
+    "\"": ["#.#", "#.#", "...", "...", "...", "...", "...", "..."],
+    "*": ["...", "#.#", ".#.", "###", ".#.", "#.#", "...", "..."],
+    "#": [".#.#.", "#####", ".#.#.", ".#.#.", "#####", ".#.#.", ".....", "....."],
+    ";": ["..", "..", ".#", "..", "..", ".#", ".#", "#."],
+    "\xb5": ["....", "....", "#..#", "#..#", "#..#", "###.", "#...", "#..."],  # µ
+}
+
+# Acentos sobre as minúsculas: deslocamentos (coluna relativa ao centro, linha)
+ACENTOS = {
+    "agudo": [(1, 0), (0, 1)],
+    "grave": [(-1, 0), (0, 1)],
+    "circunflexo": [(-1, 1), (0, 0), (1, 1)],
+    "til": [(-1, 1), (0, 0), (1, 1), (2, 0)],
+}
+COMPOSTOS = {
+    "\xe1": ("a", "agudo"), "\xe0": ("a", "grave"), "\xe2": ("a", "circunflexo"), "\xe3": ("a", "til"),
+    "\xe9": ("e", "agudo"), "\xea": ("e", "circunflexo"),
+    "\xed": ("i", "agudo"),
+    "\xf3": ("o", "agudo"), "\xf4": ("o", "circunflexo"), "\xf5": ("o", "til"),
+    "\xfa": ("u", "agudo"),
+}
+
+# Glifo exibido no lugar de caracteres sem desenho (retângulo vazado)
+AUSENTE = [0x7E, 0x42, 0x42, 0x7E]
+
+
+def ler_bytes_legado():
+    texto = re.sub(r"//[^\n]*", "", open(ORIGEM, encoding="utf-8").read())
+    return [int(v, 16) for v in re.findall(r"0x[0-9a-fA-F]{2}", texto)]
+
+
+def linhas_para_colunas(linhas):
+    colunas = [0] * 8
+    for y, byte in enumerate(linhas):
+        for x in range(8):
+            if byte & (0x80 >> x):
+                colunas[x] |= 1 << y
+    return colunas
+
+
+def desenho_para_colunas(desenho):
+    colunas = [0] * len(desenho[0])
+    for y, linha in enumerate(desenho):
+        for x, pixel in enumerate(linha):
+            if pixel == "#":
+                colunas[x] |= 1 << y
+    return colunas
+
+
+def aparar(colunas):
+    while colunas and colunas[0] == 0:
+        colunas = colunas[1:]
+    while colunas and colunas[-1] == 0:
+        colunas = colunas[:-1]
+    return colunas
+
+
+def compor(base, acento):
+    colunas = list(base)
+    if len(colunas) < 3:  # 'i': o ponto dá lugar ao acento
+        colunas = [0] + [c & ~0x07 for c in colunas] + [0, 0]
+        centro = 1
+    else:
+        centro = len(colunas) // 2
+    for dx, y in ACENTOS[acento]:
+        x = centro + dx
+        if 0 <= x < len(colunas):
+            colunas[x] |= 1 << y
+    return aparar(colunas)
+
+
+def main():
+    dados = ler_bytes_legado()
+    glifos = {}
+    for n, (c, em_linhas) in enumerate(LEGADO):
+        bruto = dados[n * 8:(n + 1) * 8]
+        glifos[c] = aparar(linhas_para_colunas(bruto) if em_linhas else bruto)
+    for c, desenho in DESENHOS.items():
+        glifos[c] = aparar(desenho_para_colunas(desenho))
+    for c, (base, acento) in COMPOSTOS.items():
+        glifos[c] = compor(glifos[base], acento)
+    glifos["\xe7"] = glifos["c"][:2] + [glifos["c"][2] | 0x80] + glifos["c"][3:]  # ç
+    glifos[" "] = [0] * LARGURA_ESPACO
+    del glifos["\0"]
+
+    pequenos = []
+    for d in range(10):
+        linhas = dados[len(LEGADO) * 8 + d * 5:len(LEGADO) * 8 + (d + 1) * 5]
+        pequenos.append([sum(((linhas[y] >> (4 - x)) & 1) << y for y in range(5)) for x in range(5)])
+
+    ordem = [None] + sorted(glifos, key=ord)  # glifo 0 = ausente
+    colunas, offsets, larguras = [], [], []
+    for c in ordem:
+        dados_glifo = AUSENTE if c is None else glifos[c]
+        offsets.append(len(colunas))
+        larguras.append(len(dados_glifo))
+        colunas.extend(dados_glifo)
+    indice = [0] * 256
+    for n, c in enumerate(ordem[1:], start=1):
+        indice[ord(c)] = n
+
+    def nome(c):
+        if c is None:
+            return "ausente"
+        if c == "\x7f":
+            return "ohm"
+        if c == " ":
+            return "espaço"
+        return c if c.isprintable() else f"0x{ord(c):02X}"
+
+    def tabela(valores, por_linha=16, fmt="0x{:02X}"):
+        linhas = []
+        for i in range(0, len(valores), por_linha):
+            linhas.append("    " + ", ".join(fmt.format(v) for v in valores[i:i + por_linha]) + ",")
+        return "\n".join(linhas)
+
+    with open(DESTINO, "w", encoding="utf-8", newline="\n") as f:
+        f.write("// -------------------------------------------------------------- //\n")
+        f.write("// Gerado por tools/gerar_fonte.py a partir de font.h; não edite! //\n")
+        f.write("// -------------------------------------------------------------- //\n\n")
+        f.write("#pragma once\n\n#include <stdint.h>\n\n")
+        f.write("#define FONTE_ALTURA 8\n")
+        f.write("#define FONTE_ESPACAMENTO 1   // Coluna vazia entre glifos\n")
+        f.write(f"#define FONTE_NUM_GLIFOS {len(ordem)}\n")
+        f.write("#define FONTE_PEQUENA_LARGURA 5\n\n")
+        f.write("// Colunas de todos os glifos em sequência (bit 0 = linha de cima)\n")
+        f.write("static const uint8_t fonte_colunas[] = {\n")
+        for c, off, larg in zip(ordem, offsets, larguras):
+            bytes_glifo = ", ".join(f"0x{v:02X}" for v in colunas[off:off + larg])
+            f.write(f"    {bytes_glifo}, // {nome(c)}\n")
+        f.write("};\n\n")
+        f.write("// Início de cada glifo em fonte_colunas\n")
+        f.write("static const uint16_t fonte_offset[FONTE_NUM_GLIFOS] = {\n")
+        f.write(tabela(offsets, 12, "{:4d}") + "\n};\n\n")
+        f.write("// Largura de cada glifo em colunas\n")
+        f.write("static const uint8_t fonte_largura[FONTE_NUM_GLIFOS] = {\n")
+        f.write(tabela(larguras, 16, "{:2d}") + "\n};\n\n")
+        f.write("// Código Latin-1 -> glifo (0 = caractere sem desenho)\n")
+        f.write("static const uint8_t fonte_indice[256] = {\n")
+        f.write(tabela(indice, 16, "{:3d}") + "\n};\n\n")
+        f.write("// Dígitos 5x5 para ssd1306_draw_small_number (colunas, bit 0 = linha de cima)\n")
+        f.write("static const uint8_t fonte_pequena_colunas[10][FONTE_PEQUENA_LARGURA] = {\n")
+        for d, cols in enumerate(pequenos):
+            f.write("    {" + ", ".join(f"0x{v:02X}" for v in cols) + f"}}, // {d}\n")
+        f.write("};\n")
+
+
+if __name__ == "__main__":
+    main()
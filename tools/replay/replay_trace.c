@@ -0,0 +1,231 @@
+/* Replay das amostras gravadas pelo firmware ("trace on" no console).
+ *
+ * Passa cada amostra pelo mesmo classificador_processar() do laço principal
+ * (identificar_cor, alerta de lux e obter_grb_pelo_nome) e pelo motor de
+ * alarmes de lux (alarmes_lux_atualizar, no tempo do trace) e imprime uma
+ * decisão por linha:
+ *   <indice> <t_us> <cor> <grb> <alerta> <alarmes disparados (bits em hex)>
+ * Para comparar duas versões do classificador, rode o replay com o binário
+ * de cada uma e compare as saídas com --comparar.
+ *
+ * Uso:
+ *   replay_trace <trace.log> [-q] [-n passadas] [-l lux_min,lux_max] [-b b1,b2,b3]
+ *                [-a taxa_lux_s,desvio_z,espera_ms]
+ *   replay_trace --comparar <decisoes_a> <decisoes_b>
+ *
+ * -q suprime as decisões (só a vazão); -n repete o trace para medir a vazão
+ * com mais amostras. A vazão (amostras/s) e os disparos de cada regra de
+ * alarme saem em stderr. */
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "classificador_cor.h"
+#include "alarmes_lux.h"
+
+#define TRACE_VERSAO 1
+#define TAM_LINHA    256
+
+typedef struct {
+    uint32_t t_us;
+    amostra_sensores_t amostra;
+} registro_t;
+
+// --- Funções Internas ---
+
+static double agora_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Lê as linhas "@s" do log; o resto (printf normais do firmware) é ignorado
+static registro_t *carregar_trace(const char *caminho, size_t *quantidade) {
+    FILE *f = fopen(caminho, "r");
+    if (f == NULL) {
+        perror(caminho);
+        return NULL;
+    }
+    size_t capacidade = 1024, n = 0;
+    registro_t *registros = malloc(capacidade * sizeof(*registros));
+    char linha[TAM_LINHA];
+    unsigned long numero = 0;
+    while (registros && fgets(linha, sizeof(linha), f)) {
+        numero++;
+        int versao;
+        if (sscanf(linha, "@trace %d", &versao) == 1) {
+            if (versao != TRACE_VERSAO) {
+                fprintf(stderr, "%s:%lu: versao de trace %d nao suportada\n", caminho, numero, versao);
+                free(registros);
+                registros = NULL;
+            }
+            continue;
+        }
+        unsigned long t, r, g, b, c, lux;
+        if (strncmp(linha, "@s ", 3) != 0) continue;
+        if (sscanf(linha + 3, "%lu %lu %lu %lu %lu %lu", &t, &r, &g, &b, &c, &lux) != 6 ||
+            r > UINT16_MAX || g > UINT16_MAX || b > UINT16_MAX || c > UINT16_MAX || lux > UINT16_MAX) {
+            fprintf(stderr, "%s:%lu: amostra invalida ignorada\n", caminho, numero);
+            continue;
+        }
+        if (n == capacidade) {
+            capacidade *= 2;
+            registro_t *maior = realloc(registros, capacidade * sizeof(*registros));
+            if (maior == NULL) {
+                free(registros);
+                registros = NULL;
+                break;
+            }
+            registros = maior;
+        }
+        registros[n++] = (registro_t){ (uint32_t)t, { r, g, b, c, lux } };
+    }
+    fclose(f);
+    *quantidade = n;
+    return registros;
+}
+
+static int comparar(const char *caminho_a, const char *caminho_b) {
+    FILE *a = fopen(caminho_a, "r");
+    FILE *b = fopen(caminho_b, "r");
+    if (a == NULL || b == NULL) {
+        perror(a == NULL ? caminho_a : caminho_b);
+        if (a) fclose(a);
+        if (b) fclose(b);
+        return 2;
+    }
+    char la[TAM_LINHA], lb[TAM_LINHA];
+    unsigned long linhas = 0, diferentes = 0;
+    for (;;) {
+        char *fa = fgets(la, sizeof(la), a);
+        char *fb = fgets(lb, sizeof(lb), b);
+        if (fa == NULL && fb == NULL) break;
+        linhas++;
+        if (fa == NULL || fb == NULL || strcmp(la, lb) != 0) {
+            diferentes++;
+            printf("- %s", fa ? la : "(fim)\n");
+            printf("+ %s", fb ? lb : "(fim)\n");
+        }
+    }
+    fclose(a);
+    fclose(b);
+    printf("%lu de %lu decisoes diferentes\n", diferentes, linhas);
+    return diferentes ? 1 : 0;
+}
+
+static int ler_lista(const char *texto, int32_t *valores, int quantidade) {
+    for (int i = 0; i < quantidade; i++) {
+        char *fim;
+        valores[i] = (int32_t)strtol(texto, &fim, 10);
+        if (fim == texto || *fim != (i + 1 < quantidade ? ',' : '\0')) return 0;
+        texto = fim + 1;
+    }
+    return 1;
+}
+
+static void uso(void) {
+    fprintf(stderr,
+            "uso: replay_trace <trace.log> [-q] [-n passadas] [-l lux_min,lux_max] [-b b1,b2,b3]\n"
+            "                  [-a taxa_lux_s,desvio_z,espera_ms]\n"
+            "     replay_trace --comparar <decisoes_a> <decisoes_b>\n");
+}
+
+// --- Programa ---
+
+int main(int argc, char **argv) {
+    if (argc == 4 && strcmp(argv[1], "--comparar") == 0) return comparar(argv[2], argv[3]);
+
+    // Os mesmos padrões de parametros.c
+    config_classificador_t config = {
+        .cor = LIMIARES_COR_PADRAO,
+        .lux_min = 20,
+        .lux_max = 100,
+        .brilho_lux = {50, 300, 1000},
+    };
+    config_alarmes_lux_t config_alarmes = {
+        .histerese_lux = 2,
+        .espera_ms = 10000,
+        .taxa_max_lux_s = 15.0f,
+        .desvio_z = 4.0f,
+        .desvio_min_lux = 5.0f,
+    };
+    const char *caminho = NULL;
+    int silencioso = 0;
+    long passadas = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0) {
+            silencioso = 1;
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            passadas = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+            int32_t lux[2];
+            if (!ler_lista(argv[++i], lux, 2)) { uso(); return 2; }
+            config.lux_min = lux[0];
+            config.lux_max = lux[1];
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            if (!ler_lista(argv[++i], config.brilho_lux, 3)) { uso(); return 2; }
+        } else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+            int32_t alarme[3];
+            if (!ler_lista(argv[++i], alarme, 3) || alarme[2] < 0) { uso(); return 2; }
+            config_alarmes.taxa_max_lux_s = (float)alarme[0];
+            config_alarmes.desvio_z = (float)alarme[1];
+            config_alarmes.espera_ms = (uint32_t)alarme[2];
+        } else if (argv[i][0] != '-' && caminho == NULL) {
+            caminho = argv[i];
+        } else {
+            uso();
+            return 2;
+        }
+    }
+    if (caminho == NULL || passadas < 1) {
+        uso();
+        return 2;
+    }
+    // obter_grb_pelo_nome divide por (fim - início - 1) de cada faixa
+    if (config.brilho_lux[1] <= config.brilho_lux[0] + 1 || config.brilho_lux[2] <= config.brilho_lux[1] + 1) {
+        fprintf(stderr, "erro: b1 < b2 < b3, com folga de 2\n");
+        return 2;
+    }
+    config_alarmes.lux_min = config.lux_min;
+    config_alarmes.lux_max = config.lux_max;
+
+    size_t n;
+    registro_t *registros = carregar_trace(caminho, &n);
+    if (registros == NULL) return 2;
+    if (n == 0) {
+        fprintf(stderr, "%s: nenhuma amostra (linhas \"@s\")\n", caminho);
+        free(registros);
+        return 2;
+    }
+
+    // Decisões impressas só na primeira passada; as demais medem o pipeline sozinho
+    uint32_t verificacao = 0;
+    alarmes_lux_t alarmes;
+    double inicio = agora_s();
+    for (long p = 0; p < passadas; p++) {
+        alarmes_lux_init(&alarmes, ALARMES_LUX_JANELA_PADRAO);
+        for (size_t i = 0; i < n; i++) {
+            decisao_cor_t d;
+            classificador_processar(&registros[i].amostra, &config, &d);
+            uint8_t disparados = alarmes_lux_atualizar(&alarmes, &config_alarmes, registros[i].amostra.lux,
+                                                       registros[i].t_us / 1000);
+            verificacao += d.grb + d.lux_fora_do_limite + disparados;
+            if (p == 0 && !silencioso) {
+                printf("%zu %lu %s %06lX %d %X\n", i, (unsigned long)registros[i].t_us, d.cor,
+                       (unsigned long)d.grb, d.lux_fora_do_limite, disparados);
+            }
+        }
+    }
+    double duracao = agora_s() - inicio;
+
+    double total = (double)n * passadas;
+    fprintf(stderr, "%zu amostras x %ld passadas em %.3f s: %.0f amostras/s (%.1f ns/amostra) [%08lX]\n",
+            n, passadas, duracao, total / duracao, duracao * 1e9 / total, (unsigned long)verificacao);
+    fprintf(stderr, "alarmes (ultima passada): baixo %lu, alto %lu, variacao %lu, desvio %lu\n",
+            (unsigned long)alarmes.disparos[0], (unsigned long)alarmes.disparos[1],
+            (unsigned long)alarmes.disparos[2], (unsigned long)alarmes.disparos[3]);
+    free(registros);
+    return 0;
+}
@@ -0,0 +1,378 @@
+/* Confere o espelho do display (lib/espelho.c) de ponta a ponta: o PackBits
+ * de espelho_packbits() contra um decodificador igual ao de tools/espelho.py,
+ * e o buffer reconstruído só a partir das linhas "@d" contra o ram_buffer do
+ * ssd1306.c real, depois de redesenhos de tela, textos trocados e rolagens de
+ * coluna. O último caso passa o mesmo log pelo próprio tools/espelho.py
+ * (--pbm) e compara a imagem; sem python3 ele é pulado.
+ *
+ * Uso: teste_espelho
+ *
+ * Cada caso imprime ok ou as verificações que falharam; o código de saída
+ * é 1 se alguma falhar. */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "espelho.h"
+#include "matriz_compositor.h"
+
+#define LARGURA 128
+#define ALTURA 64
+#define PAGINAS (ALTURA / 8)
+#define PAGINA_GRAFICO 2         // Como HISTORICO_PAGINA_INICIAL: o cabeçalho fica nas páginas 0-1
+#define MAX_TRECHO 512
+
+static int falhas_caso;
+
+#define CHECAR(cond) do { \
+        if (!(cond)) { \
+            printf("\n    linha %d: %s", __LINE__, #cond); \
+            falhas_caso++; \
+        } \
+    } while (0)
+
+static ssd1306_t ssd;
+static FILE *captura;            // Tudo o que o espelho escreveu na saída padrão
+static long lido;                // Quanto de `captura` o visualizador já processou
+
+// Visualizador: o que tools/espelho.py reconstrói
+static uint8_t gddram[PAGINAS * LARGURA];
+static bool sincronizado;
+static uint32_t trechos_lidos, quadros_lidos;
+static uint32_t matriz_lida[NUM_PIXELS];  // Ordem lógica, como na linha @m
+
+static uint32_t quadro_matriz[NUM_PIXELS];
+static uint32_t quadros_matriz_enviados;
+
+// --- Dependências de espelho.c e ssd1306.c ---
+
+// O teste só desenha no buffer; nada vai para o barramento
+i2c_status_t i2c_barramento_transferir(i2c_barramento_t *bar, uint8_t endereco, uint32_t baudrate,
+                                       const uint8_t *escrita, uint16_t tam_escrita,
+                                       uint8_t *leitura, uint16_t tam_leitura) {
+    return I2C_TRANSACAO_OK;
+}
+
+uint32_t compositor_copiar_quadro(uint32_t grb[NUM_PIXELS]) {
+    memcpy(grb, quadro_matriz, sizeof(quadro_matriz));
+    return quadros_matriz_enviados;
+}
+
+// --- Funções Internas ---
+
+// Porte de packbits_decodificar() de tools/espelho.py; retorna o tamanho decodificado
+static int packbits_decodificar(const uint8_t *dados, int n, uint8_t *saida, int maximo) {
+    int i = 0, o = 0;
+    while (i < n) {
+        uint8_t h = dados[i++];
+        if (h < 128) {                           // h + 1 bytes literais
+            if (i + h + 1 > n || o + h + 1 > maximo) return -1;
+            memcpy(&saida[o], &dados[i], h + 1);
+            o += h + 1;
+            i += h + 1;
+        } else if (h != 128) {                   // 257 - h cópias do próximo byte
+            if (i >= n || o + 257 - h > maximo) return -1;
+            memset(&saida[o], dados[i++], 257 - h);
+            o += 257 - h;
+        }
+    }
+    return o;
+}
+
+static int hex_para_bytes(const char *hex, uint8_t *saida, int maximo) {
+    int n = 0;
+    while (hex[0] && hex[1] && n < maximo) {
+        unsigned v;
+        if (sscanf(hex, "%2x", &v) != 1) return -1;
+        saida[n++] = (uint8_t)v;
+        hex += 2;
+    }
+    return hex[0] ? -1 : n;
+}
+
+// Processa as linhas novas da captura como o visualizador faria
+static void processar_captura(void) {
+    char linha[1024], hex[1024];
+    fflush(captura);
+    fseek(captura, lido, SEEK_SET);
+    while (fgets(linha, sizeof(linha), captura)) {
+        unsigned pagina, coluna, n, versao, largura, altura, lin_matriz, col_matriz;
+        if (sscanf(linha, "@espelho %u %u %u %u %u", &versao, &largura, &altura, &lin_matriz, &col_matriz) == 5) {
+            CHECAR(versao == ESPELHO_VERSAO && largura == LARGURA && altura == ALTURA);
+            CHECAR(lin_matriz == NUM_LINHAS && col_matriz == NUM_COLUNAS);
+            memset(gddram, 0, sizeof(gddram));
+            sincronizado = true;
+        } else if (sscanf(linha, "@d %u %u %u %1023s", &pagina, &coluna, &n, hex) == 4) {
+            uint8_t comprimido[MAX_TRECHO], dados[MAX_TRECHO];
+            int tam = hex_para_bytes(hex, comprimido, sizeof(comprimido));
+            CHECAR(tam > 0 && tam <= (int)(n + n / 128 + 1));
+            CHECAR(packbits_decodificar(comprimido, tam, dados, sizeof(dados)) == (int)n);
+            CHECAR(pagina < PAGINAS && coluna + n <= LARGURA);
+            if (pagina < PAGINAS && coluna + n <= LARGURA) memcpy(&gddram[pagina * LARGURA + coluna], dados, n);
+            trechos_lidos++;
+        } else if (strncmp(linha, "@m", 2) == 0) {
+            char *p = linha + 2;
+            for (int i = 0; i < NUM_PIXELS; i++) matriz_lida[i] = (uint32_t)strtoul(p, &p, 16);
+            quadros_lidos++;
+        }
+    }
+    lido = ftell(captura);
+}
+
+// Roda uma função do espelho com a saída padrão desviada para a captura
+static void com_captura(void (*funcao)(void)) {
+    fflush(stdout);
+    int terminal = dup(STDOUT_FILENO);
+    dup2(fileno(captura), STDOUT_FILENO);
+    funcao();
+    fflush(stdout);
+    dup2(terminal, STDOUT_FILENO);
+    close(terminal);
+    processar_captura();
+}
+
+static void ligar(void) {
+    espelho_ligar(true);
+}
+
+static void desligar(void) {
+    espelho_ligar(false);
+}
+
+// Atende o espelho e compara a reconstrução com o ram_buffer (sem o prefixo 0x40)
+static bool atender_e_comparar(void) {
+    com_captura(espelho_atender);
+    return sincronizado && memcmp(gddram, &ssd.ram_buffer[1], sizeof(gddram)) == 0;
+}
+
+static void preparar(void) {
+    free(ssd.ram_buffer);
+    ssd1306_init(&ssd, LARGURA, ALTURA, false, 0x3C, NULL);
+    memset(quadro_matriz, 0, sizeof(quadro_matriz));
+    sincronizado = false;
+    espelho_init(&ssd);
+    com_captura(desligar);
+    com_captura(ligar);
+}
+
+// Tela de Lux como a do firmware: moldura, títulos e números que mudam
+static void desenhar_tela_lux(uint32_t i) {
+    char texto[32];
+    ssd1306_fill(&ssd, false);
+    ssd1306_rect(&ssd, 0, 0, LARGURA, ALTURA, true, false);
+    ssd1306_draw_string(&ssd, "--- Luminosidade ---", 4, 4, false);
+    snprintf(texto, sizeof(texto), "Lux: %lu", (unsigned long)(i * 37 % 5000));
+    ssd1306_draw_string(&ssd, texto, 10, 20, false);
+    ssd1306_draw_string(&ssd, i % 3 ? "Status: OK 20-100" : "Status: ALTO", 10, 34, false);
+    snprintf(texto, sizeof(texto), "%lu", (unsigned long)(i * 7919 % 100000));
+    ssd1306_draw_string(&ssd, texto, 10 + i % 17, 48 + i % 9, true);
+}
+
+// Coluna do gráfico de histórico com a barra e o pontilhado dos limites
+static void desenhar_coluna(uint8_t x, uint32_t numero) {
+    uint8_t topo = PAGINA_GRAFICO * 8;
+    ssd1306_vline(&ssd, x, topo, ALTURA - 1, false);
+    if (numero % 4 == 0) {
+        ssd1306_pixel(&ssd, x, topo + 10, true);
+        ssd1306_pixel(&ssd, x, ALTURA - 8, true);
+    }
+    uint8_t a = topo + numero * 13 % (ALTURA - topo), b = topo + numero * 29 % (ALTURA - topo);
+    ssd1306_vline(&ssd, x, a < b ? a : b, a < b ? b : a, true);
+}
+
+static void desenhar_cabecalho(uint32_t i) {
+    char texto[24];
+    ssd1306_rect(&ssd, 0, 0, LARGURA, PAGINA_GRAFICO * 8, false, true);
+    snprintf(texto, sizeof(texto), "Lux: %lu", (unsigned long)(i * 53 % 2000));
+    ssd1306_draw_string(&ssd, texto, 0, 0, false);
+    ssd1306_hline(&ssd, 0, LARGURA - 1, PAGINA_GRAFICO * 8 - 2, true);
+}
+
+// --- Casos ---
+
+static void caso_packbits_bordas(void) {
+    static const struct { uint16_t n; uint8_t padrao; } entradas[] = {
+        { 1, 0 }, { 2, 0 }, { 3, 0 }, { 128, 0 }, { 129, 0 }, { 130, 0 }, { 300, 0 },  // Uma repetição
+        { 128, 1 }, { 129, 1 }, { 257, 1 },      // Literais de exatamente 128 e além
+        { 128, 2 }, { 127, 2 },                  // Pares alternados (ficam no literal)
+        { 128, 3 }, { 200, 3 },                  // Trincas alternadas com bytes soltos
+    };
+    for (size_t e = 0; e < sizeof(entradas) / sizeof(entradas[0]); e++) {
+        uint8_t dados[MAX_TRECHO], comprimido[MAX_TRECHO], volta[MAX_TRECHO];
+        uint16_t n = entradas[e].n;
+        for (uint16_t i = 0; i < n; i++) {
+            switch (entradas[e].padrao) {
+            case 0: dados[i] = 0xAA; break;
+            case 1: dados[i] = (uint8_t)i; break;
+            case 2: dados[i] = (uint8_t)(i / 2 * 3); break;
+            default: dados[i] = i % 4 == 3 ? (uint8_t)i : (uint8_t)(i / 4); break;
+            }
+        }
+        uint16_t tam = espelho_packbits(dados, n, comprimido);
+        CHECAR(tam <= n + n / 128 + 1);
+        CHECAR(packbits_decodificar(comprimido, tam, volta, sizeof(volta)) == n);
+        CHECAR(memcmp(dados, volta, n) == 0);
+    }
+}
+
+static void caso_packbits_aleatorio(void) {
+    srand(40);
+    for (int k = 0; k < 5000; k++) {
+        uint8_t dados[MAX_TRECHO], comprimido[MAX_TRECHO], volta[MAX_TRECHO];
+        uint16_t n = 1 + rand() % 300;
+        int alfabeto = 1 + rand() % 4;           // Poucos valores: repetições de todo tamanho
+        for (uint16_t i = 0; i < n; i++) dados[i] = (uint8_t)(rand() % alfabeto * 0x55);
+        uint16_t tam = espelho_packbits(dados, n, comprimido);
+        CHECAR(tam <= n + n / 128 + 1);
+        CHECAR(packbits_decodificar(comprimido, tam, volta, sizeof(volta)) == n);
+        CHECAR(memcmp(dados, volta, n) == 0);
+        if (falhas_caso) return;
+    }
+}
+
+static void caso_redesenhos(void) {
+    CHECAR(atender_e_comparar());
+    for (uint32_t i = 0; i < 50; i++) {
+        desenhar_tela_lux(i);
+        CHECAR(atender_e_comparar());
+    }
+    // Sem alteração, nada sai
+    uint32_t trechos = trechos_lidos;
+    CHECAR(atender_e_comparar());
+    CHECAR(trechos_lidos == trechos);
+}
+
+static void caso_rolagem(void) {
+    for (uint8_t x = 0; x < LARGURA; x++) desenhar_coluna(x, x);
+    desenhar_cabecalho(0);
+    CHECAR(atender_e_comparar());
+    for (uint32_t i = 1; i <= 200; i++) {
+        desenhar_cabecalho(i);
+        ssd1306_scroll_column_left(&ssd, PAGINA_GRAFICO, PAGINAS - 1);
+        desenhar_coluna(LARGURA - 1, LARGURA + i);
+        CHECAR(atender_e_comparar());
+        if (falhas_caso) return;
+    }
+    // Duas rolagens entre dois atendimentos também se reconstroem
+    ssd1306_scroll_column_left(&ssd, PAGINA_GRAFICO, PAGINAS - 1);
+    ssd1306_scroll_column_left(&ssd, PAGINA_GRAFICO, PAGINAS - 1);
+    desenhar_coluna(LARGURA - 1, 7);
+    CHECAR(atender_e_comparar());
+}
+
+static void caso_religar(void) {
+    desenhar_tela_lux(3);
+    CHECAR(atender_e_comparar());
+    com_captura(desligar);
+    desenhar_tela_lux(4);                        // Desligado: a alteração fica pendente no rastreador
+    com_captura(ligar);                          // Religar reenvia o buffer inteiro
+    CHECAR(atender_e_comparar());
+}
+
+static void caso_matriz(void) {
+    CHECAR(atender_e_comparar());
+    uint32_t quadros = quadros_lidos;
+    CHECAR(quadros >= 1);                        // Ao ligar a matriz sai mesmo sem mudança
+    for (int i = 0; i < NUM_PIXELS; i++) quadro_matriz[i] = 0x010203u * (i + 1);
+    quadros_matriz_enviados++;
+    CHECAR(atender_e_comparar());
+    CHECAR(quadros_lidos == quadros + 1);
+    for (int lin = 0; lin < NUM_LINHAS; lin++) {
+        for (int col = 0; col < NUM_COLUNAS; col++) {
+            CHECAR(matriz_lida[lin * NUM_COLUNAS + col] == (quadro_matriz[MATRIZ_INDICE_FISICO(lin, col)] & 0xFFFFFF));
+        }
+    }
+    CHECAR(atender_e_comparar());
+    CHECAR(quadros_lidos == quadros + 1);        // Quadro repetido não sai de novo
+}
+
+// O log inteiro desde o último @espelho pelo visualizador de verdade
+static void caso_espelho_py(void) {
+    if (system("python3 -c '' >/dev/null 2>&1") != 0) {
+        printf("python3 ausente, pulado ");
+        return;
+    }
+    for (uint32_t i = 0; i < 20; i++) {
+        desenhar_tela_lux(i);
+        CHECAR(atender_e_comparar());
+    }
+    for (uint32_t i = 0; i < 40; i++) {
+        ssd1306_scroll_column_left(&ssd, PAGINA_GRAFICO, PAGINAS - 1);
+        desenhar_coluna(LARGURA - 1, i);
+        desenhar_cabecalho(i);
+        CHECAR(atender_e_comparar());
+    }
+
+    char log[] = "/tmp/teste_espelho_XXXXXX", pbm[sizeof(log) + 4], comando[512];
+    int fd = mkstemp(log);
+    CHECAR(fd >= 0);
+    if (fd < 0) return;
+    FILE *f = fdopen(fd, "w");
+    char bloco[4096];
+    size_t n;
+    fflush(captura);
+    rewind(captura);
+    while ((n = fread(bloco, 1, sizeof(bloco), captura)) > 0) fwrite(bloco, 1, n, f);
+    fclose(f);
+    fseek(captura, lido, SEEK_SET);
+    snprintf(pbm, sizeof(pbm), "%s.pbm", log);
+    snprintf(comando, sizeof(comando), "python3 '%s' '%s' --sem-tela --pbm '%s' >/dev/null", ESPELHO_PY, log, pbm);
+    CHECAR(system(comando) == 0);
+
+    FILE *imagem = fopen(pbm, "r");
+    CHECAR(imagem != NULL);
+    if (imagem) {
+        unsigned largura = 0, altura = 0;
+        CHECAR(fscanf(imagem, "P1 %u %u", &largura, &altura) == 2 && largura == LARGURA && altura == ALTURA);
+        int diferentes = 0;
+        for (int y = 0; y < ALTURA; y++) {
+            for (int x = 0; x < LARGURA; x++) {
+                int bit = -1;
+                if (fscanf(imagem, "%d", &bit) != 1) bit = -1;
+                if (bit != ((ssd.ram_buffer[1 + (y / 8) * LARGURA + x] >> (y % 8)) & 1)) diferentes++;
+            }
+        }
+        CHECAR(diferentes == 0);
+        fclose(imagem);
+    }
+    remove(log);
+    remove(pbm);
+}
+
+static const struct {
+    const char *nome;
+    void (*executar)(void);
+} casos[] = {
+    { "PackBits: bordas",            caso_packbits_bordas },
+    { "PackBits: aleatorio",         caso_packbits_aleatorio },
+    { "Redesenhos de tela",          caso_redesenhos },
+    { "Rolagem de colunas",          caso_rolagem },
+    { "Desligar e religar",          caso_religar },
+    { "Quadro da matriz",            caso_matriz },
+    { "tools/espelho.py",            caso_espelho_py },
+};
+
+// --- Programa ---
+
+int main(void) {
+    captura = tmpfile();
+    if (!captura) {
+        perror("tmpfile");
+        return 2;
+    }
+    int falhas = 0;
+    for (size_t i = 0; i < sizeof(casos) / sizeof(casos[0]); i++) {
+        falhas_caso = 0;
+        printf("%-30s", casos[i].nome);
+        preparar();
+        casos[i].executar();
+        printf(falhas_caso ? "\n    FALHOU\n" : "ok\n");
+        falhas += falhas_caso;
+    }
+    espelho_estatisticas_t e = espelho_obter_estatisticas();
+    printf("%lu trechos: %lu bytes alterados, %lu enviados em PackBits\n", (unsigned long)e.trechos,
+           (unsigned long)e.bytes_alterados, (unsigned long)e.bytes_enviados);
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,540 @@
+/* SDK falso para lib/i2c_barramento.c: relógio e alarmes virtuais, tabela de
+ * interrupções, GPIO em dreno aberto, um modelo do bloco I2C do RP2040 (FIFOs,
+ * START/RESTART/STOP, abort por NACK) e o escravo com injeção de falhas.
+ *
+ * O modelo do bloco I2C é por byte, não por bit: um comando da FIFO de TX
+ * por passo. SDA presa pelo escravo impede qualquer progresso, como um
+ * START que não consegue ser gerado; só os pulsos de SCL da recuperação
+ * (por GPIO) soltam a linha.
+ *
+ * Já o PIO (pio_falso.c) anda ciclo a ciclo dentro do passo, e o escravo o
+ * acompanha bit a bit: START e STOP pelas bordas de SDA com SCL alto, bits
+ * amostrados na subida de SCL e SDA trocado só com SCL baixo. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "barramento_falso.h"
+#include "hardware/i2c.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/clocks.h"
+#include "hardware/pio.h"
+
+#define MAX_ALARMES 8
+#define NUM_PINOS 30
+#define LIMITE_RELOGIO_US 10000000ull    // Um teste que trava para aqui
+#define LATENCIA_IRQ_PIO_US 20           // Dois tempos de bit a 100 kHz
+#define DATA_CMD_VAZIO 0xFFFFFFFFu       // Nada escrito em data_cmd desde a última coleta
+#define DATA_CMD_LIDO  0x80000000u       // Byte da FIFO de RX posto para o código ler
+
+typedef struct {
+    alarm_id_t id;
+    uint64_t quando_us;
+    alarm_callback_t callback;
+    void *dados;
+} alarme_t;
+
+typedef struct {
+    i2c_hw_t hw;
+    uint32_t tx[IC_TX_BUFFER_DEPTH];
+    uint8_t tx_n;
+    uint8_t rx[IC_RX_BUFFER_DEPTH];
+    uint8_t rx_inicio, rx_n;
+    bool em_transferencia, lendo;
+    bool abortou, parou;         // TX_ABRT e STOP_DET ainda não limpos
+    uint32_t baudrate;
+} controlador_t;
+
+falso_escravo_t falso_escravo;
+i2c_inst_t i2c0_inst = { 0 }, i2c1_inst = { 1 };
+
+static uint64_t agora_us;
+static alarme_t alarmes[MAX_ALARMES];
+static alarm_id_t proximo_id;
+static bool recusar_alarmes;
+static irq_handler_t tratadores[NUM_IRQS];
+static bool irq_habilitada[NUM_IRQS];
+static controlador_t controladores[2];
+static controlador_t *em_acesso = &controladores[0];   // Último bloco pedido por i2c_get_hw
+
+// Pinos em dreno aberto: saída em 0 puxa a linha; entrada a deixa no pull-up
+static bool pino_saida[NUM_PINOS], pino_nivel[NUM_PINOS];
+static enum gpio_function pino_funcao[NUM_PINOS];
+static uint pino_oeover[NUM_PINOS];
+
+// Escravo bit a bit dos barramentos do PIO
+typedef enum {
+    BITS_OCIOSO,                 // Sem START desde o último STOP
+    BITS_ENDERECO,
+    BITS_ESCRITA,
+    BITS_ACK_ESCRAVO,            // Nono pulso de um byte recebido
+    BITS_LEITURA,
+    BITS_ACK_MESTRE,             // Nono pulso de um byte enviado
+    BITS_ESPERA,                 // Depois de um NACK, até o próximo START ou STOP
+} estado_bits_t;
+
+static struct {
+    estado_bits_t estado;
+    bool leitura;
+    uint8_t byte, bits;
+    bool puxa_sda, ack_mestre;
+    bool sda, scl;               // Níveis vistos na última chamada
+} escravo_bits;
+
+// --- Relógio e alarmes ---
+
+static void disparar_alarmes(void) {
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        alarme_t a = alarmes[i];
+        if (a.id == 0 || a.quando_us > agora_us) continue;
+        alarmes[i].id = 0;
+        a.callback(a.id, a.dados);
+    }
+}
+
+void falso_avancar_us(uint32_t us) {
+    agora_us += us;
+    if (agora_us > LIMITE_RELOGIO_US) {
+        fprintf(stderr, "barramento falso: relogio passou de %llu us, teste travado\n",
+                (unsigned long long)LIMITE_RELOGIO_US);
+        exit(2);
+    }
+}
+
+void falso_recusar_alarmes(bool recusar) {
+    recusar_alarmes = recusar;
+}
+
+uint64_t falso_agora_us(void) {
+    return agora_us;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t cb, void *user_data, bool fire_if_past) {
+    if (recusar_alarmes) return -1;
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        if (alarmes[i].id != 0) continue;
+        alarmes[i] = (alarme_t){ .id = ++proximo_id, .quando_us = agora_us + us, .callback = cb, .dados = user_data };
+        return alarmes[i].id;
+    }
+    return -1;
+}
+
+bool cancel_alarm(alarm_id_t id) {
+    for (int i = 0; i < MAX_ALARMES; i++) {
+        if (alarmes[i].id == id) {
+            alarmes[i].id = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+void busy_wait_us_32(uint32_t us) {
+    falso_avancar_us(us);
+}
+
+uint32_t clock_get_hz(enum clock_index clk) {
+    return 125000000;
+}
+
+// --- Interrupções ---
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    tratadores[num] = handler;
+}
+
+void irq_set_priority(uint num, uint8_t priority) {
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    irq_habilitada[num] = enabled;
+}
+
+// --- GPIO ---
+
+static bool pino_no_pio(uint pino) {
+    return pino_funcao[pino] == GPIO_FUNC_PIO0 || pino_funcao[pino] == GPIO_FUNC_PIO1;
+}
+
+static bool nivel_linha(uint pino) {
+    if (pino_saida[pino] && !pino_nivel[pino]) return false;
+    if (pino_no_pio(pino)) {
+        unsigned bloco = pino_funcao[pino] == GPIO_FUNC_PIO1;
+        bool oe = ((falso_pio_direcoes(bloco) >> pino) & 1) ^ (pino_oeover[pino] == GPIO_OVERRIDE_INVERT);
+        if (oe && !((falso_pio_saidas(bloco) >> pino) & 1)) return false;
+    }
+    return !(pino == FALSO_SDA && (falso_escravo.sda_presa > 0 || escravo_bits.puxa_sda));
+}
+
+void gpio_init(uint gpio) {
+    gpio_set_function(gpio, GPIO_FUNC_SIO);
+    pino_saida[gpio] = false;
+    pino_nivel[gpio] = false;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    bool scl_subiu = gpio == FALSO_SCL && pino_saida[gpio] && !out;
+    pino_saida[gpio] = out;
+    if (scl_subiu && pino_funcao[gpio] == GPIO_FUNC_SIO) falso_escravo_pulso_scl();
+    falso_linhas_mudaram();
+}
+
+// Como no SDK, trocar a função reescreve o registrador de controle e zera os overrides
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    pino_funcao[gpio] = fn;
+    pino_oeover[gpio] = GPIO_OVERRIDE_NORMAL;
+    falso_linhas_mudaram();
+}
+
+void gpio_pull_up(uint gpio) {
+}
+
+void gpio_set_oeover(uint gpio, uint value) {
+    pino_oeover[gpio] = value;
+    falso_linhas_mudaram();
+}
+
+void gpio_put(uint gpio, bool value) {
+    pino_nivel[gpio] = value;
+}
+
+bool gpio_get(uint gpio) {
+    return nivel_linha(gpio);
+}
+
+// --- Escravo ---
+
+static uint8_t ponteiro_escravo;
+static int escritos_escravo;     // Bytes escritos desde o último START
+
+void falso_prender_sda(int pulsos) {
+    falso_escravo.sda_presa = pulsos;
+}
+
+bool falso_escravo_start(uint8_t endereco, bool leitura) {
+    falso_escravo.starts++;
+    falso_escravo.bytes_lidos = 0;
+    escritos_escravo = 0;
+    return endereco == FALSO_ENDERECO;
+}
+
+bool falso_escravo_escrever(uint8_t byte) {
+    int k = escritos_escravo++;
+    if (k == falso_escravo.nack_no_byte) return false;
+    if (k == 0) {
+        ponteiro_escravo = byte % sizeof(falso_escravo.memoria);
+    } else {
+        falso_escravo.memoria[ponteiro_escravo++ % sizeof(falso_escravo.memoria)] = byte;
+    }
+    return true;
+}
+
+uint8_t falso_escravo_ler(void) {
+    uint8_t byte = falso_escravo.memoria[ponteiro_escravo++ % sizeof(falso_escravo.memoria)];
+    if (++falso_escravo.bytes_lidos == (uint32_t)falso_escravo.prender_apos_leitura) {
+        falso_escravo.sda_presa = falso_escravo.pulsos_para_soltar;
+    }
+    return byte;
+}
+
+void falso_escravo_stop(void) {
+    falso_escravo.stops++;
+}
+
+void falso_escravo_pulso_scl(void) {
+    falso_escravo.pulsos_scl++;
+    if (falso_escravo.sda_presa > 0) falso_escravo.sda_presa--;
+}
+
+// --- Escravo bit a bit ---
+
+static void carregar_byte_lido(void) {
+    escravo_bits.byte = falso_escravo_ler();
+    escravo_bits.bits = 0;
+    escravo_bits.estado = BITS_LEITURA;
+    escravo_bits.puxa_sda = !(escravo_bits.byte & 0x80);
+}
+
+// Fim do oitavo bit de um byte recebido: responde ACK puxando SDA no nono pulso
+static void responder_ack(bool ack) {
+    escravo_bits.puxa_sda = ack;
+    escravo_bits.estado = ack ? BITS_ACK_ESCRAVO : BITS_ESPERA;
+}
+
+static void subida_scl(bool sda) {
+    switch (escravo_bits.estado) {
+    case BITS_ENDERECO:
+    case BITS_ESCRITA:
+        escravo_bits.byte = (uint8_t)(escravo_bits.byte << 1 | sda);
+        escravo_bits.bits++;
+        break;
+    case BITS_LEITURA:
+        escravo_bits.bits++;
+        break;
+    case BITS_ACK_MESTRE:
+        escravo_bits.ack_mestre = !sda;
+        break;
+    default:
+        break;
+    }
+}
+
+static void descida_scl(void) {
+    switch (escravo_bits.estado) {
+    case BITS_ENDERECO:
+        if (escravo_bits.bits < 8) break;
+        escravo_bits.leitura = escravo_bits.byte & 1;
+        responder_ack(falso_escravo_start(escravo_bits.byte >> 1, escravo_bits.leitura));
+        break;
+    case BITS_ESCRITA:
+        if (escravo_bits.bits < 8) break;
+        responder_ack(falso_escravo_escrever(escravo_bits.byte));
+        break;
+    case BITS_ACK_ESCRAVO:
+        escravo_bits.puxa_sda = false;
+        if (escravo_bits.leitura) {
+            carregar_byte_lido();
+        } else {
+            escravo_bits.estado = BITS_ESCRITA;
+            escravo_bits.byte = 0;
+            escravo_bits.bits = 0;
+        }
+        break;
+    case BITS_LEITURA:
+        if (escravo_bits.bits < 8) {
+            escravo_bits.puxa_sda = !((escravo_bits.byte >> (7 - escravo_bits.bits)) & 1);
+        } else {
+            escravo_bits.puxa_sda = false;
+            escravo_bits.estado = BITS_ACK_MESTRE;
+        }
+        break;
+    case BITS_ACK_MESTRE:
+        if (escravo_bits.ack_mestre) {
+            carregar_byte_lido();
+        } else {
+            escravo_bits.estado = BITS_ESPERA;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// Só acompanha os pinos quando estão no PIO: o bloco I2C falso e a
+// recuperação por GPIO falam com o escravo direto, por byte e por pulso
+void falso_linhas_mudaram(void) {
+    bool sda = nivel_linha(FALSO_SDA), scl = nivel_linha(FALSO_SCL);
+    bool no_pio = pino_no_pio(FALSO_SDA) && pino_no_pio(FALSO_SCL);
+    if (no_pio && scl != escravo_bits.scl) {
+        if (sda != escravo_bits.sda) falso_escravo.corridas++;
+        if (scl) {
+            falso_escravo.subidas_scl++;
+            subida_scl(sda);
+        } else {
+            descida_scl();
+            sda = nivel_linha(FALSO_SDA);
+        }
+    } else if (no_pio && scl && sda != escravo_bits.sda) {
+        if (!sda) {
+            // START ou RESTART
+            escravo_bits.estado = BITS_ENDERECO;
+            escravo_bits.byte = 0;
+            escravo_bits.bits = 0;
+            escravo_bits.puxa_sda = false;
+            sda = nivel_linha(FALSO_SDA);
+        } else if (escravo_bits.estado != BITS_OCIOSO) {
+            falso_escravo_stop();
+            escravo_bits.estado = BITS_OCIOSO;
+            escravo_bits.puxa_sda = false;
+        }
+    }
+    escravo_bits.sda = sda;
+    escravo_bits.scl = scl;
+}
+
+// --- Bloco I2C ---
+
+// Leva para a FIFO de TX o que o código escreveu em data_cmd desde a última coleta
+static void coletar_tx(controlador_t *c) {
+    uint32_t v = c->hw.data_cmd;
+    if (v == DATA_CMD_VAZIO || (v & DATA_CMD_LIDO)) return;
+    if (c->tx_n < IC_TX_BUFFER_DEPTH) c->tx[c->tx_n++] = v;
+    c->hw.data_cmd = DATA_CMD_VAZIO;
+}
+
+static void esvaziar(controlador_t *c) {
+    c->tx_n = 0;
+    c->rx_n = 0;
+    c->rx_inicio = 0;
+    c->em_transferencia = false;
+    c->hw.data_cmd = DATA_CMD_VAZIO;
+}
+
+uint falso_i2c_leitura(falso_registrador_t reg) {
+    controlador_t *c = em_acesso;
+    i2c_hw_t *hw = &c->hw;
+    coletar_tx(c);
+    switch (reg) {
+    case FALSO_TXFLR:
+        *(io_rw_32 *)&hw->txflr_[0] = c->tx_n;
+        break;
+    case FALSO_RXFLR:
+        // Quem lê RXFLR > 0 lê data_cmd em seguida: o byte já fica nele
+        *(io_rw_32 *)&hw->rxflr_[0] = c->rx_n;
+        if (c->rx_n > 0) {
+            hw->data_cmd = DATA_CMD_LIDO | c->rx[c->rx_inicio];
+            c->rx_inicio = (c->rx_inicio + 1) % IC_RX_BUFFER_DEPTH;
+            c->rx_n--;
+        }
+        break;
+    case FALSO_CLR_INTR:
+        c->abortou = c->parou = false;
+        break;
+    case FALSO_CLR_TX_ABRT:
+        c->abortou = false;
+        break;
+    case FALSO_CLR_STOP_DET:
+        c->parou = false;
+        break;
+    }
+    return 0;
+}
+
+i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) {
+    em_acesso = &controladores[i2c->indice];
+    return &em_acesso->hw;
+}
+
+uint i2c_hw_index(i2c_inst_t *i2c) {
+    return i2c->indice;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    controlador_t *c = &controladores[i2c->indice];
+    esvaziar(c);
+    c->abortou = c->parou = false;
+    c->hw.enable = I2C_IC_ENABLE_ENABLE_BITS;
+    c->hw.intr_mask = 0xFFF;     // O reset do bloco deixa todas as fontes habilitadas
+    c->baudrate = baudrate;
+    return baudrate;
+}
+
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate) {
+    controladores[i2c->indice].baudrate = baudrate;
+    return baudrate;
+}
+
+uint32_t falso_baudrate_i2c(unsigned indice) {
+    return controladores[indice].baudrate;
+}
+
+// NACK: o bloco descarta a FIFO de TX e gera o STOP sozinho
+static void abortar(controlador_t *c) {
+    c->tx_n = 0;
+    c->em_transferencia = false;
+    c->abortou = c->parou = true;
+    falso_escravo_stop();
+}
+
+// Executa o comando na frente da FIFO de TX
+static void executar_comando(controlador_t *c) {
+    if (c->tx_n == 0 || falso_escravo.sda_presa > 0) return;
+    uint32_t cmd = c->tx[0];
+    bool leitura = cmd & I2C_IC_DATA_CMD_CMD_BITS;
+    if (leitura && c->rx_n == IC_RX_BUFFER_DEPTH) return;    // Segura SCL até a FIFO de RX ser lida
+    c->tx_n--;
+    memmove(c->tx, c->tx + 1, c->tx_n * sizeof(c->tx[0]));
+
+    // START no primeiro comando; RESTART pedido ou na troca de direção
+    if (!c->em_transferencia || (cmd & I2C_IC_DATA_CMD_RESTART_BITS) || leitura != c->lendo) {
+        c->em_transferencia = true;
+        c->lendo = leitura;
+        if (!falso_escravo_start((uint8_t)c->hw.tar, leitura)) {
+            abortar(c);
+            return;
+        }
+    }
+    if (leitura) {
+        c->rx[(c->rx_inicio + c->rx_n++) % IC_RX_BUFFER_DEPTH] = falso_escravo_ler();
+    } else if (!falso_escravo_escrever((uint8_t)cmd)) {
+        abortar(c);
+        return;
+    }
+    if (cmd & I2C_IC_DATA_CMD_STOP_BITS) {
+        falso_escravo_stop();
+        c->em_transferencia = false;
+        c->parou = true;
+    }
+}
+
+static uint32_t estado_irq(const controlador_t *c) {
+    uint32_t bruto = 0;
+    if (c->tx_n == 0) bruto |= I2C_IC_INTR_STAT_R_TX_EMPTY_BITS;
+    if (c->rx_n > 0) bruto |= I2C_IC_INTR_STAT_R_RX_FULL_BITS;
+    if (c->abortou) bruto |= I2C_IC_INTR_STAT_R_TX_ABRT_BITS;
+    if (c->parou) bruto |= I2C_IC_INTR_STAT_R_STOP_DET_BITS;
+    return bruto & c->hw.intr_mask;
+}
+
+// --- Passo do barramento ---
+
+void tight_loop_contents(void) {
+    uint32_t byte_us = controladores[0].baudrate ? 9000000u / controladores[0].baudrate : 10;
+    if (byte_us == 0) byte_us = 1;
+    falso_avancar_us(byte_us);
+
+    for (uint i = 0; i < 2; i++) {
+        controlador_t *c = &controladores[i];
+        uint irq = i == 0 ? I2C0_IRQ : I2C1_IRQ;
+        coletar_tx(c);
+        executar_comando(c);
+        uint32_t estado = estado_irq(c);
+        if (estado && irq_habilitada[irq] && tratadores[irq]) {
+            *(io_rw_32 *)&c->hw.intr_stat = estado;
+            tratadores[irq]();
+            coletar_tx(c);
+        }
+    }
+
+    // O PIO anda de microssegundo em microssegundo; a interrupção dele só é
+    // atendida a cada LATENCIA_IRQ_PIO_US, para a SM andar sozinha nesse meio
+    for (uint32_t us = 0; us < byte_us; us++) {
+        falso_pio_avancar_us(1);
+        if ((agora_us - byte_us + us + 1) % LATENCIA_IRQ_PIO_US != 0) continue;
+        for (unsigned bloco = 0; bloco < 2; bloco++) {
+            uint irq = bloco == 0 ? PIO0_IRQ_0 : PIO1_IRQ_0;
+            if (falso_pio_irq_pendente(bloco) && irq_habilitada[irq] && tratadores[irq]) tratadores[irq]();
+        }
+    }
+    disparar_alarmes();
+}
+
+uint32_t save_and_disable_interrupts(void) {
+    return 0;
+}
+
+void restore_interrupts(uint32_t estado) {
+    coletar_tx(em_acesso);
+}
+
+void falso_reiniciar(void) {
+    agora_us = 0;
+    memset(alarmes, 0, sizeof(alarmes));
+    recusar_alarmes = false;
+    memset(tratadores, 0, sizeof(tratadores));
+    memset(irq_habilitada, 0, sizeof(irq_habilitada));
+    memset(controladores, 0, sizeof(controladores));
+    for (int i = 0; i < 2; i++) esvaziar(&controladores[i]);
+    em_acesso = &controladores[0];
+    falso_pio_reiniciar();
+    memset(&escravo_bits, 0, sizeof(escravo_bits));
+    for (uint p = 0; p < NUM_PINOS; p++) gpio_init(p);
+
+    memset(&falso_escravo, 0, sizeof(falso_escravo));
+    for (size_t i = 0; i < sizeof(falso_escravo.memoria); i++) falso_escravo.memoria[i] = 0x10 + i;
+    falso_escravo.nack_no_byte = -1;
+    falso_escravo.prender_apos_leitura = -1;
+    ponteiro_escravo = 0;
+    escritos_escravo = 0;
+}
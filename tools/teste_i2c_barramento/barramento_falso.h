@@ -0,0 +1,67 @@
+#ifndef BARRAMENTO_FALSO_H
+#define BARRAMENTO_FALSO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ---------- Barramento falso dos testes de lib/i2c_barramento.c ----------
+ * Um escravo de registradores (ponteiro de 1 byte e memória com
+ * auto-incremento) responde em FALSO_ENDERECO; qualquer outro endereço
+ * recebe NACK. As falhas são ligadas em `falso_escravo` antes da transação.
+ * O relógio é virtual: cada passo (uma volta de tight_loop_contents) dura
+ * um byte na velocidade atual e entrega as interrupções e os alarmes que
+ * vencerem nele. Com os pinos no PIO, o mesmo escravo é acionado bit a bit
+ * pelos níveis de SDA e SCL que o programa produz. */
+
+#define FALSO_ENDERECO 0x50
+#define FALSO_SDA 4              // Pinos do I2C0 nos testes
+#define FALSO_SCL 5
+
+typedef struct {
+    uint8_t memoria[32];
+    int nack_no_byte;            // Byte escrito que recebe NACK (0 = o do registrador; -1 = nenhum)
+    int prender_apos_leitura;    // Segura SDA em nível baixo depois de n bytes lidos (-1 = nunca)
+    int pulsos_para_soltar;      // Pulsos de SCL até soltar SDA de novo
+
+    // Observado pelos testes
+    uint32_t starts, stops, pulsos_scl;
+    uint32_t bytes_lidos;        // Na transferência atual
+    uint32_t subidas_scl;        // Vistas pelo escravo bit a bit (pinos no PIO)
+    uint32_t corridas;           // SDA e SCL trocados no mesmo ciclo: a ordem no fio fica indefinida
+    int sda_presa;               // Pulsos que ainda faltam (0 = SDA solta)
+} falso_escravo_t;
+
+extern falso_escravo_t falso_escravo;
+
+// Controladores, pinos, escravo e relógio em repouso; memória com 0x10 + i
+void falso_reiniciar(void);
+uint64_t falso_agora_us(void);
+uint32_t falso_baudrate_i2c(unsigned indice);
+
+// add_alarm_in_us devolve -1, como o SDK com todos os alarmes ocupados
+void falso_recusar_alarmes(bool recusar);
+
+// O escravo chega travado, segurando SDA até receber `pulsos` pulsos de SCL
+void falso_prender_sda(int pulsos);
+
+// Lado do escravo, em bytes, para os controladores falsos. Retornam o ACK.
+bool falso_escravo_start(uint8_t endereco, bool leitura);
+bool falso_escravo_escrever(uint8_t byte);
+uint8_t falso_escravo_ler(void);
+void falso_escravo_stop(void);
+void falso_escravo_pulso_scl(void);
+
+// Um passo do relógio virtual sem andar nenhum controlador (esperas ativas)
+void falso_avancar_us(uint32_t us);
+
+// Avisa o escravo de que SDA ou SCL podem ter mudado de nível
+void falso_linhas_mudaram(void);
+
+// PIO falso (pio_falso.c): pinos de cada bloco, SMs e a fonte 0 de interrupção
+uint32_t falso_pio_saidas(unsigned bloco);
+uint32_t falso_pio_direcoes(unsigned bloco);
+bool falso_pio_irq_pendente(unsigned bloco);
+void falso_pio_avancar_us(uint32_t us);      // Roda as SMs habilitadas pelo tempo dado
+void falso_pio_reiniciar(void);
+
+#endif // BARRAMENTO_FALSO_H
@@ -0,0 +1,10 @@
+#ifndef FALSO_HARDWARE_CLOCKS_H
+#define FALSO_HARDWARE_CLOCKS_H
+
+#include <stdint.h>
+
+enum clock_index { clk_gpout0 = 0, clk_ref = 4, clk_sys = 5, clk_peri = 6 };
+
+uint32_t clock_get_hz(enum clock_index clk);
+
+#endif // FALSO_HARDWARE_CLOCKS_H
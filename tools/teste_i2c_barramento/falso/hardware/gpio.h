@@ -0,0 +1,22 @@
+#ifndef FALSO_HARDWARE_GPIO_H
+#define FALSO_HARDWARE_GPIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef unsigned int uint;
+
+enum gpio_function { GPIO_FUNC_I2C = 3, GPIO_FUNC_SIO = 5, GPIO_FUNC_PIO0 = 6, GPIO_FUNC_PIO1 = 7, GPIO_FUNC_NULL = 0x1f };
+enum gpio_override { GPIO_OVERRIDE_NORMAL = 0, GPIO_OVERRIDE_INVERT = 1, GPIO_OVERRIDE_LOW = 2, GPIO_OVERRIDE_HIGH = 3 };
+#define GPIO_IN false
+#define GPIO_OUT true
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+void gpio_pull_up(uint gpio);
+void gpio_set_oeover(uint gpio, uint value);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+
+#endif // FALSO_HARDWARE_GPIO_H
@@ -0,0 +1,59 @@
+/* Bloco I2C (DW_apb_i2c) do RP2040, só com os registradores que lib/i2c_barramento.c usa */
+#ifndef FALSO_HARDWARE_I2C_H
+#define FALSO_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+typedef volatile uint32_t io_rw_32;
+typedef const volatile uint32_t io_ro_32;
+
+#define IC_TX_BUFFER_DEPTH 16
+#define IC_RX_BUFFER_DEPTH 16
+
+#define I2C_IC_DATA_CMD_CMD_BITS      0x100u
+#define I2C_IC_DATA_CMD_STOP_BITS     0x200u
+#define I2C_IC_DATA_CMD_RESTART_BITS  0x400u
+#define I2C_IC_ENABLE_ENABLE_BITS     0x1u
+
+#define I2C_IC_INTR_MASK_M_RX_FULL_BITS   0x004u
+#define I2C_IC_INTR_MASK_M_TX_EMPTY_BITS  0x010u
+#define I2C_IC_INTR_MASK_M_TX_ABRT_BITS   0x040u
+#define I2C_IC_INTR_MASK_M_STOP_DET_BITS  0x200u
+#define I2C_IC_INTR_STAT_R_RX_FULL_BITS   0x004u
+#define I2C_IC_INTR_STAT_R_TX_EMPTY_BITS  0x010u
+#define I2C_IC_INTR_STAT_R_TX_ABRT_BITS   0x040u
+#define I2C_IC_INTR_STAT_R_STOP_DET_BITS  0x200u
+
+typedef struct {
+    io_rw_32 enable;
+    io_rw_32 tar;
+    io_rw_32 data_cmd;           // Escrita: comando para a FIFO de TX; leitura: byte da FIFO de RX
+    io_rw_32 intr_mask;
+    io_ro_32 intr_stat;
+    io_ro_32 txflr_[1], rxflr_[1];
+    io_ro_32 clr_intr_[1], clr_tx_abrt_[1], clr_stop_det_[1];
+} i2c_hw_t;
+
+// Registradores cuja leitura tem efeito (esvaziar a FIFO, limpar interrupções)
+// passam pelo modelo: o índice é uma chamada que atualiza o valor antes da leitura
+typedef enum { FALSO_TXFLR, FALSO_RXFLR, FALSO_CLR_INTR, FALSO_CLR_TX_ABRT, FALSO_CLR_STOP_DET } falso_registrador_t;
+uint falso_i2c_leitura(falso_registrador_t reg);
+
+#define txflr        txflr_[falso_i2c_leitura(FALSO_TXFLR)]
+#define rxflr        rxflr_[falso_i2c_leitura(FALSO_RXFLR)]
+#define clr_intr     clr_intr_[falso_i2c_leitura(FALSO_CLR_INTR)]
+#define clr_tx_abrt  clr_tx_abrt_[falso_i2c_leitura(FALSO_CLR_TX_ABRT)]
+#define clr_stop_det clr_stop_det_[falso_i2c_leitura(FALSO_CLR_STOP_DET)]
+
+typedef struct i2c_inst { uint8_t indice; } i2c_inst_t;
+extern i2c_inst_t i2c0_inst, i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+// Também marca o bloco cujos registradores o código está acessando
+i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c);
+uint i2c_hw_index(i2c_inst_t *i2c);
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate);
+
+#endif // FALSO_HARDWARE_I2C_H
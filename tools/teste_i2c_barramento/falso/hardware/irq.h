@@ -0,0 +1,15 @@
+#ifndef FALSO_HARDWARE_IRQ_H
+#define FALSO_HARDWARE_IRQ_H
+
+#include "pico/stdlib.h"
+
+enum { PIO0_IRQ_0 = 7, PIO1_IRQ_0 = 9, I2C0_IRQ = 23, I2C1_IRQ = 24, NUM_IRQS = 32 };
+#define PICO_DEFAULT_IRQ_PRIORITY 0x80
+
+typedef void (*irq_handler_t)(void);
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_set_priority(uint num, uint8_t priority);
+void irq_set_enabled(uint num, bool enabled);
+
+#endif // FALSO_HARDWARE_IRQ_H
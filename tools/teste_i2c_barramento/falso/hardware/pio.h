@@ -0,0 +1,78 @@
+/* Subconjunto do hardware/pio.h usado por lib/i2c_barramento.c e por i2c_mestre.pio.h */
+#ifndef FALSO_HARDWARE_PIO_H
+#define FALSO_HARDWARE_PIO_H
+
+#include "pico/stdlib.h"
+
+typedef struct pio_hw pio_hw_t;
+typedef pio_hw_t *PIO;
+extern pio_hw_t pio0_hw_, pio1_hw_;
+#define pio0 (&pio0_hw_)
+#define pio1 (&pio1_hw_)
+
+enum pio_interrupt_source {
+    pis_sm0_rx_fifo_not_empty = 0,
+    pis_sm0_tx_fifo_not_full = 4,
+    pis_interrupt0 = 8,
+};
+
+typedef struct {
+    uint wrap_target, wrap;
+    uint sideset_bits;           // Inclui o bit de habilitação quando opcional
+    bool sideset_opcional, sideset_pindirs;
+    uint sideset_base, out_base, out_count, set_base, set_count, in_base, jmp_pin;
+    bool out_shift_direita, autopull, in_shift_direita, autopush;
+    uint limite_pull, limite_push;
+    float clkdiv;
+} pio_sm_config;
+
+struct pio_program {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+    uint8_t pio_version;
+};
+typedef struct pio_program pio_program_t;
+
+static inline uint pio_encode_jmp(uint addr) { return addr; }
+static inline uint pio_encode_irq_set(bool relative, uint irq) { return 0xc000u | (relative ? 0x10u : 0) | irq; }
+
+uint pio_get_index(PIO pio);
+bool pio_can_add_program(PIO pio, const pio_program_t *program);
+uint pio_add_program(PIO pio, const pio_program_t *program);
+bool pio_sm_is_claimed(PIO pio, uint sm);
+void pio_sm_claim(PIO pio, uint sm);
+void pio_gpio_init(PIO pio, uint pin);
+
+pio_sm_config pio_get_default_sm_config(void);
+void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap);
+void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs);
+void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base);
+void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count);
+void sm_config_set_set_pins(pio_sm_config *c, uint set_base, uint set_count);
+void sm_config_set_in_pins(pio_sm_config *c, uint in_base);
+void sm_config_set_jmp_pin(pio_sm_config *c, uint pin);
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold);
+void sm_config_set_in_shift(pio_sm_config *c, bool shift_right, bool autopush, uint push_threshold);
+void sm_config_set_clkdiv(pio_sm_config *c, float div);
+
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div);
+void pio_sm_set_pins_with_mask(PIO pio, uint sm, uint32_t valores, uint32_t mascara);
+void pio_sm_set_pindirs_with_mask(PIO pio, uint sm, uint32_t direcoes, uint32_t mascara);
+void pio_sm_clear_fifos(PIO pio, uint sm);
+void pio_sm_restart(PIO pio, uint sm);
+void pio_sm_exec(PIO pio, uint sm, uint instr);
+void pio_sm_drain_tx_fifo(PIO pio, uint sm);
+bool pio_sm_is_tx_fifo_full(PIO pio, uint sm);
+bool pio_sm_is_rx_fifo_empty(PIO pio, uint sm);
+void pio_sm_put(PIO pio, uint sm, uint32_t dado);
+uint32_t pio_sm_get(PIO pio, uint sm);
+
+bool pio_interrupt_get(PIO pio, uint irq);
+void pio_interrupt_clear(PIO pio, uint irq);
+void pio_set_irq0_source_enabled(PIO pio, enum pio_interrupt_source fonte, bool habilitar);
+void pio_set_irq0_source_mask_enabled(PIO pio, uint32_t fontes, bool habilitar);
+
+#endif // FALSO_HARDWARE_PIO_H
@@ -0,0 +1,11 @@
+#ifndef FALSO_HARDWARE_SYNC_H
+#define FALSO_HARDWARE_SYNC_H
+
+#include <stdint.h>
+
+// Nada interrompe o código fora de um passo do barramento; restore_interrupts
+// só entrega ao controlador o que foi escrito nos registradores
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t estado);
+
+#endif // FALSO_HARDWARE_SYNC_H
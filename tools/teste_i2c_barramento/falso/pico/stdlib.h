@@ -0,0 +1,20 @@
+/* Subconjunto do pico/stdlib.h usado por lib/i2c_barramento.c, sobre o relógio do barramento falso */
+#ifndef FALSO_PICO_STDLIB_H
+#define FALSO_PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hardware/gpio.h"
+
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t cb, void *user_data, bool fire_if_past);
+bool cancel_alarm(alarm_id_t id);
+void busy_wait_us_32(uint32_t us);
+
+// Cada volta de uma espera ativa é um passo do barramento falso
+void tight_loop_contents(void);
+
+#endif // FALSO_PICO_STDLIB_H
@@ -0,0 +1,544 @@
+/* PIO falso: executa as palavras de instrução de verdade, ciclo a ciclo,
+ * para que o programa de lib/generated/i2c_mestre.pio.h seja testado como
+ * o RP2040 o roda. Cobre o que o programa e lib/i2c_barramento.c usam:
+ * todas as instruções, side-set opcional em pindirs, delay, autopull e
+ * autopush, FIFOs de 4 palavras, as 8 flags de IRQ (com índice relativo),
+ * OUT EXEC e pio_sm_exec, wrap e a fonte 0 de interrupção do bloco.
+ *
+ * Os pinos de cada bloco são um registrador de saídas e um de direções; o
+ * nível da linha (dreno aberto, override de OE e o escravo) sai de
+ * gpio_get() em barramento_falso.c. A memória de instruções sobrevive a
+ * falso_reiniciar(), como o offset guardado por lib/i2c_barramento.c. */
+
+#include <string.h>
+#include "hardware/pio.h"
+#include "hardware/gpio.h"
+#include "hardware/clocks.h"
+#include "barramento_falso.h"
+
+#define NUM_SMS 4
+#define TAM_FIFO 4
+#define TAM_MEMORIA 32
+#define NUM_GPIOS 30             // GPIO 30 e 31 não existem: o PIO lê 0 neles
+
+typedef struct {
+    pio_sm_config cfg;
+    bool habilitada, reservada;
+    uint8_t pc;
+    uint32_t x, y, osr, isr;
+    uint8_t osr_n, isr_n;        // Bits já deslocados (OSR vazio: osr_n = 32)
+    uint32_t tx[TAM_FIFO], rx[TAM_FIFO];
+    uint8_t tx_inicio, tx_n, rx_inicio, rx_n;
+    uint8_t atraso;              // Ciclos de delay que faltam
+    bool tem_exec;               // Instrução de OUT/MOV EXEC ou de pio_sm_exec ainda por executar
+    uint16_t instr_exec;
+    bool esperando_irq;          // IRQ WAIT já levantou a flag
+    bool empurrar_pendente;      // IN com autopush parado na FIFO de RX cheia
+    float divisor, ciclos;       // Ciclos fracionários acumulados
+} maquina_t;
+
+struct pio_hw {
+    uint8_t indice;
+    uint16_t memoria[TAM_MEMORIA];
+    uint32_t usada;
+    maquina_t sm[NUM_SMS];
+    uint8_t flags;               // IRQ 0 a 7
+    uint32_t inte0;
+    uint32_t saidas, direcoes;
+};
+
+pio_hw_t pio0_hw_ = { .indice = 0 }, pio1_hw_ = { .indice = 1 };
+
+// --- Funções Internas ---
+
+static uint32_t mascara(uint n) {
+    return n >= 32 ? 0xFFFFFFFFu : (1u << n) - 1;
+}
+
+static bool tx_vazia(const maquina_t *sm) { return sm->tx_n == 0; }
+static bool rx_cheia(const maquina_t *sm) { return sm->rx_n == TAM_FIFO; }
+
+static uint32_t tirar_tx(maquina_t *sm) {
+    uint32_t dado = sm->tx[sm->tx_inicio];
+    sm->tx_inicio = (sm->tx_inicio + 1) % TAM_FIFO;
+    sm->tx_n--;
+    return dado;
+}
+
+static void por_rx(maquina_t *sm, uint32_t dado) {
+    sm->rx[(sm->rx_inicio + sm->rx_n++) % TAM_FIFO] = dado;
+}
+
+static void escrever_pinos(uint32_t *registrador, uint base, uint n, uint32_t valor) {
+    for (uint i = 0; i < n; i++) {
+        uint pino = (base + i) % 32;
+        *registrador = (*registrador & ~(1u << pino)) | (((valor >> i) & 1u) << pino);
+    }
+}
+
+static uint32_t ler_pinos(uint base, uint n) {
+    uint32_t valor = 0;
+    for (uint i = 0; i < n; i++) {
+        uint pino = (base + i) % 32;
+        if (pino < NUM_GPIOS) valor |= (uint32_t)gpio_get(pino) << i;
+    }
+    return valor;
+}
+
+// Índice da flag de IRQ, somando o número da SM aos dois bits baixos quando relativo
+static uint indice_irq(uint campo, uint sm) {
+    return (campo & 0x10) ? (campo & 4) | ((campo + sm) & 3) : campo & 7;
+}
+
+static void aplicar_side_set(pio_hw_t *pio, const maquina_t *sm, uint16_t instr) {
+    uint bits = sm->cfg.sideset_bits;
+    if (bits == 0) return;
+    uint campo = (instr >> 8) & 0x1f;
+    if (sm->cfg.sideset_opcional && !(campo & 0x10)) return;
+    uint bits_valor = bits - (sm->cfg.sideset_opcional ? 1 : 0);
+    uint32_t valor = (campo >> (5 - bits)) & mascara(bits_valor);
+    escrever_pinos(sm->cfg.sideset_pindirs ? &pio->direcoes : &pio->saidas, sm->cfg.sideset_base, bits_valor, valor);
+}
+
+static uint atraso_instr(const maquina_t *sm, uint16_t instr) {
+    return ((instr >> 8) & 0x1f) & mascara(5 - sm->cfg.sideset_bits);
+}
+
+static bool puxar(maquina_t *sm) {
+    if (tx_vazia(sm)) return false;
+    sm->osr = tirar_tx(sm);
+    sm->osr_n = 0;
+    return true;
+}
+
+static uint32_t ler_fonte_mov(maquina_t *sm, uint fonte) {
+    switch (fonte) {
+    case 0: return ler_pinos(sm->cfg.in_base, 32);
+    case 1: return sm->x;
+    case 2: return sm->y;
+    case 5: return tx_vazia(sm) ? 0xFFFFFFFFu : 0;   // STATUS com o padrão do SDK (TX abaixo de 1)
+    case 6: return sm->isr;
+    case 7: return sm->osr;
+    default: return 0;
+    }
+}
+
+// Executa uma instrução; false se a SM ficou parada nela
+static bool executar(pio_hw_t *pio, uint indice, uint16_t instr, bool *desviou) {
+    maquina_t *sm = &pio->sm[indice];
+    uint op = instr >> 13, arg1 = (instr >> 5) & 7, arg2 = instr & 0x1f;
+    uint n = arg2 ? arg2 : 32;
+    *desviou = false;
+
+    switch (op) {
+    case 0: {   // JMP
+        bool salta = false;
+        switch (arg1) {
+        case 0: salta = true; break;
+        case 1: salta = sm->x == 0; break;
+        case 2: salta = sm->x-- != 0; break;
+        case 3: salta = sm->y == 0; break;
+        case 4: salta = sm->y-- != 0; break;
+        case 5: salta = sm->x != sm->y; break;
+        case 6: salta = ler_pinos(sm->cfg.jmp_pin, 1); break;
+        case 7: salta = sm->osr_n < (sm->cfg.limite_pull ? sm->cfg.limite_pull : 32); break;
+        }
+        if (salta) {
+            sm->pc = arg2;
+            *desviou = true;
+        }
+        return true;
+    }
+    case 1: {   // WAIT
+        bool polaridade = instr & 0x80, nivel;
+        switch (arg1 & 3) {
+        case 0: nivel = ler_pinos(arg2, 1); break;
+        case 1: nivel = ler_pinos(sm->cfg.in_base + arg2, 1); break;
+        case 2: {
+            uint flag = indice_irq(arg2, indice);
+            nivel = (pio->flags >> flag) & 1;
+            if (polaridade && nivel) pio->flags &= ~(1u << flag);
+            break;
+        }
+        default: nivel = polaridade; break;
+        }
+        return nivel == polaridade;
+    }
+    case 2: {   // IN
+        if (sm->empurrar_pendente) {
+            if (rx_cheia(sm)) return false;
+            por_rx(sm, sm->isr);
+            sm->isr = 0;
+            sm->isr_n = 0;
+            sm->empurrar_pendente = false;
+            return true;
+        }
+        uint32_t dado;
+        switch (arg1) {
+        case 0: dado = ler_pinos(sm->cfg.in_base, n); break;
+        case 1: dado = sm->x; break;
+        case 2: dado = sm->y; break;
+        case 6: dado = sm->isr; break;
+        case 7: dado = sm->osr; break;
+        default: dado = 0; break;
+        }
+        dado &= mascara(n);
+        if (sm->cfg.in_shift_direita) {
+            sm->isr = (n == 32 ? 0 : sm->isr >> n) | (n == 32 ? dado : dado << (32 - n));
+        } else {
+            sm->isr = (n == 32 ? 0 : sm->isr << n) | dado;
+        }
+        sm->isr_n = sm->isr_n + n > 32 ? 32 : sm->isr_n + n;
+        if (sm->cfg.autopush && sm->isr_n >= (sm->cfg.limite_push ? sm->cfg.limite_push : 32)) {
+            if (rx_cheia(sm)) {
+                sm->empurrar_pendente = true;
+                return false;
+            }
+            por_rx(sm, sm->isr);
+            sm->isr = 0;
+            sm->isr_n = 0;
+        }
+        return true;
+    }
+    case 3: {   // OUT
+        if (sm->cfg.autopull && sm->osr_n >= (sm->cfg.limite_pull ? sm->cfg.limite_pull : 32) && !puxar(sm)) {
+            return false;
+        }
+        uint32_t dado;
+        if (sm->cfg.out_shift_direita) {
+            dado = sm->osr & mascara(n);
+            sm->osr = n == 32 ? 0 : sm->osr >> n;
+        } else {
+            dado = n == 32 ? sm->osr : sm->osr >> (32 - n);
+            sm->osr = n == 32 ? 0 : sm->osr << n;
+        }
+        sm->osr_n = sm->osr_n + n > 32 ? 32 : sm->osr_n + n;
+        switch (arg1) {
+        case 0: escrever_pinos(&pio->saidas, sm->cfg.out_base, sm->cfg.out_count < n ? sm->cfg.out_count : n, dado); break;
+        case 1: sm->x = dado; break;
+        case 2: sm->y = dado; break;
+        case 4: escrever_pinos(&pio->direcoes, sm->cfg.out_base, sm->cfg.out_count < n ? sm->cfg.out_count : n, dado); break;
+        case 5: sm->pc = dado % TAM_MEMORIA; *desviou = true; break;
+        case 6: sm->isr = dado; sm->isr_n = n; break;
+        case 7: sm->tem_exec = true; sm->instr_exec = (uint16_t)dado; break;
+        default: break;
+        }
+        return true;
+    }
+    case 4: {   // PUSH / PULL
+        bool bloqueia = instr & 0x20, condicional = instr & 0x40;
+        if (instr & 0x80) {
+            if (condicional && sm->osr_n < (sm->cfg.limite_pull ? sm->cfg.limite_pull : 32)) return true;
+            if (puxar(sm)) return true;
+            if (bloqueia) return false;
+            sm->osr = sm->x;   // PULL noblock com a FIFO vazia copia X
+            sm->osr_n = 0;
+            return true;
+        }
+        if (condicional && sm->isr_n < (sm->cfg.limite_push ? sm->cfg.limite_push : 32)) return true;
+        if (rx_cheia(sm)) return !bloqueia;
+        por_rx(sm, sm->isr);
+        sm->isr = 0;
+        sm->isr_n = 0;
+        return true;
+    }
+    case 5: {   // MOV
+        uint32_t dado = ler_fonte_mov(sm, arg2 & 7);
+        uint operacao = (arg2 >> 3) & 3;
+        if (operacao == 1) {
+            dado = ~dado;
+        } else if (operacao == 2) {
+            uint32_t invertido = 0;
+            for (int i = 0; i < 32; i++) invertido |= ((dado >> i) & 1u) << (31 - i);
+            dado = invertido;
+        }
+        switch (arg1) {
+        case 0: escrever_pinos(&pio->saidas, sm->cfg.out_base, sm->cfg.out_count, dado); break;
+        case 1: sm->x = dado; break;
+        case 2: sm->y = dado; break;
+        case 4: sm->tem_exec = true; sm->instr_exec = (uint16_t)dado; break;
+        case 5: sm->pc = dado % TAM_MEMORIA; *desviou = true; break;
+        case 6: sm->isr = dado; sm->isr_n = 0; break;
+        case 7: sm->osr = dado; sm->osr_n = 0; break;
+        default: break;
+        }
+        return true;
+    }
+    case 6: {   // IRQ
+        uint flag = indice_irq(arg2, indice);
+        if (instr & 0x40) {
+            pio->flags &= ~(1u << flag);
+            return true;
+        }
+        if (!sm->esperando_irq) {
+            pio->flags |= 1u << flag;
+            if (!(instr & 0x20)) return true;
+            sm->esperando_irq = true;
+            return false;
+        }
+        if (pio->flags & (1u << flag)) return false;
+        sm->esperando_irq = false;
+        return true;
+    }
+    default: {  // SET
+        switch (arg1) {
+        case 0: escrever_pinos(&pio->saidas, sm->cfg.set_base, sm->cfg.set_count, arg2); break;
+        case 1: sm->x = arg2; break;
+        case 2: sm->y = arg2; break;
+        case 4: escrever_pinos(&pio->direcoes, sm->cfg.set_base, sm->cfg.set_count, arg2); break;
+        default: break;
+        }
+        return true;
+    }
+    }
+}
+
+// OUT EXEC e MOV EXEC ignoram o próprio delay; a instrução executada usa o dela
+static bool eh_exec(uint16_t instr) {
+    uint op = instr >> 13, destino = (instr >> 5) & 7;
+    return (op == 3 && destino == 7) || (op == 5 && destino == 4);
+}
+
+// Um ciclo do clock da SM
+static void ciclo(pio_hw_t *pio, uint indice) {
+    maquina_t *sm = &pio->sm[indice];
+    if (sm->atraso) {
+        sm->atraso--;
+        return;
+    }
+    bool de_exec = sm->tem_exec;
+    uint16_t instr = de_exec ? sm->instr_exec : pio->memoria[sm->pc];
+    sm->tem_exec = false;
+
+    // O side-set vale já no primeiro ciclo, mesmo que a instrução fique parada
+    aplicar_side_set(pio, sm, instr);
+    bool desviou;
+    if (!executar(pio, indice, instr, &desviou)) {
+        if (de_exec) {
+            sm->tem_exec = true;
+            sm->instr_exec = instr;
+        }
+        return;
+    }
+    if (!eh_exec(instr)) sm->atraso = atraso_instr(sm, instr);
+    if (!desviou && !de_exec) sm->pc = sm->pc == sm->cfg.wrap ? sm->cfg.wrap_target : (sm->pc + 1u) % TAM_MEMORIA;
+}
+
+static uint32_t fontes_ativas(const pio_hw_t *pio) {
+    uint32_t bruto = (uint32_t)(pio->flags & 0x0f) << pis_interrupt0;
+    for (uint i = 0; i < NUM_SMS; i++) {
+        if (pio->sm[i].rx_n > 0) bruto |= 1u << (pis_sm0_rx_fifo_not_empty + i);
+        if (pio->sm[i].tx_n < TAM_FIFO) bruto |= 1u << (pis_sm0_tx_fifo_not_full + i);
+    }
+    return bruto & pio->inte0;
+}
+
+// --- Lado do teste (barramento_falso.h) ---
+
+uint32_t falso_pio_saidas(unsigned bloco) {
+    return bloco ? pio1_hw_.saidas : pio0_hw_.saidas;
+}
+
+uint32_t falso_pio_direcoes(unsigned bloco) {
+    return bloco ? pio1_hw_.direcoes : pio0_hw_.direcoes;
+}
+
+bool falso_pio_irq_pendente(unsigned bloco) {
+    return fontes_ativas(bloco ? &pio1_hw_ : &pio0_hw_) != 0;
+}
+
+void falso_pio_avancar_us(uint32_t us) {
+    float ciclos_por_us = clock_get_hz(clk_sys) / 1e6f;
+    pio_hw_t *blocos[2] = { &pio0_hw_, &pio1_hw_ };
+    for (int b = 0; b < 2; b++) {
+        for (uint i = 0; i < NUM_SMS; i++) {
+            maquina_t *sm = &blocos[b]->sm[i];
+            if (!sm->habilitada) continue;
+            sm->ciclos += us * ciclos_por_us / sm->divisor;
+            for (; sm->ciclos >= 1.0f; sm->ciclos -= 1.0f) {
+                ciclo(blocos[b], i);
+                falso_linhas_mudaram();
+            }
+        }
+    }
+}
+
+void falso_pio_reiniciar(void) {
+    pio_hw_t *blocos[2] = { &pio0_hw_, &pio1_hw_ };
+    for (int b = 0; b < 2; b++) {
+        memset(blocos[b]->sm, 0, sizeof(blocos[b]->sm));
+        blocos[b]->flags = 0;
+        blocos[b]->inte0 = 0;
+        blocos[b]->saidas = 0;
+        blocos[b]->direcoes = 0;
+    }
+}
+
+// --- SDK ---
+
+uint pio_get_index(PIO pio) { return pio->indice; }
+
+static int offset_livre(PIO pio, const pio_program_t *program) {
+    uint32_t ocupa = mascara(program->length);
+    if (program->origin >= 0) return (pio->usada & (ocupa << program->origin)) ? -1 : program->origin;
+    for (int offset = TAM_MEMORIA - program->length; offset >= 0; offset--) {
+        if (!(pio->usada & (ocupa << offset))) return offset;
+    }
+    return -1;
+}
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program) {
+    return offset_livre(pio, program) >= 0;
+}
+
+// Como o SDK: do fim da memória para o começo, somando o offset aos destinos dos JMP
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    int offset = offset_livre(pio, program);
+    for (uint i = 0; i < program->length; i++) {
+        uint16_t instr = program->instructions[i];
+        pio->memoria[offset + i] = (instr & 0xe000) == 0 ? instr + offset : instr;
+    }
+    pio->usada |= mascara(program->length) << offset;
+    return (uint)offset;
+}
+
+bool pio_sm_is_claimed(PIO pio, uint sm) { return pio->sm[sm].reservada; }
+void pio_sm_claim(PIO pio, uint sm) { pio->sm[sm].reservada = true; }
+
+void pio_gpio_init(PIO pio, uint pin) {
+    gpio_set_function(pin, pio->indice ? GPIO_FUNC_PIO1 : GPIO_FUNC_PIO0);
+}
+
+pio_sm_config pio_get_default_sm_config(void) {
+    return (pio_sm_config){ .wrap = TAM_MEMORIA - 1, .out_count = 32, .out_shift_direita = true,
+                            .in_shift_direita = true, .clkdiv = 1.0f };
+}
+
+void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap) {
+    c->wrap_target = wrap_target;
+    c->wrap = wrap;
+}
+
+void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs) {
+    c->sideset_bits = bit_count;
+    c->sideset_opcional = optional;
+    c->sideset_pindirs = pindirs;
+}
+
+void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base) { c->sideset_base = sideset_base; }
+
+void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count) {
+    c->out_base = out_base;
+    c->out_count = out_count;
+}
+
+void sm_config_set_set_pins(pio_sm_config *c, uint set_base, uint set_count) {
+    c->set_base = set_base;
+    c->set_count = set_count;
+}
+
+void sm_config_set_in_pins(pio_sm_config *c, uint in_base) { c->in_base = in_base; }
+void sm_config_set_jmp_pin(pio_sm_config *c, uint pin) { c->jmp_pin = pin; }
+
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold) {
+    c->out_shift_direita = shift_right;
+    c->autopull = autopull;
+    c->limite_pull = pull_threshold & 31;   // 32 é gravado como 0
+}
+
+void sm_config_set_in_shift(pio_sm_config *c, bool shift_right, bool autopush, uint push_threshold) {
+    c->in_shift_direita = shift_right;
+    c->autopush = autopush;
+    c->limite_push = push_threshold & 31;
+}
+
+void sm_config_set_clkdiv(pio_sm_config *c, float div) { c->clkdiv = div; }
+
+void pio_sm_clear_fifos(PIO pio, uint sm) {
+    maquina_t *m = &pio->sm[sm];
+    m->tx_n = m->rx_n = 0;
+    m->tx_inicio = m->rx_inicio = 0;
+}
+
+void pio_sm_restart(PIO pio, uint sm) {
+    maquina_t *m = &pio->sm[sm];
+    m->isr_n = 0;
+    m->osr_n = 32;
+    m->atraso = 0;
+    m->tem_exec = false;
+    m->esperando_irq = false;
+    m->empurrar_pendente = false;
+}
+
+// A instrução roda na hora; se parar, a SM continua nela quando voltar a andar
+void pio_sm_exec(PIO pio, uint sm, uint instr) {
+    maquina_t *m = &pio->sm[sm];
+    m->tem_exec = false;
+    m->esperando_irq = false;
+    m->empurrar_pendente = false;
+    m->atraso = 0;
+    bool desviou;
+    if (!executar(pio, sm, (uint16_t)instr, &desviou)) {
+        m->tem_exec = true;
+        m->instr_exec = (uint16_t)instr;
+    }
+}
+
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
+    maquina_t *m = &pio->sm[sm];
+    m->habilitada = false;
+    m->cfg = *config;
+    m->divisor = config->clkdiv;
+    m->ciclos = 0;
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_jmp(initial_pc));
+    return 0;
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) { pio->sm[sm].habilitada = enabled; }
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div) { pio->sm[sm].divisor = div; }
+
+void pio_sm_set_pins_with_mask(PIO pio, uint sm, uint32_t valores, uint32_t mascara_pinos) {
+    pio->saidas = (pio->saidas & ~mascara_pinos) | (valores & mascara_pinos);
+}
+
+void pio_sm_set_pindirs_with_mask(PIO pio, uint sm, uint32_t direcoes, uint32_t mascara_pinos) {
+    pio->direcoes = (pio->direcoes & ~mascara_pinos) | (direcoes & mascara_pinos);
+}
+
+// Como o SDK: com autopull, "out null, 32" até a FIFO esvaziar; senão "pull noblock"
+void pio_sm_drain_tx_fifo(PIO pio, uint sm) {
+    uint instr = pio->sm[sm].cfg.autopull ? 0x6060u : 0x8080u;
+    while (!tx_vazia(&pio->sm[sm])) pio_sm_exec(pio, sm, instr);
+}
+
+bool pio_sm_is_tx_fifo_full(PIO pio, uint sm) { return pio->sm[sm].tx_n == TAM_FIFO; }
+bool pio_sm_is_rx_fifo_empty(PIO pio, uint sm) { return pio->sm[sm].rx_n == 0; }
+
+// Como no RP2040, escrever na FIFO cheia não tem efeito
+void pio_sm_put(PIO pio, uint sm, uint32_t dado) {
+    maquina_t *m = &pio->sm[sm];
+    if (m->tx_n == TAM_FIFO) return;
+    m->tx[(m->tx_inicio + m->tx_n++) % TAM_FIFO] = dado;
+}
+
+uint32_t pio_sm_get(PIO pio, uint sm) {
+    maquina_t *m = &pio->sm[sm];
+    if (m->rx_n == 0) return 0;
+    uint32_t dado = m->rx[m->rx_inicio];
+    m->rx_inicio = (m->rx_inicio + 1) % TAM_FIFO;
+    m->rx_n--;
+    return dado;
+}
+
+bool pio_interrupt_get(PIO pio, uint irq) { return (pio->flags >> irq) & 1; }
+void pio_interrupt_clear(PIO pio, uint irq) { pio->flags &= ~(1u << irq); }
+
+void pio_set_irq0_source_enabled(PIO pio, enum pio_interrupt_source fonte, bool habilitar) {
+    pio_set_irq0_source_mask_enabled(pio, 1u << fonte, habilitar);
+}
+
+void pio_set_irq0_source_mask_enabled(PIO pio, uint32_t fontes, bool habilitar) {
+    pio->inte0 = habilitar ? pio->inte0 | fontes : pio->inte0 & ~fontes;
+}
@@ -0,0 +1,300 @@
+/* Passa a fila de transações de lib/i2c_barramento.c por um bloco I2C falso
+ * e injeta as falhas que ela precisa tratar: NACK no endereço e nos dados,
+ * SDA presa pelo escravo (prazo estourado e recuperação por pulsos de SCL),
+ * prazo estourado no meio de uma leitura, fila cheia e nenhum alarme livre
+ * para o prazo. Os casos "PIO" rodam o programa de
+ * lib/generated/i2c_mestre.pio.h num PIO falso, contra o mesmo escravo
+ * acionado bit a bit pelas linhas.
+ *
+ * Uso: teste_i2c_barramento
+ *
+ * Cada caso imprime ok ou as verificações que falharam; o código de saída
+ * é 1 se alguma falhar. */
+
+#include <stdio.h>
+#include <string.h>
+#include "i2c_barramento.h"
+#include "barramento_falso.h"
+#include "hardware/pio.h"
+
+#define BAUDRATE 100000
+
+static int falhas_caso;
+
+#define CHECAR(cond) do { \
+        if (!(cond)) { \
+            printf("\n    linha %d: %s", __LINE__, #cond); \
+            falhas_caso++; \
+        } \
+    } while (0)
+
+static i2c_barramento_t bar, bar_pio;
+
+// --- Funções Internas ---
+
+static void preparar(void) {
+    falso_reiniciar();
+    i2c_barramento_init(&bar, i2c0, FALSO_SDA, FALSO_SCL, BAUDRATE);
+}
+
+static i2c_status_t ler_registrador(uint8_t endereco, uint8_t reg, uint8_t *destino, uint16_t n) {
+    return i2c_barramento_transferir(&bar, endereco, 0, &reg, 1, destino, n);
+}
+
+// O mesmo escravo nos pinos do PIO0 (SCL = SDA + 1); o bloco I2C fica parado
+static bool preparar_pio(void) {
+    return i2c_barramento_init_pio(&bar_pio, pio0, FALSO_SDA, BAUDRATE);
+}
+
+// Nem a flag de NAK da SM nem a de fim ficaram levantadas, e SDA nunca
+// trocou no mesmo ciclo que SCL
+static bool pio_limpo(void) {
+    return !pio_interrupt_get(pio0, bar_pio.sm) && !pio_interrupt_get(pio0, (bar_pio.sm + 2) & 3) &&
+           falso_escravo.corridas == 0;
+}
+
+// Prazo calculado pela fila quando o descritor não define um
+static uint64_t prazo_padrao_us(uint16_t comandos) {
+    return I2C_TIMEOUT_MARGEM_US + (uint64_t)comandos * 18 * 1000000 / BAUDRATE;
+}
+
+// --- Casos ---
+
+static void caso_escrita_e_leitura(void) {
+    uint8_t lido[4] = {0};
+    CHECAR(ler_registrador(FALSO_ENDERECO, 4, lido, 4) == I2C_TRANSACAO_OK);
+    CHECAR(lido[0] == 0x14 && lido[3] == 0x17);
+
+    const uint8_t escrita[] = { 2, 0xAA, 0xBB };
+    CHECAR(i2c_barramento_transferir(&bar, FALSO_ENDERECO, 0, escrita, 3, NULL, 0) == I2C_TRANSACAO_OK);
+    CHECAR(falso_escravo.memoria[2] == 0xAA && falso_escravo.memoria[3] == 0xBB);
+    CHECAR(bar.total_ok == 2 && bar.total_nack == 0);
+    CHECAR(falso_escravo.starts == 3 && falso_escravo.stops == 2);   // START + RESTART na leitura
+    CHECAR(!i2c_barramento_ocupado(&bar));
+}
+
+static void caso_nack_endereco(void) {
+    uint8_t lido[2];
+    CHECAR(ler_registrador(FALSO_ENDERECO + 1, 0, lido, 2) == I2C_TRANSACAO_NACK);
+    CHECAR(bar.total_nack == 1);
+    // O abort não deixa a fila nem o controlador presos
+    CHECAR(ler_registrador(FALSO_ENDERECO, 0, lido, 2) == I2C_TRANSACAO_OK);
+    CHECAR(lido[0] == 0x10 && lido[1] == 0x11);
+}
+
+static void caso_nack_dado(void) {
+    falso_escravo.nack_no_byte = 2;
+    const uint8_t escrita[] = { 0, 0x01, 0x02, 0x03 };
+    CHECAR(i2c_barramento_transferir(&bar, FALSO_ENDERECO, 0, escrita, 4, NULL, 0) == I2C_TRANSACAO_NACK);
+    CHECAR(falso_escravo.memoria[0] == 0x01 && falso_escravo.memoria[1] == 0x11);
+    falso_escravo.nack_no_byte = -1;
+    uint8_t lido;
+    CHECAR(ler_registrador(FALSO_ENDERECO, 0, &lido, 1) == I2C_TRANSACAO_OK && lido == 0x01);
+}
+
+static void caso_sda_presa(void) {
+    CHECAR(falso_escravo.pulsos_scl == 0);   // A recuperação do init não pulsou com SDA solta
+    falso_prender_sda(5);
+    uint64_t inicio = falso_agora_us();
+    uint8_t lido[2];
+    CHECAR(ler_registrador(FALSO_ENDERECO, 0, lido, 2) == I2C_TRANSACAO_TIMEOUT);
+    uint64_t decorrido = falso_agora_us() - inicio;
+    CHECAR(decorrido >= prazo_padrao_us(3) && decorrido < prazo_padrao_us(3) + 1000);
+    CHECAR(bar.total_timeout == 1 && bar.total_recuperacoes == 1);
+    CHECAR(falso_escravo.pulsos_scl == 5 && falso_escravo.sda_presa == 0);
+    CHECAR(ler_registrador(FALSO_ENDERECO, 0, lido, 2) == I2C_TRANSACAO_OK);
+}
+
+static void caso_prazo_no_meio_da_leitura(void) {
+    falso_escravo.prender_apos_leitura = 3;
+    falso_escravo.pulsos_para_soltar = 9;
+    uint8_t reg1 = 0, reg2 = 8, lido1[8] = {0}, lido2[2] = {0};
+    i2c_transacao_t t1 = { .endereco = FALSO_ENDERECO, .escrita = &reg1, .tam_escrita = 1, .leitura = lido1, .tam_leitura = 8 };
+    i2c_transacao_t t2 = { .endereco = FALSO_ENDERECO, .escrita = &reg2, .tam_escrita = 1, .leitura = lido2, .tam_leitura = 2 };
+    CHECAR(i2c_barramento_enfileirar(&bar, &t1) && i2c_barramento_enfileirar(&bar, &t2));
+
+    // A segunda transação, já na fila, roda depois da recuperação
+    CHECAR(i2c_barramento_aguardar(&t2) == I2C_TRANSACAO_OK);
+    CHECAR(t1.status == I2C_TRANSACAO_TIMEOUT);
+    CHECAR(lido1[0] == 0x10 && lido1[2] == 0x12 && lido1[3] == 0);   // Só o que chegou antes do travamento
+    CHECAR(lido2[0] == 0x18 && lido2[1] == 0x19);
+    CHECAR(falso_escravo.pulsos_scl == 9 && bar.total_recuperacoes == 1);
+    CHECAR(bar.total_timeout == 1 && bar.total_ok == 1);
+}
+
+static void caso_prazo_do_descritor(void) {
+    falso_prender_sda(3);
+    uint8_t reg = 0, lido;
+    i2c_transacao_t t = { .endereco = FALSO_ENDERECO, .escrita = &reg, .tam_escrita = 1, .leitura = &lido,
+                          .tam_leitura = 1, .timeout_us = 2000 };
+    uint64_t inicio = falso_agora_us();
+    CHECAR(i2c_barramento_enfileirar(&bar, &t));
+    CHECAR(i2c_barramento_aguardar(&t) == I2C_TRANSACAO_TIMEOUT);
+    uint64_t decorrido = falso_agora_us() - inicio;
+    CHECAR(decorrido >= 2000 && decorrido < 2200);
+}
+
+static int ordem[I2C_FILA_TAM + 2], concluidas;
+
+static void anotar_conclusao(i2c_transacao_t *t) {
+    ordem[concluidas++] = (int)(intptr_t)t->contexto;
+}
+
+static void caso_fila_cheia(void) {
+    // Uma em andamento mais I2C_FILA_TAM esperando; a seguinte não cabe
+    static uint8_t reg[I2C_FILA_TAM + 2], lido[I2C_FILA_TAM + 2];
+    static i2c_transacao_t t[I2C_FILA_TAM + 2];
+    concluidas = 0;
+    for (int i = 0; i < I2C_FILA_TAM + 2; i++) {
+        reg[i] = (uint8_t)i;
+        t[i] = (i2c_transacao_t){ .endereco = FALSO_ENDERECO, .escrita = &reg[i], .tam_escrita = 1,
+                                  .leitura = &lido[i], .tam_leitura = 1, .callback = anotar_conclusao,
+                                  .contexto = (void *)(intptr_t)i };
+        bool aceita = i2c_barramento_enfileirar(&bar, &t[i]);
+        CHECAR(aceita == (i <= I2C_FILA_TAM));
+    }
+    CHECAR(t[I2C_FILA_TAM + 1].status == I2C_TRANSACAO_FILA_CHEIA);
+
+    CHECAR(i2c_barramento_aguardar(&t[I2C_FILA_TAM]) == I2C_TRANSACAO_OK);
+    CHECAR(concluidas == I2C_FILA_TAM + 1 && !i2c_barramento_ocupado(&bar));
+    for (int i = 0; i < concluidas; i++) {
+        CHECAR(ordem[i] == i && t[i].status == I2C_TRANSACAO_OK && lido[i] == 0x10 + i);
+    }
+    // Cabe de novo depois de esvaziar
+    CHECAR(i2c_barramento_enfileirar(&bar, &t[I2C_FILA_TAM + 1]));
+    CHECAR(i2c_barramento_aguardar(&t[I2C_FILA_TAM + 1]) == I2C_TRANSACAO_OK);
+}
+
+static void caso_limite_de_velocidade(void) {
+    uint8_t reg = 0, lido;
+    i2c_barramento_limitar_baudrate(&bar, 100000);
+    CHECAR(i2c_barramento_transferir(&bar, FALSO_ENDERECO, 400000, &reg, 1, &lido, 1) == I2C_TRANSACAO_OK);
+    CHECAR(falso_baudrate_i2c(0) == 100000);
+    i2c_barramento_limitar_baudrate(&bar, 0);
+    CHECAR(i2c_barramento_transferir(&bar, FALSO_ENDERECO, 400000, &reg, 1, &lido, 1) == I2C_TRANSACAO_OK);
+    CHECAR(falso_baudrate_i2c(0) == 400000);
+}
+
+static void caso_sem_alarme(void) {
+    // Sem alarme para o prazo nada vai para o fio; a próxima, com alarme, passa
+    falso_recusar_alarmes(true);
+    uint8_t lido[2] = {0};
+    CHECAR(ler_registrador(FALSO_ENDERECO, 0, lido, 2) == I2C_TRANSACAO_SEM_ALARME);
+    CHECAR(falso_escravo.starts == 0 && !i2c_barramento_ocupado(&bar));
+    CHECAR(bar.total_ok == 0 && bar.total_nack == 0 && bar.total_timeout == 0);
+    falso_recusar_alarmes(false);
+    CHECAR(ler_registrador(FALSO_ENDERECO, 0, lido, 2) == I2C_TRANSACAO_OK);
+    CHECAR(lido[0] == 0x10 && lido[1] == 0x11);
+}
+
+static void caso_pio_escrita(void) {
+    CHECAR(preparar_pio());
+    const uint8_t escrita[] = { 2, 0xAA, 0xBB };
+    uint64_t inicio = falso_agora_us();
+    CHECAR(i2c_barramento_transferir(&bar_pio, FALSO_ENDERECO, 0, escrita, 3, NULL, 0) == I2C_TRANSACAO_OK);
+    // 4 bytes de 9 bits a 100 kHz, mais START e STOP e um passo de folga
+    uint64_t decorrido = falso_agora_us() - inicio;
+    CHECAR(decorrido >= 36 * 10 && decorrido < 36 * 10 + 200);
+    CHECAR(falso_escravo.memoria[2] == 0xAA && falso_escravo.memoria[3] == 0xBB && falso_escravo.memoria[4] == 0x14);
+    CHECAR(falso_escravo.starts == 1 && falso_escravo.stops == 1);
+    CHECAR(bar_pio.total_ok == 1 && pio_limpo() && !i2c_barramento_ocupado(&bar_pio));
+}
+
+static void caso_pio_restart(void) {
+    CHECAR(preparar_pio());
+    // Mais palavras e bytes lidos do que cabem nas FIFOs de 4 da SM
+    uint8_t reg = 0, lido[8] = {0};
+    CHECAR(i2c_barramento_transferir(&bar_pio, FALSO_ENDERECO, 0, &reg, 1, lido, 8) == I2C_TRANSACAO_OK);
+    for (int i = 0; i < 8; i++) CHECAR(lido[i] == 0x10 + i);
+    CHECAR(falso_escravo.starts == 2 && falso_escravo.stops == 1);   // START + RESTART
+    CHECAR(bar_pio.total_ok == 1 && pio_limpo());
+}
+
+static void caso_pio_so_leitura(void) {
+    CHECAR(preparar_pio());
+    uint8_t reg = 8, lido[3] = {0};
+    CHECAR(i2c_barramento_transferir(&bar_pio, FALSO_ENDERECO, 0, &reg, 1, NULL, 0) == I2C_TRANSACAO_OK);
+    CHECAR(i2c_barramento_transferir(&bar_pio, FALSO_ENDERECO, 0, NULL, 0, lido, 3) == I2C_TRANSACAO_OK);
+    CHECAR(lido[0] == 0x18 && lido[1] == 0x19 && lido[2] == 0x1A);
+    CHECAR(falso_escravo.starts == 2 && falso_escravo.stops == 2 && pio_limpo());
+}
+
+static void caso_pio_nack_endereco(void) {
+    CHECAR(preparar_pio());
+    uint8_t reg = 0, lido[2] = {0};
+    CHECAR(i2c_barramento_transferir(&bar_pio, FALSO_ENDERECO + 1, 0, &reg, 1, lido, 2) == I2C_TRANSACAO_NACK);
+    // O NAK para a SM na flag dela; a fila pula para o STOP, que levanta a flag de fim.
+    // Nenhum pulso além dos 9 do endereço e do que o STOP dá
+    CHECAR(falso_escravo.starts == 1 && falso_escravo.stops == 1 && falso_escravo.subidas_scl == 10);
+    CHECAR(bar_pio.total_nack == 1 && pio_limpo());
+    CHECAR(i2c_barramento_transferir(&bar_pio, FALSO_ENDERECO + 1, 0, NULL, 0, lido, 2) == I2C_TRANSACAO_NACK);
+    CHECAR(bar_pio.total_nack == 2 && falso_escravo.stops == 2);
+    // A SM volta ao ponto de entrada sem restos na FIFO nem no OSR
+    CHECAR(i2c_barramento_transferir(&bar_pio, FALSO_ENDERECO, 0, &reg, 1, lido, 2) == I2C_TRANSACAO_OK);
+    CHECAR(lido[0] == 0x10 && lido[1] == 0x11);
+    CHECAR(bar_pio.total_ok == 1 && pio_limpo());
+}
+
+static void caso_pio_nack_dado(void) {
+    CHECAR(preparar_pio());
+    falso_escravo.nack_no_byte = 2;
+    const uint8_t escrita[] = { 0, 0x01, 0x02, 0x03 };
+    CHECAR(i2c_barramento_transferir(&bar_pio, FALSO_ENDERECO, 0, escrita, 4, NULL, 0) == I2C_TRANSACAO_NACK);
+    CHECAR(falso_escravo.memoria[0] == 0x01 && falso_escravo.memoria[1] == 0x11);
+    CHECAR(falso_escravo.stops == 1 && falso_escravo.subidas_scl == 4 * 9 + 1 && pio_limpo());
+    falso_escravo.nack_no_byte = -1;
+    uint8_t reg = 0, lido = 0;
+    CHECAR(i2c_barramento_transferir(&bar_pio, FALSO_ENDERECO, 0, &reg, 1, &lido, 1) == I2C_TRANSACAO_OK && lido == 0x01);
+}
+
+static void caso_pio_sequencia(void) {
+    CHECAR(preparar_pio());
+    // Cada STOP inicia a próxima da fila de dentro da interrupção
+    uint8_t escrita[] = { 6, 0x66 }, reg = 5, lido1[2] = {0}, lido2[2] = {0};
+    i2c_transacao_t t[3] = {
+        { .endereco = FALSO_ENDERECO, .escrita = escrita, .tam_escrita = 2 },
+        { .endereco = FALSO_ENDERECO, .escrita = &reg, .tam_escrita = 1, .leitura = lido1, .tam_leitura = 2 },
+        { .endereco = FALSO_ENDERECO, .leitura = lido2, .tam_leitura = 2 },
+    };
+    for (int i = 0; i < 3; i++) CHECAR(i2c_barramento_enfileirar(&bar_pio, &t[i]));
+    CHECAR(i2c_barramento_aguardar(&t[2]) == I2C_TRANSACAO_OK);
+    CHECAR(t[0].status == I2C_TRANSACAO_OK && t[1].status == I2C_TRANSACAO_OK);
+    CHECAR(lido1[0] == 0x15 && lido1[1] == 0x66 && lido2[0] == 0x17 && lido2[1] == 0x18);
+    CHECAR(falso_escravo.starts == 4 && falso_escravo.stops == 3 && bar_pio.total_ok == 3 && pio_limpo());
+}
+
+static const struct {
+    const char *nome;
+    void (*executar)(void);
+} casos[] = {
+    { "Escrita e leitura",           caso_escrita_e_leitura },
+    { "NACK no endereco",            caso_nack_endereco },
+    { "NACK num dado",               caso_nack_dado },
+    { "SDA presa (recuperacao)",     caso_sda_presa },
+    { "Prazo no meio da leitura",    caso_prazo_no_meio_da_leitura },
+    { "Prazo do descritor",          caso_prazo_do_descritor },
+    { "Fila cheia",                  caso_fila_cheia },
+    { "Limite de velocidade",        caso_limite_de_velocidade },
+    { "Sem alarme livre",            caso_sem_alarme },
+    { "PIO: escrita",                caso_pio_escrita },
+    { "PIO: RESTART e leitura",      caso_pio_restart },
+    { "PIO: so leitura",             caso_pio_so_leitura },
+    { "PIO: NACK no endereco",       caso_pio_nack_endereco },
+    { "PIO: NACK num dado",          caso_pio_nack_dado },
+    { "PIO: transacoes em sequencia", caso_pio_sequencia },
+};
+
+// --- Programa ---
+
+int main(void) {
+    int falhas = 0;
+    for (size_t i = 0; i < sizeof(casos) / sizeof(casos[0]); i++) {
+        falhas_caso = 0;
+        printf("%-30s", casos[i].nome);
+        preparar();
+        casos[i].executar();
+        printf(falhas_caso ? "\n    FALHOU\n" : "ok\n");
+        falhas += falhas_caso;
+    }
+    return falhas ? 1 : 0;
+}